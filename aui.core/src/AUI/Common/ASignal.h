@@ -16,10 +16,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <new>
 #include "AUI/Common/ADeque.h"
+#include "AUI/Common/AOptional.h"
 #include "AUI/Thread/AMutex.h"
 #include "AAbstractSignal.h"
+#include <AUI/Traits/members.h>
 
 
 /**
@@ -27,6 +33,10 @@
  * @tparam Args signal arguments
  * @ingroup core
  * @ingroup signal_slot
+ * @details
+ * Connected slots are kept in an immutable (copy-on-write) array. Connecting and disconnecting builds a new array under
+ * a mutex, while emission takes the current array with atomic operations only, without locking a mutex or allocating
+ * memory. Arrays replaced during an emission are kept alive until no emission is in progress.
  */
 template<typename... Args>
 class ASignal final: public AAbstractSignal
@@ -40,100 +50,302 @@ public:
     using args_t = std::tuple<Args...>;
 
 private:
-    struct slot
+    /**
+     * @brief Latest arguments of a coalesced cross-thread call waiting in the receiver's message queue. Shared by the
+     * copies of the slot.
+     * @see ASignal::setCrossThreadCoalescing
+     */
+    struct pending_call
     {
-        AObject* object; // TODO replace with weak_ptr
-        func_t func;
+        std::atomic_size_t refCount = 1;
+        AMutex lock;
+        AOptional<std::tuple<Args...>> args;
 
-        [[nodiscard]]
-        bool operator==(const slot& rhs) const noexcept {
-            return object == rhs.object && func.target_type() == rhs.func.target_type();
+        static void release(pending_call* p) noexcept {
+            if (p != nullptr && p->refCount.fetch_sub(1) == 1) {
+                delete p;
+            }
         }
     };
 
-    std::recursive_mutex mSlotsLock;
-    AVector<slot> mSlots;
+    /**
+     * @brief Connected slot.
+     * @details
+     * Slot arrays store slots by value. A callable fitting in INLINE_SIZE bytes (i.e. a lambda capturing a couple of
+     * pointers, or a member function binding) is stored in the slot itself, so connection does not allocate anything
+     * but the new slot array. Larger (or throwing on copy) callables are kept on the heap and shared by the copies of
+     * the slot. Invocation does not go through std::function.
+     */
+    class connected_slot
+    {
+    public:
+        static constexpr std::size_t INLINE_SIZE = 4 * sizeof(void*);
+
+        AObject* object; // TODO replace with weak_ptr
 
-    void invokeSignal(AObject* emitter, const std::tuple<Args...>& args = {});
+        /**
+         * @brief Identifies the connection across copies of the slot.
+         */
+        std::size_t id;
 
-    template<typename Lambda, typename... A>
-    struct argument_ignore_helper {};
+        template<typename Callable>
+        connected_slot(AObject* object, std::size_t id, Callable callable): object(object), id(id) {
+            using stored_t = std::conditional_t<fitsInline<Callable>(), Callable, heap_callable<Callable>>;
+            new (mStorage) stored_t(std::move(callable));
+            mOps = &opsFor<stored_t>();
+        }
 
-    // empty arguments
-    template<typename Lambda>
-    struct argument_ignore_helper<void(Lambda::*)() const>
-    {
-        Lambda l;
+        connected_slot(const connected_slot& other) noexcept: object(other.object), id(other.id), mOps(other.mOps) {
+            mOps->copy(mStorage, other.mStorage);
+            auto p = other.mPendingCall.load(std::memory_order_acquire);
+            if (p != nullptr) {
+                p->refCount.fetch_add(1);
+            }
+            mPendingCall.store(p, std::memory_order_relaxed);
+        }
 
-        explicit argument_ignore_helper(Lambda l)
-                : l(l)
-        {
+        connected_slot& operator=(const connected_slot&) = delete;
+
+        ~connected_slot() {
+            mOps->destroy(mStorage);
+            pending_call::release(mPendingCall.load());
         }
 
-        void operator()(Args... args) {
-            l();
+        void call(const Args&... args) const {
+            mOps->call(mStorage, args...);
         }
+
+        pending_call& obtainPendingCall() const {
+            auto p = mPendingCall.load(std::memory_order_acquire);
+            if (p == nullptr) {
+                auto created = new pending_call;
+                if (mPendingCall.compare_exchange_strong(p, created, std::memory_order_acq_rel)) {
+                    p = created;
+                } else {
+                    delete created;
+                }
+            }
+            return *p;
+        }
+
+    private:
+        struct ops {
+            void(*call)(void* storage, const Args&... args);
+            void(*copy)(void* dst, const void* src) noexcept;
+            void(*destroy)(void* storage) noexcept;
+        };
+
+        template<typename Callable>
+        struct heap_callable {
+            _<Callable> callable;
+
+            explicit heap_callable(Callable c): callable(_new<Callable>(std::move(c))) {}
+
+            void operator()(const Args&... args) {
+                (*callable)(args...);
+            }
+        };
+
+        template<typename Callable>
+        static constexpr bool fitsInline() noexcept {
+            return sizeof(Callable) <= INLINE_SIZE &&
+                   alignof(Callable) <= alignof(void*) &&
+                   std::is_nothrow_copy_constructible_v<Callable>;
+        }
+
+        template<typename T>
+        static const ops& opsFor() noexcept {
+            static constexpr ops o = {
+                [](void* storage, const Args&... args) { (*static_cast<T*>(storage))(args...); },
+                [](void* dst, const void* src) noexcept { new (dst) T(*static_cast<const T*>(src)); },
+                [](void* storage) noexcept { static_cast<T*>(storage)->~T(); },
+            };
+            return o;
+        }
+
+        const ops* mOps;
+        mutable std::atomic<pending_call*> mPendingCall = nullptr;
+        alignas(void*) mutable std::byte mStorage[INLINE_SIZE];
     };
 
-    template<typename Lambda, typename A1>
-    struct argument_ignore_helper<void(Lambda::*)(A1) const>
+    using slots_t = AVector<connected_slot>;
+
+    /**
+     * @brief Signal's state shared with in-progress emissions.
+     * @details
+     * Owned by the signal and by every emission in progress (including cross-thread calls waiting in the receiver's
+     * queue), so it outlives the signal if the signal is destroyed by one of its slots.
+     */
+    struct state
     {
-        Lambda l;
+        /**
+         * @brief Reference count: the signal itself and emissions in progress.
+         */
+        std::atomic_size_t refCount = 1;
 
-        explicit argument_ignore_helper(Lambda l)
-                : l(l)
-        {
+        /**
+         * @brief Current immutable slot array; nullptr if there are no slots.
+         */
+        std::atomic<slots_t*> slots = nullptr;
+
+        /**
+         * @brief Set when the signal is destroyed.
+         */
+        std::atomic_bool destroyed = false;
+
+        /**
+         * @brief Guards modification of slots and retired.
+         */
+        AMutex writeLock;
+
+        /**
+         * @brief Replaced slot arrays which may still be used by in-progress emissions.
+         */
+        AVector<slots_t*> retired;
+
+        /**
+         * @brief Whether retired is not empty. Allows emissions to check for garbage without locking writeLock.
+         */
+        std::atomic_bool hasRetired = false;
+
+        /**
+         * @brief The signal owning the state. Guarded by writeLock; valid until destroyed is set.
+         */
+        ASignal* owner = nullptr;
+
+        /**
+         * @brief Id of the next connected slot. Guarded by writeLock.
+         */
+        std::size_t nextSlotId = 0;
+
+        ~state() {
+            delete slots.load();
+            for (auto r : retired) {
+                delete r;
+            }
         }
 
-        template<typename... Others>
-        void call(A1&& a1, Others...)
-        {
-            l(std::forward<A1>(a1));
+        void acquire() noexcept {
+            refCount.fetch_add(1);
         }
 
-        void operator()(Args&&... args) {
-            call(std::forward<Args>(args)...);
+        static void release(state* s) noexcept {
+            if (s->refCount.fetch_sub(1) == 1) {
+                delete s;
+            }
         }
     };
-    template<typename Lambda, typename A1, typename A2>
-    struct argument_ignore_helper<void(Lambda::*)(A1, A2) const>
-    {
-        Lambda l;
 
-        explicit argument_ignore_helper(Lambda l)
-                : l(l)
-        {
+    /**
+     * @brief Slot arrays to delete after writeLock is unlocked. Slot destructors may run arbitrary code (including
+     * destruction of this signal), so they should never run under the lock.
+     */
+    struct garbage: aui::noncopyable {
+        AVector<slots_t*> arrays;
+
+        ~garbage() {
+            for (auto a : arrays) {
+                delete a;
+            }
         }
+    };
 
-        template<typename... Others>
-        void call(A1&& a1, A2&& a2, Others...)
-        {
-            l(std::forward<A1>(a1), std::forward<A2>(a2));
+    /**
+     * @brief Emission's reference to the state.
+     */
+    class state_ref {
+    public:
+        explicit state_ref(state* s) noexcept: mState(s) {
+            mState->acquire();
+        }
+        state_ref(const state_ref& other) noexcept: mState(other.mState) {
+            mState->acquire();
+        }
+        state_ref& operator=(const state_ref&) = delete;
+
+        ~state_ref() {
+            garbage g;
+            if (mState->hasRetired.load(std::memory_order_relaxed) &&
+                mState->refCount.load() == 2 &&
+                !mState->destroyed) {
+                // we are likely the last emission; delete the retired arrays.
+                std::unique_lock lock(mState->writeLock);
+                if (mState->refCount.load() == 2 && !mState->destroyed) {
+                    g.arrays = std::move(mState->retired);
+                    mState->retired.clear();
+                    mState->hasRetired = false;
+                }
+            }
+            state::release(mState);
         }
 
-        void operator()(Args&&... args) {
-            call(std::forward<Args>(args)...);
+        state& operator*() const noexcept {
+            return *mState;
         }
+
+    private:
+        state* mState;
     };
 
-    template<typename Lambda, typename A1, typename A2, typename A3>
-    struct argument_ignore_helper<void(Lambda::*)(A1, A2, A3) const>
+    std::atomic<state*> mState = nullptr;
+    std::atomic_bool mCrossThreadCoalescing = false;
+
+    void invokeSignal(AObject* emitter, const std::tuple<Args...>& args = {});
+
+    /**
+     * @brief Calls the slot queued to the receiver's thread.
+     * @details
+     * Static since the signal may be destroyed by the time the queued call runs; the queued call owns a reference to
+     * the state and a copy of the slot.
+     */
+    static void invokeQueued(state& s, const _weak<AObject>& receiverWeakPtr, const connected_slot& queuedSlot,
+                             const std::tuple<Args...>& args) {
+        if (auto receiverPtr = receiverWeakPtr.lock()) {
+            AAbstractSignal::isDisconnected() = false;
+            (std::apply)([&](const Args&... a) { queuedSlot.call(a...); }, args);
+            if (AAbstractSignal::isDisconnected()) {
+                removeSlotsIf(s, [id = queuedSlot.id](const connected_slot& p) { return p.id == id; });
+            }
+        }
+    }
+
+    /**
+     * @brief Calls the lambda with the first N signal arguments, where N is the lambda's argument count.
+     * @details
+     * Arguments are passed by const reference; a copy is made only if the lambda accepts the argument by value or by
+     * rvalue reference.
+     */
+    template<typename Lambda>
+    struct argument_ignore_helper
     {
+        using lambda_args = typename aui::member<decltype(&Lambda::operator())>::args;
+        static_assert(std::tuple_size_v<lambda_args> <= sizeof...(Args),
+                      "slot accepts more arguments than the signal has");
+
         Lambda l;
 
         explicit argument_ignore_helper(Lambda l)
-                : l(l)
+                : l(std::move(l))
         {
         }
 
-        template<typename... Others>
-        void call(A1&& a1, A2&& a2, A3&& a3, Others...)
-        {
-            l(std::forward<A1>(a1), std::forward<A2>(a2), std::forward<A3>(a3));
+        void operator()(const Args&... args) {
+            call(std::make_index_sequence<std::tuple_size_v<lambda_args>>{}, std::forward_as_tuple(args...));
         }
 
-        void operator()(Args&&... args) {
-            call(std::forward<Args>(args)...);
+    private:
+        template<typename Param, typename Arg>
+        static decltype(auto) pass(const Arg& arg) {
+            if constexpr (std::is_rvalue_reference_v<Param>) {
+                return std::decay_t<Param>(arg);
+            } else {
+                return (arg);
+            }
+        }
+
+        template<std::size_t... I, typename Tuple>
+        void call(std::index_sequence<I...>, const Tuple& args) {
+            l(pass<std::tuple_element_t<I, lambda_args>>(std::get<I>(args))...);
         }
     };
 
@@ -156,12 +368,103 @@ private:
     {
         static_assert(std::is_class_v<Lambda>, "the lambda should be a class");
 
-        std::unique_lock lock(mSlotsLock);
-        mSlots.push_back({ object, argument_ignore_helper<decltype(&Lambda::operator())>(lambda) });
+        addSlot(object, argument_ignore_helper<Lambda>(std::move(lambda)));
+    }
+
+    state& obtainState() {
+        auto s = mState.load(std::memory_order_acquire);
+        if (s == nullptr) {
+            auto created = new state;
+            created->owner = this;
+            if (mState.compare_exchange_strong(s, created, std::memory_order_acq_rel)) {
+                s = created;
+            } else {
+                delete created;
+            }
+        }
+        return *s;
+    }
+
+    /**
+     * @brief Replaces the current slot array. Should be called with writeLock locked.
+     */
+    static void publish(state& s, slots_t* newSlots, garbage& g) {
+        if (newSlots != nullptr && newSlots->empty()) {
+            delete newSlots;
+            newSlots = nullptr;
+        }
+        if (auto old = s.slots.exchange(newSlots)) {
+            // emission increments the reference count before loading the slot array; if there's no one but the signal
+            // itself, nobody can use the old array.
+            if (s.refCount.load() == 1) {
+                g.arrays << old;
+                g.arrays.insertAll(s.retired);
+                s.retired.clear();
+                s.hasRetired = false;
+            } else {
+                s.retired << old;
+                s.hasRetired = true;
+            }
+        }
+    }
 
+    template<typename Callable>
+    void addSlot(AObject* object, Callable callable) {
+        auto& s = obtainState();
+        garbage g;
+        std::unique_lock lock(s.writeLock);
+        auto current = s.slots.load();
+        auto newSlots = std::make_unique<slots_t>();
+        newSlots->reserve((current ? current->size() : 0) + 1);
+        if (current) {
+            for (const auto& i : *current) {
+                newSlots->push_back(i);
+            }
+        }
+        newSlots->emplace_back(object, s.nextSlotId++, std::move(callable));
+        publish(s, newSlots.release(), g);
         linkSlot(object);
     }
 
+    /**
+     * @brief Removes slots matching the predicate, unlinking objects which have no slots left.
+     */
+    template<typename Predicate>
+    static void removeSlotsIf(state& s, Predicate&& predicate) noexcept {
+        garbage g;
+        std::unique_lock lock(s.writeLock);
+        if (s.destroyed) {
+            return;
+        }
+        auto current = s.slots.load();
+        if (current == nullptr) {
+            return;
+        }
+        auto newSlots = new slots_t;
+        newSlots->reserve(current->size());
+        AVector<AObject*> removedObjects;
+        for (const auto& i : *current) {
+            if (predicate(i)) {
+                removedObjects << i.object;
+            } else {
+                newSlots->push_back(i);
+            }
+        }
+        if (removedObjects.empty()) {
+            delete newSlots;
+            return;
+        }
+        for (auto object : removedObjects) {
+            auto hasOtherSlots = std::any_of(newSlots->begin(), newSlots->end(), [&](const connected_slot& i) {
+                return i.object == object;
+            });
+            if (!hasOtherSlots) {
+                s.owner->unlinkSlot(object);
+            }
+        }
+        publish(s, newSlots, g);
+    }
+
 public:
 
     struct call_wrapper {
@@ -178,15 +481,42 @@ public:
     }
 
     ASignal() = default;
-    ASignal(ASignal&&) = default;
+    ASignal(ASignal&& other) noexcept: mState(other.mState.exchange(nullptr)),
+                                       mCrossThreadCoalescing(other.mCrossThreadCoalescing.load(std::memory_order_relaxed)) {
+        auto s = mState.load();
+        if (s == nullptr) {
+            return;
+        }
+        // connected objects refer to the signal by its address; move them to the new one
+        std::unique_lock lock(s->writeLock);
+        s->owner = this;
+        if (auto slots = s->slots.load()) {
+            for (const auto& i : *slots) {
+                other.unlinkSlot(i.object);
+                linkSlot(i.object);
+            }
+        }
+    }
 
     virtual ~ASignal() noexcept
     {
-        std::unique_lock lock(mSlotsLock);
-        for (slot& slot : mSlots)
+        auto s = mState.load();
+        if (s == nullptr) {
+            return;
+        }
+        garbage g;
         {
-            unlinkSlot(slot.object);
+            std::unique_lock lock(s->writeLock);
+            if (auto slots = s->slots.load()) {
+                for (const auto& i : *slots) {
+                    unlinkSlot(i.object);
+                }
+            }
+            publish(*s, nullptr, g);
+            s->destroyed = true;
+            s->owner = nullptr;
         }
+        state::release(s);
     }
 
     /**
@@ -195,7 +525,45 @@ public:
      * @return true, if slot contains any connected slots, false otherwise.
      */
     operator bool() const {
-        return !mSlots.empty();
+        auto s = mState.load(std::memory_order_acquire);
+        return s != nullptr && s->slots.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /**
+     * @brief Enables coalescing of cross-thread slot calls.
+     * @details
+     * A slot connected to an object living in another thread (see AObject::isSlotsCallsOnlyOnMyThread) is called
+     * through that thread's message queue. By default, every emission queues a separate call.
+     *
+     * With coalescing enabled, if the previous call of the slot is still waiting in the receiver's queue, the emission
+     * replaces its arguments instead of queueing a new call. So the receiver's thread calls the slot once per message
+     * queue drain with the latest arguments, no matter how many times the signal was emitted in the meantime.
+     *
+     * Useful for high-rate notifications (i.e. progress updates from a worker thread), where only the latest value
+     * matters.
+     *
+     * Can be changed at any time, even while the signal is emitted by another thread; such an emission may still use
+     * the previous mode.
+     *
+     * @code{cpp}
+     * class Worker: public AObject {
+     * public:
+     *     Worker() {
+     *         progressChanged.setCrossThreadCoalescing(true);
+     *     }
+     *
+     * signals:
+     *     emits<float> progressChanged;
+     * };
+     * @endcode
+     */
+    void setCrossThreadCoalescing(bool enabled) noexcept {
+        mCrossThreadCoalescing.store(enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    bool isCrossThreadCoalescing() const noexcept {
+        return mCrossThreadCoalescing.load(std::memory_order_relaxed);
     }
 
     void clearAllConnections() noexcept override
@@ -204,31 +572,16 @@ public:
     }
     void clearAllConnectionsWith(aui::no_escape<AObject> object) noexcept override
     {
-        clearAllConnectionsIf([&](const slot& p){ return p.object == object.ptr(); });
+        clearAllConnectionsIf([&](const connected_slot& p){ return p.object == object.ptr(); });
     }
 
 private:
 
     template<typename Predicate>
     void clearAllConnectionsIf(Predicate&& predicate) noexcept {
-        /*
-         * Removal of connections before end of execution of clearAllConnectionsIf may cause this ASignal destruction,
-         * causing undefined behaviour. Destructing these connections after mSlotsLock unlocking solves the problem.
-         */
-        AVector<func_t> slotsToRemove;
-
-        std::unique_lock lock(mSlotsLock);
-        slotsToRemove.reserve(mSlots.size());
-        mSlots.removeIf([&slotsToRemove, predicate = std::move(predicate)](const slot& p) {
-            if (predicate(p)) {
-                slotsToRemove << std::move(p.func);
-                return true;
-            }
-            return false;
-        });
-        lock.unlock();
-
-        slotsToRemove.clear();
+        if (auto s = mState.load(std::memory_order_acquire)) {
+            removeSlotsIf(*s, std::forward<Predicate>(predicate));
+        }
     }
 };
 #include <AUI/Thread/AThread.h>
@@ -236,79 +589,104 @@ private:
 template <typename ... Args>
 void ASignal<Args...>::invokeSignal(AObject* emitter, const std::tuple<Args...>& args)
 {
-    if (mSlots.empty())
+    auto s = mState.load(std::memory_order_acquire);
+    if (s == nullptr)
         return;
 
-    _<AObject> emitterPtr, receiverPtr;
+    // the reference keeps the slot array alive even if the slots modify or destroy this signal
+    state_ref stateRef(s);
+    auto slots = s->slots.load();
+    if (slots == nullptr)
+        return;
 
-    if (auto sharedPtr = weakPtrFromObject(emitter).lock()) { // avoid emitter removal during signal processing
-        emitterPtr = std::move(static_cast<_<AObject>>(sharedPtr));
-    }
+    bool& isDisconnected = AAbstractSignal::isDisconnected();
+    AAbstractThread* currentThread = nullptr;
 
-    std::unique_lock lock(mSlotsLock);
-    auto slots = std::move(mSlots); // needed to safely unlock the mutex
-    for (auto i = slots.begin(); i != slots.end();)
+    // avoid receiver removal during signal processing; consecutive slots of the same receiver share the reference
+    _<AObject> receiverPtr;
+    for (const auto& i : *slots)
     {
-        auto receiverWeakPtr = weakPtrFromObject(i->object);
-        if (i->object->isSlotsCallsOnlyOnMyThread() && i->object->getThread() != AThread::current())
-        {
-            // perform crossthread call; should make weak ptr to the object and queue call to thread message queue
-
-            /*
-             * That's because shared_ptr counting mechanism is used when doing a crossthread call.
-             * It could not track the object existence without shared_ptr block.
-             * Also, receiverWeakPtr.lock() may be null here because object is in different thread and being destructed
-             * by shared_ptr but have not reached clearSignals() yet.
-             */
-            if (receiverWeakPtr.lock() != nullptr) {
-                i->object->getThread()->enqueue([this,
-                                                 receiverWeakPtr = std::move(receiverWeakPtr),
-                                                 func = i->func,
-                                                 args = args]() {
-                    if (auto receiverPtr = receiverWeakPtr.lock()) {
-                        AAbstractSignal::isDisconnected() = false;
-                        (std::apply)(func, args);
-                        if (AAbstractSignal::isDisconnected()) {
-                            std::unique_lock lock(mSlotsLock);
-                            unlinkSlot(receiverPtr.get());
-                            slot s = { receiverPtr.get(), func };
-                            mSlots.removeFirst(s);
-                        }
+        if (s->destroyed) {
+            // the signal is destroyed by a slot or by a receiver released here; do not call the rest
+            break;
+        }
+        AObject* object = i.object;
+        if (object->isSlotsCallsOnlyOnMyThread()) {
+            if (currentThread == nullptr) {
+                currentThread = AThread::current().get();
+            }
+            if (auto receiverThread = object->getThread(); receiverThread.get() != currentThread) {
+                // perform crossthread call; should make weak ptr to the object and queue call to thread message queue
+
+                /*
+                 * That's because shared_ptr counting mechanism is used when doing a crossthread call.
+                 * It could not track the object existence without shared_ptr block.
+                 * Also, receiverWeakPtr.lock() may be null here because object is in different thread and being
+                 * destructed by shared_ptr but have not reached clearSignals() yet.
+                 *
+                 * The queued call does not refer to the signal itself since it may be destroyed by the time the call
+                 * runs.
+                 */
+                auto receiverWeakPtr = weakPtrFromObject(object);
+                if (receiverWeakPtr.lock() == nullptr) {
+                    continue;
+                }
+                if (!mCrossThreadCoalescing.load(std::memory_order_relaxed)) {
+                    receiverThread->enqueue([stateRef,
+                                             receiverWeakPtr = std::move(receiverWeakPtr),
+                                             queuedSlot = i,
+                                             args = args]() {
+                        invokeQueued(*stateRef, receiverWeakPtr, queuedSlot, args);
+                    });
+                    continue;
+                }
+
+                auto& pendingCall = i.obtainPendingCall();
+                {
+                    std::unique_lock lock(pendingCall.lock);
+                    bool alreadyQueued = pendingCall.args.hasValue();
+                    pendingCall.args = args;
+                    if (alreadyQueued) {
+                        // the queued call will pick up the new arguments
+                        continue;
                     }
+                }
+                // the copy of the slot shares the pending call
+                receiverThread->enqueue([stateRef,
+                                         receiverWeakPtr = std::move(receiverWeakPtr),
+                                         queuedSlot = i]() {
+                    AOptional<std::tuple<Args...>> latestArgs;
+                    {
+                        auto& pendingCall = queuedSlot.obtainPendingCall();
+                        std::unique_lock lock(pendingCall.lock);
+                        latestArgs = std::move(pendingCall.args);
+                        pendingCall.args = std::nullopt;
+                    }
+                    invokeQueued(*stateRef, receiverWeakPtr, queuedSlot, *latestArgs);
                 });
+                continue;
             }
-            ++i;
         }
-        else
-        {
-            AAbstractSignal::isDisconnected() = false;
 
-            if (auto sharedPtr = receiverWeakPtr.lock()) { // avoid receiver removal during signal processing
-                receiverPtr = std::move(sharedPtr);
-            }
-
-            (std::apply)(i->func, args);
-            if (AAbstractSignal::isDisconnected()) {
-                unlinkSlot(i->object);
-                i = slots.erase(i);
-            } else {
-                ++i;
+        if (receiverPtr.get() != object) {
+            receiverPtr = weakPtrFromObject(object).lock();
+            if (s->destroyed) {
+                break;
             }
         }
-    }
-    AUI_MARK_AS_USED(emitterPtr);
-    AUI_MARK_AS_USED(receiverPtr);
 
-    if (mSlots.empty()) {
-        mSlots = std::move(slots);
-    } else {
-        mSlots.insert(mSlots.begin(), std::make_move_iterator(slots.begin()), std::make_move_iterator(slots.end()));
+        isDisconnected = false;
+        (std::apply)([&](const Args&... a) { i.call(a...); }, args);
+        if (isDisconnected) {
+            removeSlotsIf(*s, [id = i.id](const connected_slot& p) { return p.id == id; });
+        }
     }
+    AUI_MARK_AS_USED(emitter);
 
-    AAbstractSignal::isDisconnected() = false;
+    isDisconnected = false;
 }
 
 template<typename... Args>
 using emits = ASignal<Args...>;
 
-#define signals public
\ No newline at end of file
+#define signals public
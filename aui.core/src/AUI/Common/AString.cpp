@@ -18,42 +18,16 @@
 #include "AString.h"
 #include "AStringVector.h"
 #include <AUI/Common/AByteBuffer.h>
+#include <AUI/Common/AUtf8.h>
+#include <AUI/Common/AUtf8String.h>
 
 inline static void fromUtf8_impl(AString& destination, const char* str, size_t length) {
-    destination.reserve(length);
-
-    // parse utf8
-    for (; *str && length; --length)
-    {
-        if (*str & 0x80)
-        {
-            wchar_t t;
-            // utf8 symbol
-            if (*str & 0b00100000)
-            {
-                // 3-byte symbol
-                t = *(str++) & 0b1111;
-                t <<= 6;
-                t |= *(str++) & 0b111111;
-                t <<= 6;
-                t |= *(str++) & 0b111111;
-                destination.push_back(t);
-                length -= 2;
-            } else
-            {
-                // 2-byte symbol
-                t = *(str++) & 0b11111;
-                t <<= 6;
-                t |= *(str++) & 0b111111;
-                destination.push_back(t);
-                length -= 1;
-            }
-        } else
-        {
-            // ascii symbol
-            destination.push_back(*(str++));
-        }
+    std::string_view utf8(str, length);
+    if (auto terminator = utf8.find('\0'); terminator != std::string_view::npos) {
+        utf8 = utf8.substr(0, terminator);
     }
+    destination.resize(utf8.length());
+    destination.resize(aui::utf8::decode(utf8, destination.data()));
 }
 
 AString::AString(const char* utf8) noexcept
@@ -71,6 +45,11 @@ AString::AString(const std::string& utf8) noexcept
     fromUtf8_impl(*this, utf8.c_str(), utf8.length());
 }
 
+AString::AString(const AUtf8String& utf8) noexcept
+{
+    fromUtf8_impl(*this, utf8.data(), utf8.size());
+}
+
 AString AString::fromUtf8(const AByteBufferView& buffer) {
     return AString::fromUtf8(buffer.data(), buffer.size());
 }
@@ -85,33 +64,8 @@ AString AString::fromUtf8(const char* buffer, size_t length) {
 AByteBuffer AString::toUtf8() const noexcept
 {
     AByteBuffer buf;
-    for (wchar_t c : *this)
-    {
-        if (c >= 0x80)
-        {
-            if (c >= 0x800)
-            {
-                char b[] = {
-                        static_cast<char>(0b11100000 | (c >> 12 & 0b1111)),
-                        static_cast<char>(0b10000000 | (c >> 6 & 0b111111)),
-                        static_cast<char>(0b10000000 | (c & 0b111111)),
-                        0,
-                };
-                buf << b;
-            } else if (c >= 0x80)
-            {
-                char b[] = {
-                        static_cast<char>(0b11000000 | (c >> 6 & 0b11111)),
-                        static_cast<char>(0b10000000 | (c & 0b111111)),
-                        0,
-                };
-                buf << b;
-            }
-        } else
-        {
-            buf << *reinterpret_cast<char*>(&c);
-        }
-    }
+    buf.reserve(aui::utf8::encodedLength(*this));
+    buf.setSize(aui::utf8::encode(*this, buf.data()) - buf.data());
     return buf;
 }
 
@@ -262,11 +216,8 @@ int AString::toNumberHex() const noexcept
 
 std::string AString::toStdString() const noexcept
 {
-    auto encoded = toUtf8();
-    std::string dst;
-    dst.reserve(encoded.getSize());
-    dst.insert(0, encoded.data(), encoded.getSize());
-
+    std::string dst(aui::utf8::encodedLength(*this), '\0');
+    aui::utf8::encode(*this, dst.data());
     return dst;
 }
 
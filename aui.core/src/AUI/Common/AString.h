@@ -27,6 +27,7 @@
 class API_AUI_CORE AStringVector;
 class API_AUI_CORE AByteBuffer;
 class API_AUI_CORE AByteBufferView;
+class API_AUI_CORE AUtf8String;
 
 /**
  * @brief Represents a wide char string.
@@ -65,6 +66,13 @@ public:
      */
     AString(const std::string& utf8) noexcept;
 
+    /**
+     * @param utf8 utf8 string
+     * @details
+     * Explicit since it decodes the whole string; prefer AUtf8String::toAString.
+     */
+    explicit AString(const AUtf8String& utf8) noexcept;
+
     AString(const AString& other) noexcept
             : super(other.c_str())
     {
@@ -0,0 +1,86 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AStringAtom.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using aui::impl::StringAtomEntry;
+
+namespace {
+    /**
+     * @brief Part of the intern table. The table is split to shards by hash to reduce the lock contention.
+     */
+    struct Shard {
+        std::shared_mutex sync;
+        std::unordered_multimap<std::size_t, const StringAtomEntry*> entries;
+
+        const StringAtomEntry* find(std::size_t hash, std::string_view utf8) const noexcept {
+            auto [begin, end] = entries.equal_range(hash);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second->utf8 == utf8) {
+                    return it->second;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    constexpr std::size_t SHARD_COUNT = 64;
+
+    Shard& shardFor(std::size_t hash) noexcept {
+        static Shard shards[SHARD_COUNT];
+        return shards[hash % SHARD_COUNT];
+    }
+
+    const StringAtomEntry* intern(std::string_view utf8) {
+        auto hash = std::hash<std::string_view>{}(utf8);
+        auto& shard = shardFor(hash);
+        {
+            std::shared_lock lock(shard.sync);
+            if (auto entry = shard.find(hash, utf8)) {
+                return entry;
+            }
+        }
+        std::unique_lock lock(shard.sync);
+        if (auto entry = shard.find(hash, utf8)) {
+            return entry;
+        }
+        auto entry = new StringAtomEntry{ std::string(utf8), AString(utf8), hash };
+        shard.entries.emplace(hash, entry);
+        return entry;
+    }
+}
+
+AStringAtom::AStringAtom() noexcept {
+    static const StringAtomEntry* empty = intern({});
+    mEntry = empty;
+}
+
+AStringAtom::AStringAtom(std::string_view utf8): mEntry(intern(utf8)) {}
+
+AStringAtom::AStringAtom(const AString& string): mEntry(intern(string.toStdString())) {}
+
+AOptional<AStringAtom> AStringAtom::find(std::string_view utf8) noexcept {
+    auto hash = std::hash<std::string_view>{}(utf8);
+    auto& shard = shardFor(hash);
+    std::shared_lock lock(shard.sync);
+    if (auto entry = shard.find(hash, utf8)) {
+        return AStringAtom(entry);
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,158 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string_view>
+#include <AUI/Common/AString.h>
+#include <AUI/Common/AOptional.h>
+
+namespace aui::impl {
+    /**
+     * @brief Interned string. Never destroyed.
+     */
+    struct StringAtomEntry {
+        std::string utf8;
+        AString string;
+        std::size_t hash;
+    };
+}
+
+/**
+ * @brief Interned string.
+ * @ingroup core
+ * @details
+ * All atoms with equal contents share a single immutable entry in a global concurrent intern table, so an atom is a
+ * single pointer: it is copied without allocation, compared by the pointer and has a precomputed hash. Both UTF-8 and
+ * AString representations of the string are computed once, when the string is interned.
+ *
+ * Use atoms for identifiers coming from a limited set (style class names, keys, column names, etc...). Interned
+ * strings are never freed, so do not intern arbitrary user input; use AStringAtom::find to look up an atom without
+ * interning.
+ *
+ * The ordering of atoms (operator<) is the ordering of their entries in memory, not the lexicographical one. It is
+ * stable during the program execution and allows atoms to be used as keys in ASet and AMap.
+ */
+class API_AUI_CORE AStringAtom {
+public:
+    /**
+     * @brief Empty string atom.
+     */
+    AStringAtom() noexcept;
+
+    /**
+     * @brief Interns the string.
+     * @param utf8 utf8 string
+     */
+    explicit AStringAtom(std::string_view utf8);
+
+    /**
+     * @brief Interns the string.
+     * @param utf8 utf8 string
+     */
+    explicit AStringAtom(const char* utf8): AStringAtom(std::string_view(utf8)) {}
+
+    /**
+     * @brief Interns the string.
+     */
+    explicit AStringAtom(const AString& string);
+
+    /**
+     * @brief Looks up the atom without interning the string.
+     * @param utf8 utf8 string
+     * @return atom, if the string was interned before.
+     */
+    [[nodiscard]]
+    static AOptional<AStringAtom> find(std::string_view utf8) noexcept;
+
+    [[nodiscard]]
+    const AString& str() const noexcept {
+        return mEntry->string;
+    }
+
+    [[nodiscard]]
+    std::string_view view() const noexcept {
+        return mEntry->utf8;
+    }
+
+    [[nodiscard]]
+    std::size_t hash() const noexcept {
+        return mEntry->hash;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return mEntry->utf8.empty();
+    }
+
+    operator const AString&() const noexcept {
+        return mEntry->string;
+    }
+
+    [[nodiscard]]
+    bool operator==(const AStringAtom& other) const noexcept {
+        return mEntry == other.mEntry;
+    }
+
+    [[nodiscard]]
+    bool operator==(std::string_view other) const noexcept {
+        return view() == other;
+    }
+
+    [[nodiscard]]
+    bool operator==(const char* other) const noexcept {
+        return view() == other;
+    }
+
+    [[nodiscard]]
+    bool operator==(const AString& other) const noexcept {
+        return str() == other;
+    }
+
+    [[nodiscard]]
+    bool operator<(const AStringAtom& other) const noexcept {
+        return std::less<const aui::impl::StringAtomEntry*>{}(mEntry, other.mEntry);
+    }
+
+private:
+    const aui::impl::StringAtomEntry* mEntry;
+
+    explicit AStringAtom(const aui::impl::StringAtomEntry* entry) noexcept: mEntry(entry) {}
+};
+
+namespace std {
+    template<>
+    struct hash<AStringAtom> {
+        size_t operator()(const AStringAtom& t) const noexcept {
+            return t.hash();
+        }
+    };
+}
+
+template <> struct fmt::formatter<AStringAtom>: fmt::formatter<std::string_view> {
+    auto format(const AStringAtom& s, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(s.view(), ctx);
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& o, const AStringAtom& s) {
+    return o << s.view();
+}
+
+// gtest printer for AStringAtom
+inline void PrintTo(const AStringAtom& s, std::ostream* stream) {
+    *stream << s.view();
+}
@@ -69,10 +69,14 @@ _<AThread>& ATimer::timerThread() {
         t->start();
         return t;
     }();
-    std::atexit([] {
-        thread->interrupt();
-        thread->join();
-    });
+    static bool cleanupRegistered = [] { // registered once, after thread initialization
+        std::atexit([] {
+            thread->interrupt();
+            thread->join();
+        });
+        return true;
+    }();
+    (void)cleanupRegistered;
     return thread;
 }
 
@@ -31,8 +31,6 @@ private:
 
     AOptional<AScheduler::TimerHandle> mTimer;
 
-    static _<AThread>& timerThread();
-
 public:
 	explicit ATimer(std::chrono::milliseconds period);
 	~ATimer();
@@ -45,6 +43,11 @@ public:
 
     static AScheduler& scheduler();
 
+    /**
+     * @brief Thread running scheduler(). Started on first call.
+     */
+    static _<AThread>& timerThread();
+
 signals:
 	emits<> fired;
 };
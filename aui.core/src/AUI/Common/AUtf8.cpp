@@ -0,0 +1,359 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AUtf8.h"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AUI_UTF8_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUI_UTF8_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define AUI_UTF8_NEON 1
+#endif
+
+namespace {
+    constexpr bool WCHAR_IS_UTF16 = sizeof(wchar_t) == 2;
+    constexpr char32_t INVALID = 0xffffffff;
+
+    /**
+     * @return number of leading ASCII bytes.
+     */
+    std::size_t countAscii(const char* src, std::size_t size) noexcept {
+        std::size_t i = 0;
+#if AUI_UTF8_AVX2
+        for (; i + 32 <= size; i += 32) {
+            if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))) != 0) {
+                break;
+            }
+        }
+#endif
+#if AUI_UTF8_SSE2
+        for (; i + 16 <= size; i += 16) {
+            if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))) != 0) {
+                break;
+            }
+        }
+#elif AUI_UTF8_NEON
+        for (; i + 16 <= size; i += 16) {
+            if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i))) >= 0x80) {
+                break;
+            }
+        }
+#endif
+        for (; i < size && static_cast<unsigned char>(src[i]) < 0x80; ++i);
+        return i;
+    }
+
+    /**
+     * @brief Copies leading ASCII bytes to the wide string.
+     * @return number of copied characters.
+     */
+    std::size_t widenAscii(const char* src, std::size_t size, wchar_t* dst) noexcept {
+        std::size_t i = 0;
+#if AUI_UTF8_AVX2
+        for (; i + 32 <= size; i += 32) {
+            if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))) != 0) {
+                break;
+            }
+            if constexpr (WCHAR_IS_UTF16) {
+                for (std::size_t j = 0; j < 32; j += 16) {
+                    auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + j), _mm256_cvtepu8_epi16(bytes));
+                }
+            } else {
+                for (std::size_t j = 0; j < 32; j += 8) {
+                    auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + j), _mm256_cvtepu8_epi32(bytes));
+                }
+            }
+        }
+#endif
+#if AUI_UTF8_SSE2
+        const auto zero = _mm_setzero_si128();
+        for (; i + 16 <= size; i += 16) {
+            auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if (_mm_movemask_epi8(bytes) != 0) {
+                break;
+            }
+            auto low = _mm_unpacklo_epi8(bytes, zero);
+            auto high = _mm_unpackhi_epi8(bytes, zero);
+            auto out = reinterpret_cast<__m128i*>(dst + i);
+            if constexpr (WCHAR_IS_UTF16) {
+                _mm_storeu_si128(out, low);
+                _mm_storeu_si128(out + 1, high);
+            } else {
+                _mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+            }
+        }
+#elif AUI_UTF8_NEON
+        for (; i + 16 <= size; i += 16) {
+            auto bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i));
+            if (vmaxvq_u8(bytes) >= 0x80) {
+                break;
+            }
+            auto low = vmovl_u8(vget_low_u8(bytes));
+            auto high = vmovl_high_u8(bytes);
+            if constexpr (WCHAR_IS_UTF16) {
+                auto out = reinterpret_cast<std::uint16_t*>(dst + i);
+                vst1q_u16(out, low);
+                vst1q_u16(out + 8, high);
+            } else {
+                auto out = reinterpret_cast<std::uint32_t*>(dst + i);
+                vst1q_u32(out, vmovl_u16(vget_low_u16(low)));
+                vst1q_u32(out + 4, vmovl_high_u16(low));
+                vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+                vst1q_u32(out + 12, vmovl_high_u16(high));
+            }
+        }
+#endif
+        for (; i < size && static_cast<unsigned char>(src[i]) < 0x80; ++i) {
+            dst[i] = wchar_t(src[i]);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Copies leading ASCII characters of the wide string.
+     * @return number of copied characters.
+     */
+    std::size_t narrowAscii(const wchar_t* src, std::size_t size, char* dst) noexcept {
+        std::size_t i = 0;
+#if AUI_UTF8_SSE2
+        const auto zero = _mm_setzero_si128();
+        const auto nonAsciiBits = WCHAR_IS_UTF16 ? _mm_set1_epi16(~0x7f) : _mm_set1_epi32(~0x7f);
+        for (; i + 16 <= size; i += 16) {
+            auto in = reinterpret_cast<const __m128i*>(src + i);
+            __m128i packed;
+            if constexpr (WCHAR_IS_UTF16) {
+                auto a = _mm_loadu_si128(in);
+                auto b = _mm_loadu_si128(in + 1);
+                auto nonAscii = _mm_and_si128(_mm_or_si128(a, b), nonAsciiBits);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, zero)) != 0xffff) {
+                    break;
+                }
+                packed = _mm_packus_epi16(a, b);
+            } else {
+                auto a = _mm_loadu_si128(in);
+                auto b = _mm_loadu_si128(in + 1);
+                auto c = _mm_loadu_si128(in + 2);
+                auto d = _mm_loadu_si128(in + 3);
+                auto nonAscii = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), nonAsciiBits);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, zero)) != 0xffff) {
+                    break;
+                }
+                packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+#elif AUI_UTF8_NEON
+        for (; i + 16 <= size; i += 16) {
+            uint8x16_t packed;
+            if constexpr (WCHAR_IS_UTF16) {
+                auto in = reinterpret_cast<const std::uint16_t*>(src + i);
+                auto a = vld1q_u16(in);
+                auto b = vld1q_u16(in + 8);
+                if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) {
+                    break;
+                }
+                packed = vcombine_u8(vmovn_u16(a), vmovn_u16(b));
+            } else {
+                auto in = reinterpret_cast<const std::uint32_t*>(src + i);
+                auto a = vld1q_u32(in);
+                auto b = vld1q_u32(in + 4);
+                auto c = vld1q_u32(in + 8);
+                auto d = vld1q_u32(in + 12);
+                if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80) {
+                    break;
+                }
+                packed = vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b))),
+                                     vmovn_u16(vcombine_u16(vmovn_u32(c), vmovn_u32(d))));
+            }
+            vst1q_u8(reinterpret_cast<std::uint8_t*>(dst + i), packed);
+        }
+#endif
+        for (; i < size && static_cast<std::make_unsigned_t<wchar_t>>(src[i]) < 0x80; ++i) {
+            dst[i] = char(src[i]);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Decodes a multibyte sequence starting at `s[i]` and advances `i` past it.
+     * @return code point or INVALID. In case of INVALID, `i` is advanced past the maximal invalid subpart.
+     */
+    char32_t decodeSequence(const unsigned char* s, std::size_t size, std::size_t& i) noexcept {
+        auto lead = s[i++];
+        unsigned length;
+        char32_t codePoint;
+        unsigned char lower = 0x80, upper = 0xbf;
+        if (lead >= 0xc2 && lead <= 0xdf) {
+            length = 2;
+            codePoint = lead & 0x1f;
+        } else if (lead >= 0xe0 && lead <= 0xef) {
+            length = 3;
+            codePoint = lead & 0x0f;
+            if (lead == 0xe0) {
+                lower = 0xa0; // overlong
+            } else if (lead == 0xed) {
+                upper = 0x9f; // surrogates
+            }
+        } else if (lead >= 0xf0 && lead <= 0xf4) {
+            length = 4;
+            codePoint = lead & 0x07;
+            if (lead == 0xf0) {
+                lower = 0x90; // overlong
+            } else if (lead == 0xf4) {
+                upper = 0x8f; // above U+10FFFF
+            }
+        } else {
+            return INVALID;
+        }
+
+        for (unsigned k = 1; k < length; ++k) {
+            if (i >= size || s[i] < lower || s[i] > upper) {
+                return INVALID;
+            }
+            codePoint = (codePoint << 6) | (s[i++] & 0x3f);
+            lower = 0x80;
+            upper = 0xbf;
+        }
+        return codePoint;
+    }
+
+    /**
+     * @brief Reads a code point from the wide string and advances `i` past it.
+     * @return code point; U+FFFD if the character is not a valid code point or is an unpaired surrogate.
+     */
+    char32_t readCodePoint(const wchar_t* s, std::size_t size, std::size_t& i) noexcept {
+        auto c = char32_t(static_cast<std::make_unsigned_t<wchar_t>>(s[i++]));
+        if (c >= 0xd800 && c <= 0xdfff) {
+            if constexpr (WCHAR_IS_UTF16) {
+                if (c <= 0xdbff && i < size && s[i] >= 0xdc00 && s[i] <= 0xdfff) {
+                    return 0x10000 + ((c - 0xd800) << 10) + (char32_t(s[i++]) - 0xdc00);
+                }
+            }
+            return aui::utf8::REPLACEMENT_CHARACTER;
+        }
+        if (c > 0x10ffff) {
+            return aui::utf8::REPLACEMENT_CHARACTER;
+        }
+        return c;
+    }
+
+    wchar_t* put(wchar_t* dst, char32_t codePoint) noexcept {
+        if constexpr (WCHAR_IS_UTF16) {
+            if (codePoint >= 0x10000) {
+                codePoint -= 0x10000;
+                *dst++ = wchar_t(0xd800 | (codePoint >> 10));
+                *dst++ = wchar_t(0xdc00 | (codePoint & 0x3ff));
+                return dst;
+            }
+        }
+        *dst++ = wchar_t(codePoint);
+        return dst;
+    }
+
+    constexpr std::size_t sequenceLength(char32_t codePoint) noexcept {
+        if (codePoint < 0x80) return 1;
+        if (codePoint < 0x800) return 2;
+        if (codePoint < 0x10000) return 3;
+        return 4;
+    }
+}
+
+std::size_t aui::utf8::asciiPrefixLength(std::string_view utf8) noexcept {
+    return countAscii(utf8.data(), utf8.size());
+}
+
+bool aui::utf8::isValid(std::string_view utf8) noexcept {
+    auto s = reinterpret_cast<const unsigned char*>(utf8.data());
+    for (std::size_t i = 0; i < utf8.size();) {
+        if (s[i] < 0x80) {
+            i += countAscii(utf8.data() + i, utf8.size() - i);
+            continue;
+        }
+        if (decodeSequence(s, utf8.size(), i) == INVALID) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t aui::utf8::decode(std::string_view utf8, wchar_t* destination) noexcept {
+    auto s = reinterpret_cast<const unsigned char*>(utf8.data());
+    auto size = utf8.size();
+    auto out = destination;
+    for (std::size_t i = 0; i < size;) {
+        if (s[i] < 0x80) {
+            auto count = widenAscii(utf8.data() + i, size - i, out);
+            i += count;
+            out += count;
+            continue;
+        }
+        auto codePoint = decodeSequence(s, size, i);
+        out = put(out, codePoint == INVALID ? REPLACEMENT_CHARACTER : codePoint);
+    }
+    return out - destination;
+}
+
+std::size_t aui::utf8::encodedLength(std::wstring_view string) noexcept {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < string.size();) {
+        if (static_cast<std::make_unsigned_t<wchar_t>>(string[i]) < 0x80) {
+            ++result;
+            ++i;
+            continue;
+        }
+        result += sequenceLength(readCodePoint(string.data(), string.size(), i));
+    }
+    return result;
+}
+
+char* aui::utf8::encode(std::wstring_view string, char* destination) noexcept {
+    auto out = destination;
+    for (std::size_t i = 0; i < string.size();) {
+        if (static_cast<std::make_unsigned_t<wchar_t>>(string[i]) < 0x80) {
+            auto count = narrowAscii(string.data() + i, string.size() - i, out);
+            i += count;
+            out += count;
+            continue;
+        }
+        auto c = readCodePoint(string.data(), string.size(), i);
+        if (c < 0x800) {
+            *out++ = char(0xc0 | (c >> 6));
+            *out++ = char(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            *out++ = char(0xe0 | (c >> 12));
+            *out++ = char(0x80 | ((c >> 6) & 0x3f));
+            *out++ = char(0x80 | (c & 0x3f));
+        } else {
+            *out++ = char(0xf0 | (c >> 18));
+            *out++ = char(0x80 | ((c >> 12) & 0x3f));
+            *out++ = char(0x80 | ((c >> 6) & 0x3f));
+            *out++ = char(0x80 | (c & 0x3f));
+        }
+    }
+    return out;
+}
@@ -0,0 +1,69 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <AUI/Core.h>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief UTF-8 transcoding routines used by AString.
+ * @details
+ * Runs of ASCII characters are processed with SSE2/AVX2 on x86 and NEON on AArch64, depending on the instruction sets
+ * enabled for the compiler; other characters are processed by a scalar decoder.
+ *
+ * Decoding follows the Unicode recommendations: malformed sequences, overlong encodings, surrogates and code points
+ * above U+10FFFF are replaced with U+FFFD, one replacement character per maximal invalid subpart. Code points above
+ * U+FFFF are encoded as surrogate pairs where `wchar_t` is 16-bit (Windows).
+ */
+namespace aui::utf8 {
+    /**
+     * @brief Replacement character for invalid input.
+     */
+    constexpr wchar_t REPLACEMENT_CHARACTER = 0xfffd;
+
+    /**
+     * @return number of leading ASCII bytes.
+     */
+    API_AUI_CORE std::size_t asciiPrefixLength(std::string_view utf8) noexcept;
+
+    /**
+     * @return true if the string is a well-formed UTF-8 sequence.
+     */
+    API_AUI_CORE bool isValid(std::string_view utf8) noexcept;
+
+    /**
+     * @brief Decodes UTF-8 to wide characters.
+     * @param utf8 input string
+     * @param destination output buffer which is able to hold at least `utf8.size()` characters.
+     * @return number of written characters.
+     */
+    API_AUI_CORE std::size_t decode(std::string_view utf8, wchar_t* destination) noexcept;
+
+    /**
+     * @return exact number of bytes required to encode the string with encode.
+     */
+    API_AUI_CORE std::size_t encodedLength(std::wstring_view string) noexcept;
+
+    /**
+     * @brief Encodes wide characters to UTF-8.
+     * @param string input string
+     * @param destination output buffer which is able to hold at least `encodedLength(string)` bytes.
+     * @return pointer past the last written byte.
+     */
+    API_AUI_CORE char* encode(std::wstring_view string, char* destination) noexcept;
+}
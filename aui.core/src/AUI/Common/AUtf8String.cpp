@@ -0,0 +1,136 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AUtf8String.h"
+#include <AUI/Common/AUtf8.h>
+
+namespace {
+    template<typename Transform>
+    AUtf8String transformAscii(const AUtf8String& string, Transform&& transform, AString(AString::*fallback)() const) {
+        if (aui::utf8::asciiPrefixLength(string) != string.size()) {
+            return (string.toAString().*fallback)();
+        }
+        AUtf8String result = string;
+        for (auto& c : result) {
+            c = transform(c);
+        }
+        return result;
+    }
+}
+
+AUtf8String::size_type AUtf8String::codePointCount() const noexcept {
+    size_type result = 0;
+    for (auto c : view()) {
+        // count everything except the continuation bytes
+        result += (static_cast<unsigned char>(c) & 0b11000000) != 0b10000000;
+    }
+    return result;
+}
+
+bool AUtf8String::isValidUtf8() const noexcept {
+    return aui::utf8::isValid(*this);
+}
+
+AVector<AUtf8String> AUtf8String::split(char c) const {
+    if (empty()) {
+        return {};
+    }
+    AVector<AUtf8String> result;
+    for (size_type s = 0;;) {
+        auto next = find(c, s);
+        if (next == NPOS) {
+            result << substr(s);
+            break;
+        }
+        result << substr(s, next - s);
+        s = next + 1;
+    }
+    return result;
+}
+
+AUtf8String AUtf8String::trimLeft(char symbol) const {
+    auto position = view().find_first_not_of(symbol);
+    if (position == NPOS) {
+        return {};
+    }
+    return substr(position);
+}
+
+AUtf8String AUtf8String::trimRight(char symbol) const {
+    auto position = view().find_last_not_of(symbol);
+    if (position == NPOS) {
+        return {};
+    }
+    return substr(0, position + 1);
+}
+
+AUtf8String& AUtf8String::replaceAll(std::string_view from, std::string_view to) {
+    if (from.empty()) {
+        return *this;
+    }
+    auto next = find(from);
+    if (next == NPOS) {
+        return *this;
+    }
+    std::string result;
+    result.reserve(size());
+    size_type position = 0;
+    for (; next != NPOS; next = find(from, position)) {
+        result.append(view().substr(position, next - position));
+        result.append(to);
+        position = next + from.size();
+    }
+    result.append(view().substr(position));
+    mData = std::move(result);
+    return *this;
+}
+
+AUtf8String& AUtf8String::replaceAll(char from, char to) noexcept {
+    for (auto& c : *this) {
+        if (c == from) {
+            c = to;
+        }
+    }
+    return *this;
+}
+
+AUtf8String AUtf8String::uppercase() const {
+    return transformAscii(*this, [](char c) { return c >= 'a' && c <= 'z' ? char(c - 'a' + 'A') : c; }, &AString::uppercase);
+}
+
+AUtf8String AUtf8String::lowercase() const {
+    return transformAscii(*this, [](char c) { return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c; }, &AString::lowercase);
+}
+
+AOptional<int> AUtf8String::toInt() const noexcept {
+    return toAString().toInt();
+}
+
+AOptional<int64_t> AUtf8String::toLongInt() const noexcept {
+    return toAString().toLongInt();
+}
+
+AOptional<unsigned> AUtf8String::toUInt() const noexcept {
+    return toAString().toUInt();
+}
+
+AOptional<float> AUtf8String::toFloat() const noexcept {
+    return toAString().toFloat();
+}
+
+AOptional<double> AUtf8String::toDouble() const noexcept {
+    return toAString().toDouble();
+}
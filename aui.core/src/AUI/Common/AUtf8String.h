@@ -0,0 +1,428 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <AUI/Common/AString.h>
+#include <AUI/Common/AByteBufferView.h>
+#include <AUI/Common/AVector.h>
+#include <fmt/format.h>
+
+/**
+ * @brief Represents an UTF-8 string.
+ * @ingroup core
+ * @details
+ * AUtf8String provides the common AString operations on top of UTF-8 encoded storage. Unlike AString, which stores
+ * `wchar_t` (4 bytes per character on Linux), it needs 1 byte per ASCII character and does not need to be transcoded
+ * when passed to the APIs expecting UTF-8: it is implicitly convertible to `std::string_view`, and
+ * AUtf8String::toStdString and AUtf8String::bytes do not copy.
+ *
+ * Indices and lengths are measured in bytes, like in `std::string`. Use AUtf8String::codePointCount to count
+ * characters, or convert to AString for per-character processing.
+ *
+ * AString is implicitly convertible to AUtf8String, so AUtf8String can be adopted gradually. The opposite conversion
+ * decodes the whole string and is explicit: use AUtf8String::toAString.
+ */
+class API_AUI_CORE AUtf8String
+{
+private:
+    std::string mData;
+
+public:
+    using iterator = std::string::iterator;
+    using const_iterator = std::string::const_iterator;
+    using reverse_iterator = std::string::reverse_iterator;
+    using const_reverse_iterator = std::string::const_reverse_iterator;
+    using size_type = std::string::size_type;
+    using value_type = std::string::value_type;
+    auto constexpr static NPOS = std::string::npos;
+
+    AUtf8String() noexcept = default;
+    AUtf8String(const AUtf8String& other) = default;
+    AUtf8String(AUtf8String&& other) noexcept = default;
+
+    /**
+     * @param utf8 utf8 string
+     */
+    AUtf8String(const char* utf8): mData(utf8) {}
+
+    /**
+     * @param utf8 utf8 string
+     * @param length length in bytes
+     */
+    AUtf8String(const char* utf8, size_type length): mData(utf8, length) {}
+
+    /**
+     * @param utf8 utf8 string
+     */
+    AUtf8String(std::string_view utf8): mData(utf8) {}
+
+    /**
+     * @param utf8 utf8 string
+     */
+    AUtf8String(const std::string& utf8): mData(utf8) {}
+
+    /**
+     * @param utf8 utf8 string
+     */
+    AUtf8String(std::string&& utf8) noexcept: mData(std::move(utf8)) {}
+
+    AUtf8String(const AString& string): mData(string.toStdString()) {}
+
+    /**
+     * @param utf8 utf8 encoded bytes
+     */
+    explicit AUtf8String(AByteBufferView utf8): mData(utf8.data(), utf8.size()) {}
+
+    AUtf8String(size_type count, char c): mData(count, c) {}
+
+    template <class Iterator>
+    AUtf8String(Iterator first, Iterator last): mData(first, last) {}
+
+    AUtf8String& operator=(const AUtf8String& other) = default;
+    AUtf8String& operator=(AUtf8String&& other) noexcept = default;
+
+    /**
+     * @brief Zero-copy view of the string.
+     */
+    operator std::string_view() const noexcept {
+        return { mData.data(), mData.size() };
+    }
+
+    [[nodiscard]]
+    std::string_view view() const noexcept {
+        return *this;
+    }
+
+    /**
+     * @brief Zero-copy view of the utf8 bytes.
+     */
+    [[nodiscard]]
+    AByteBufferView bytes() const noexcept {
+        return { mData.data(), mData.size() };
+    }
+
+    /**
+     * @return the underlying utf8-encoded std::string. Does not copy.
+     */
+    [[nodiscard]]
+    const std::string& toStdString() const noexcept {
+        return mData;
+    }
+
+    [[nodiscard]]
+    AString toAString() const {
+        return AString::fromUtf8(mData.data(), mData.size());
+    }
+
+    /**
+     * @return number of code points (characters) in the string.
+     */
+    [[nodiscard]]
+    size_type codePointCount() const noexcept;
+
+    /**
+     * @return true if the string is a well-formed UTF-8 sequence.
+     */
+    [[nodiscard]]
+    bool isValidUtf8() const noexcept;
+
+    [[nodiscard]] const char* data() const noexcept { return mData.data(); }
+    [[nodiscard]] char* data() noexcept { return mData.data(); }
+    [[nodiscard]] const char* c_str() const noexcept { return mData.c_str(); }
+    [[nodiscard]] size_type size() const noexcept { return mData.size(); }
+    [[nodiscard]] size_type length() const noexcept { return mData.length(); }
+    [[nodiscard]] bool empty() const noexcept { return mData.empty(); }
+
+    void clear() noexcept { mData.clear(); }
+    void reserve(size_type s) { mData.reserve(s); }
+    void resize(size_type s) { mData.resize(s); }
+    void push_back(char c) { mData.push_back(c); }
+    void pop_back() noexcept { mData.pop_back(); }
+
+    char operator[](size_type index) const noexcept { return mData[index]; }
+    char& operator[](size_type index) noexcept { return mData[index]; }
+
+    char& front() noexcept { return mData.front(); }
+    char& back() noexcept { return mData.back(); }
+    const char& front() const noexcept { return mData.front(); }
+    const char& back() const noexcept { return mData.back(); }
+    char& first() noexcept { return mData.front(); }
+    char& last() noexcept { return mData.back(); }
+    const char& first() const noexcept { return mData.front(); }
+    const char& last() const noexcept { return mData.back(); }
+
+    iterator begin() noexcept { return mData.begin(); }
+    iterator end() noexcept { return mData.end(); }
+    const_iterator begin() const noexcept { return mData.begin(); }
+    const_iterator end() const noexcept { return mData.end(); }
+    reverse_iterator rbegin() noexcept { return mData.rbegin(); }
+    reverse_iterator rend() noexcept { return mData.rend(); }
+    const_reverse_iterator rbegin() const noexcept { return mData.rbegin(); }
+    const_reverse_iterator rend() const noexcept { return mData.rend(); }
+
+    [[nodiscard]]
+    bool startsWith(std::string_view other) const noexcept {
+        return view().starts_with(other);
+    }
+    [[nodiscard]]
+    bool startsWith(char c) const noexcept {
+        return view().starts_with(c);
+    }
+    [[nodiscard]]
+    bool endsWith(std::string_view other) const noexcept {
+        return view().ends_with(other);
+    }
+    [[nodiscard]]
+    bool endsWith(char c) const noexcept {
+        return view().ends_with(c);
+    }
+
+    [[nodiscard]]
+    bool contains(char c) const noexcept {
+        return find(c) != NPOS;
+    }
+    [[nodiscard]]
+    bool contains(std::string_view other) const noexcept {
+        return find(other) != NPOS;
+    }
+
+    [[nodiscard]]
+    size_type find(char c, size_type offset = 0) const noexcept {
+        return mData.find(c, offset);
+    }
+    [[nodiscard]]
+    size_type find(std::string_view str, size_type offset = 0) const noexcept {
+        return mData.find(str, offset);
+    }
+    [[nodiscard]]
+    size_type rfind(char c, size_type offset = NPOS) const noexcept {
+        return mData.rfind(c, offset);
+    }
+    [[nodiscard]]
+    size_type rfind(std::string_view str, size_type offset = NPOS) const noexcept {
+        return mData.rfind(str, offset);
+    }
+
+    /**
+     * @param offset offset in bytes
+     * @param count count in bytes
+     */
+    [[nodiscard]]
+    AUtf8String substr(size_type offset, size_type count = NPOS) const {
+        return view().substr(offset, count);
+    }
+
+    [[nodiscard]]
+    AVector<AUtf8String> split(char c) const;
+
+    [[nodiscard]]
+    AUtf8String trimLeft(char symbol = ' ') const;
+    [[nodiscard]]
+    AUtf8String trimRight(char symbol = ' ') const;
+    [[nodiscard]]
+    AUtf8String trim(char symbol = ' ') const {
+        return trimRight(symbol).trimLeft(symbol);
+    }
+
+    AUtf8String& replaceAll(std::string_view from, std::string_view to);
+    AUtf8String& replaceAll(char from, char to) noexcept;
+
+    [[nodiscard]]
+    AUtf8String replacedAll(std::string_view from, std::string_view to) const {
+        auto copy = *this;
+        copy.replaceAll(from, to);
+        return copy;
+    }
+    [[nodiscard]]
+    AUtf8String replacedAll(char from, char to) const {
+        auto copy = *this;
+        copy.replaceAll(from, to);
+        return copy;
+    }
+
+    /**
+     * @brief Same as AString::uppercase. ASCII strings are converted in place without transcoding.
+     */
+    [[nodiscard]]
+    AUtf8String uppercase() const;
+
+    /**
+     * @brief Same as AString::lowercase. ASCII strings are converted in place without transcoding.
+     */
+    [[nodiscard]]
+    AUtf8String lowercase() const;
+
+    /**
+     * @see AString::toInt
+     */
+    [[nodiscard]] AOptional<int> toInt() const noexcept;
+
+    /**
+     * @see AString::toLongInt
+     */
+    [[nodiscard]] AOptional<int64_t> toLongInt() const noexcept;
+
+    /**
+     * @see AString::toUInt
+     */
+    [[nodiscard]] AOptional<unsigned> toUInt() const noexcept;
+
+    /**
+     * @see AString::toFloat
+     */
+    [[nodiscard]] AOptional<float> toFloat() const noexcept;
+
+    /**
+     * @see AString::toDouble
+     */
+    [[nodiscard]] AOptional<double> toDouble() const noexcept;
+
+    [[nodiscard]]
+    bool toBool() const noexcept {
+        return view() == "true";
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<std::decay_t<T>> || std::is_floating_point_v<std::decay_t<T>>, int> = 0>
+    [[nodiscard]]
+    static AUtf8String number(T i) noexcept {
+        if constexpr (std::is_same_v<bool, std::decay_t<T>>) {
+            return i ? "true" : "false";
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return AString::number(i);
+        } else {
+            char buffer[24];
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), i);
+            return { buffer, static_cast<size_type>(end - buffer) };
+        }
+    }
+
+    /**
+     * @brief Formats the string with fmt.
+     */
+    template<typename... Args>
+    [[nodiscard]]
+    AUtf8String format(Args&&... args) const {
+        return fmt::vformat(view(), fmt::make_format_args(args...));
+    }
+
+    AUtf8String& append(std::string_view s) {
+        mData.append(s);
+        return *this;
+    }
+    AUtf8String& append(size_type count, char c) {
+        mData.append(count, c);
+        return *this;
+    }
+
+    AUtf8String& operator+=(std::string_view s) {
+        return append(s);
+    }
+    AUtf8String& operator+=(const char* s) {
+        return append(s);
+    }
+    AUtf8String& operator+=(char c) {
+        mData.push_back(c);
+        return *this;
+    }
+
+    AUtf8String& operator<<(std::string_view s) {
+        return append(s);
+    }
+    AUtf8String& operator<<(char c) {
+        mData.push_back(c);
+        return *this;
+    }
+
+    AUtf8String& erase(size_type offset, size_type count = NPOS) {
+        mData.erase(offset, count);
+        return *this;
+    }
+
+    AUtf8String& insert(size_type offset, std::string_view s) {
+        mData.insert(offset, s);
+        return *this;
+    }
+
+    [[nodiscard]]
+    bool operator==(std::string_view other) const noexcept {
+        return view() == other;
+    }
+    [[nodiscard]]
+    bool operator==(const char* other) const noexcept {
+        return view() == other;
+    }
+    [[nodiscard]]
+    bool operator<(const AUtf8String& other) const noexcept {
+        return view() < other.view();
+    }
+};
+
+inline AUtf8String operator+(const AUtf8String& l, std::string_view r) {
+    auto x = l;
+    x.append(r);
+    return x;
+}
+inline AUtf8String operator+(const AUtf8String& l, const char* r) {
+    return l + std::string_view(r);
+}
+inline AUtf8String operator+(const AUtf8String& l, char r) {
+    auto x = l;
+    x += r;
+    return x;
+}
+inline AUtf8String operator+(std::string_view l, const AUtf8String& r) {
+    AUtf8String x(l);
+    x.append(r);
+    return x;
+}
+inline AUtf8String operator+(const char* l, const AUtf8String& r) {
+    return std::string_view(l) + r;
+}
+
+inline std::ostream& operator<<(std::ostream& o, const AUtf8String& s) {
+    return o << s.view();
+}
+
+namespace std {
+    template<>
+    struct hash<AUtf8String> {
+        size_t operator()(const AUtf8String& t) const noexcept {
+            return hash<std::string_view>()(t.view());
+        }
+    };
+}
+
+template <> struct fmt::formatter<AUtf8String>: fmt::formatter<std::string_view> {
+    auto format(const AUtf8String& s, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(s.view(), ctx);
+    }
+};
+
+template<>
+struct ASerializable<AUtf8String> {
+    static void write(IOutputStream& os, const AUtf8String& value) {
+        os.write(value.data(), value.size());
+    }
+};
+
+// gtest printer for AUtf8String
+inline void PrintTo(const AUtf8String& s, std::ostream* stream) {
+    *stream << s.view();
+}
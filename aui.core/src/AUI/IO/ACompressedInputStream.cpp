@@ -0,0 +1,40 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ACompressedInputStream.h"
+#include "AIOException.h"
+
+ACompressedInputStream::ACompressedInputStream(_<IInputStream> source, const _<ICompressionCodec>& codec):
+    mSource(std::move(source)),
+    mDecoder(codec->makeDecoder())
+{
+}
+
+size_t ACompressedInputStream::read(char* dst, size_t size) {
+    char* output = dst;
+    char* outputEnd = dst + size;
+    while (output == dst && !mFinished) {
+        if (mRead == mEnd) {
+            mRead = mBuffer;
+            mEnd = mBuffer + mSource->read(mBuffer, sizeof(mBuffer));
+            if (mRead == mEnd) {
+                throw AIOException("unexpected end of compressed stream");
+            }
+        }
+        mFinished = mDecoder->decode(mRead, mEnd, output, outputEnd);
+    }
+    return output - dst;
+}
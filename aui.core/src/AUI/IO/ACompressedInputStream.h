@@ -0,0 +1,53 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "AUI/Common/SharedPtr.h"
+#include "AZlibCodec.h"
+#include "IInputStream.h"
+
+/**
+ * @brief Decompresses data of the underlying stream on the fly.
+ * @ingroup io
+ * @details
+ * Uses a fixed-size buffer, so the memory usage does not depend on the data size. The stream ends at the end of the
+ * compressed data; the data of the underlying stream after it is not read by the decoder.
+ *
+ * @code{cpp}
+ * ACompressedInputStream is(_new<AFileInputStream>("data.z"));
+ * auto data = AByteBuffer::fromStream(is);
+ * @endcode
+ */
+class API_AUI_CORE ACompressedInputStream final: public IInputStream {
+public:
+    static constexpr std::size_t BUFFER_SIZE = 16 * 1024;
+
+    explicit ACompressedInputStream(_<IInputStream> source, const _<ICompressionCodec>& codec = AZlibCodec::inst());
+
+    /**
+     * @throws AIOException if the compressed data is truncated.
+     */
+    size_t read(char* dst, size_t size) override;
+
+private:
+    _<IInputStream> mSource;
+    _unique<ICompressionCodec::Decoder> mDecoder;
+    bool mFinished = false;
+    const char* mRead = mBuffer;
+    const char* mEnd = mBuffer;
+    char mBuffer[BUFFER_SIZE];
+};
@@ -0,0 +1,78 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ACompressedOutputStream.h"
+#include "AIOException.h"
+#include "AUI/Logging/ALogger.h"
+
+static constexpr auto LOG_TAG = "ACompressedOutputStream";
+
+ACompressedOutputStream::ACompressedOutputStream(_<IOutputStream> destination, int level,
+                                                 const _<ICompressionCodec>& codec):
+    mDestination(std::move(destination)),
+    mEncoder(codec->makeEncoder(level))
+{
+}
+
+ACompressedOutputStream::~ACompressedOutputStream() {
+    if (mFinished) {
+        return;
+    }
+    try {
+        finish();
+    } catch (const AException& e) {
+        ALogger::err(LOG_TAG) << "Could not finish compressed stream: " << e;
+    } catch (const std::exception& e) {
+        ALogger::err(LOG_TAG) << "Could not finish compressed stream: " << e.what();
+    }
+}
+
+void ACompressedOutputStream::write(const char* src, size_t size) {
+    if (mFinished) {
+        throw AIOException("write to a finished compressed stream");
+    }
+    const char* end = src + size;
+    while (src != end) {
+        mEncoder->encode(src, end, mWrite, std::end(mBuffer), false);
+        if (mWrite == std::end(mBuffer)) {
+            flushBuffer();
+        }
+    }
+}
+
+void ACompressedOutputStream::finish() {
+    if (mFinished) {
+        return;
+    }
+    mFinished = true;
+    for (;;) {
+        const char* input = nullptr;
+        bool done = mEncoder->encode(input, input, mWrite, std::end(mBuffer), true);
+        if (done || mWrite == std::end(mBuffer)) {
+            flushBuffer();
+        }
+        if (done) {
+            return;
+        }
+    }
+}
+
+void ACompressedOutputStream::flushBuffer() {
+    if (mWrite != mBuffer) {
+        mDestination->write(mBuffer, mWrite - mBuffer);
+        mWrite = mBuffer;
+    }
+}
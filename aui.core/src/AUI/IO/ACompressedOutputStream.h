@@ -0,0 +1,67 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "AUI/Common/SharedPtr.h"
+#include "AZlibCodec.h"
+#include "IOutputStream.h"
+
+/**
+ * @brief Compresses data on the fly and writes it to the underlying stream.
+ * @ingroup io
+ * @details
+ * Uses a fixed-size buffer, so the memory usage does not depend on the data size. The compressed data is complete
+ * only after finish() is called; the destructor calls it if it was not called.
+ *
+ * @code{cpp}
+ * ACompressedOutputStream os(_new<AFileOutputStream>("data.z"), 6);
+ * os << data;
+ * os.finish();
+ * @endcode
+ */
+class API_AUI_CORE ACompressedOutputStream final: public IOutputStream {
+public:
+    static constexpr std::size_t BUFFER_SIZE = 16 * 1024;
+
+    /**
+     * @param destination stream to write the compressed data to.
+     * @param level codec-specific compression level.
+     * @param codec compression algorithm.
+     */
+    explicit ACompressedOutputStream(_<IOutputStream> destination,
+                                     int level = ICompressionCodec::DEFAULT_LEVEL,
+                                     const _<ICompressionCodec>& codec = AZlibCodec::inst());
+    ~ACompressedOutputStream() override;
+
+    void write(const char* src, size_t size) override;
+
+    /**
+     * @brief Completes the compressed data and writes it to the underlying stream.
+     * @details
+     * Nothing can be written after finish().
+     */
+    void finish();
+
+private:
+    _<IOutputStream> mDestination;
+    _unique<ICompressionCodec::Encoder> mEncoder;
+    bool mFinished = false;
+    char* mWrite = mBuffer;
+    char mBuffer[BUFFER_SIZE];
+
+    void flushBuffer();
+};
@@ -0,0 +1,31 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstring>
+#include "AMappedFile.h"
+
+AMappedFileInputStream::AMappedFileInputStream(const APath& path): AMappedFileInputStream(AMappedFile(path)) {}
+
+AMappedFileInputStream::AMappedFileInputStream(AMappedFile file): mFile(std::move(file)) {
+    mFile.advise(AMappedFile::Access::SEQUENTIAL);
+}
+
+size_t AMappedFileInputStream::read(char* dst, size_t size) {
+    size = std::min(size, mFile.size() - mPosition);
+    std::memcpy(dst, mFile.data() + mPosition, size);
+    mPosition += size;
+    return size;
+}
@@ -0,0 +1,197 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "AUI/Core.h"
+#include "AUI/Common/AByteBufferView.h"
+#include "AUI/Traits/values.h"
+#include "APath.h"
+#include "IInputStream.h"
+
+/**
+ * @brief Read-only memory mapping of a file.
+ * @ingroup io
+ * @details
+ * The file contents are accessed directly from the page cache of the operating system, so neither a read syscall nor
+ * a copy to an AByteBuffer is performed. The pages are loaded lazily, as they are accessed.
+ *
+ * @code{cpp}
+ * AMappedFile file("image.png");
+ * auto image = AImageLoaderRegistry::inst().loadRaster(file.view());
+ * @endcode
+ *
+ * The mapping must outlive the views of it. If the file is modified by another process while it is mapped, the
+ * contents of the mapping are unspecified; if the file is truncated, accessing the cut pages may crash the application.
+ */
+class API_AUI_CORE AMappedFile: public aui::noncopyable {
+public:
+    enum class Mode {
+        /**
+         * @brief The mapping is read-only.
+         */
+        READ_ONLY,
+
+        /**
+         * @brief The mapping is writable; the changes are private to the process and are never written to the file.
+         * @details
+         * Only the modified pages are copied.
+         */
+        COPY_ON_WRITE,
+    };
+
+    /**
+     * @brief Expected access pattern. Helps the operating system to schedule the read ahead.
+     */
+    enum class Access {
+        NORMAL,
+
+        /**
+         * @brief The contents are read from the beginning to the end; aggressive read ahead, the read pages can be
+         * freed early.
+         */
+        SEQUENTIAL,
+
+        /**
+         * @brief The contents are read in random order; read ahead is disabled.
+         */
+        RANDOM,
+
+        /**
+         * @brief The contents will be accessed soon; the pages are loaded in background.
+         */
+        WILL_NEED,
+    };
+
+    /**
+     * @brief Maps the whole file.
+     * @throws AIOException (or a subclass) if the file could not be opened or mapped.
+     */
+    explicit AMappedFile(const APath& path, Mode mode = Mode::READ_ONLY);
+
+    AMappedFile(AMappedFile&& rhs) noexcept: mData(rhs.mData), mSize(rhs.mSize), mMode(rhs.mMode) {
+        rhs.mData = nullptr;
+        rhs.mSize = 0;
+    }
+
+    AMappedFile& operator=(AMappedFile&& rhs) noexcept {
+        if (this != &rhs) {
+            unmap();
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mMode = rhs.mMode;
+            rhs.mData = nullptr;
+            rhs.mSize = 0;
+        }
+        return *this;
+    }
+
+    ~AMappedFile() {
+        unmap();
+    }
+
+    [[nodiscard]]
+    const char* data() const noexcept {
+        return mData;
+    }
+
+    /**
+     * @brief Writable contents.
+     * @details
+     * Applicable only for Mode::COPY_ON_WRITE.
+     */
+    [[nodiscard]]
+    char* mutableData() noexcept {
+        assert(("the file is mapped as read-only", mMode == Mode::COPY_ON_WRITE));
+        return mData;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return mSize;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    [[nodiscard]]
+    Mode mode() const noexcept {
+        return mMode;
+    }
+
+    /**
+     * @return contents of the file. Valid as long as the mapping is alive.
+     */
+    [[nodiscard]]
+    AByteBufferView view() const noexcept {
+        return { mData, mSize };
+    }
+
+    /**
+     * @brief Gives the operating system a hint about the access pattern.
+     * @details
+     * The hint does not change the contents and may be ignored by the operating system.
+     */
+    void advise(Access access) noexcept {
+        advise(access, 0, mSize);
+    }
+
+    /**
+     * @brief Gives the operating system a hint about the access pattern of a range of the file.
+     */
+    void advise(Access access, std::size_t offset, std::size_t size) noexcept;
+
+private:
+    char* mData = nullptr;
+    std::size_t mSize = 0;
+    Mode mMode;
+
+    void unmap() noexcept;
+};
+
+/**
+ * @brief Reads a memory mapped file.
+ * @ingroup io
+ * @details
+ * Unlike AFileInputStream, reads are plain memory copies from the page cache. The mapping is advised for the
+ * sequential access.
+ */
+class API_AUI_CORE AMappedFileInputStream final: public IInputStream {
+public:
+    explicit AMappedFileInputStream(const APath& path);
+    explicit AMappedFileInputStream(AMappedFile file);
+
+    size_t read(char* dst, size_t size) override;
+
+    /**
+     * @return contents of the file which were not read yet.
+     */
+    [[nodiscard]]
+    AByteBufferView remaining() const noexcept {
+        return { mFile.data() + mPosition, mFile.size() - mPosition };
+    }
+
+    [[nodiscard]]
+    const AMappedFile& file() const noexcept {
+        return mFile;
+    }
+
+private:
+    AMappedFile mFile;
+    std::size_t mPosition = 0;
+};
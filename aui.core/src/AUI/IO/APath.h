@@ -135,6 +135,9 @@ public:
     APath(const char* utf8, std::size_t length) noexcept: AString(utf8, utf8 + length) {
         removeBackSlashes();
     }
+    APath(const AUtf8String& utf8) noexcept: AString(utf8) {
+        removeBackSlashes();
+    }
     APath(const wchar_t * str) noexcept: AString(str) {
         removeBackSlashes();
     }
@@ -0,0 +1,115 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <limits>
+#include <zlib.h>
+#include "AZlibCodec.h"
+#include "AUI/Common/SharedPtr.h"
+#include "AUI/Util/LZ.h"
+
+namespace {
+    std::size_t clampToUInt(std::size_t size) noexcept {
+        return std::min<std::size_t>(size, std::numeric_limits<uInt>::max());
+    }
+
+    class ZlibEncoder: public ICompressionCodec::Encoder {
+    public:
+        explicit ZlibEncoder(int level) {
+            if (int r = deflateInit(&mStream, level); r != Z_OK) {
+                throw AZLibException("zlib deflateInit error " + AString::number(r));
+            }
+        }
+
+        ~ZlibEncoder() override {
+            deflateEnd(&mStream);
+        }
+
+        bool encode(const char*& input, const char* inputEnd, char*& output, char* outputEnd, bool finish) override {
+            auto inputSize = clampToUInt(inputEnd - input);
+            auto outputSize = clampToUInt(outputEnd - output);
+            mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+            mStream.avail_in = uInt(inputSize);
+            mStream.next_out = reinterpret_cast<Bytef*>(output);
+            mStream.avail_out = uInt(outputSize);
+            bool last = finish && inputSize == std::size_t(inputEnd - input);
+            int r = deflate(&mStream, last ? Z_FINISH : Z_NO_FLUSH);
+            input += inputSize - mStream.avail_in;
+            output += outputSize - mStream.avail_out;
+            switch (r) {
+                case Z_STREAM_END:
+                    return true;
+                case Z_OK:
+                case Z_BUF_ERROR: // no progress possible; the caller has to provide more output space
+                    return false;
+                default:
+                    throw AZLibException("zlib compress error " + AString::number(r));
+            }
+        }
+
+    private:
+        z_stream mStream{};
+    };
+
+    class ZlibDecoder: public ICompressionCodec::Decoder {
+    public:
+        ZlibDecoder() {
+            if (int r = inflateInit(&mStream); r != Z_OK) {
+                throw AZLibException("zlib inflateInit error " + AString::number(r));
+            }
+        }
+
+        ~ZlibDecoder() override {
+            inflateEnd(&mStream);
+        }
+
+        bool decode(const char*& input, const char* inputEnd, char*& output, char* outputEnd) override {
+            auto inputSize = clampToUInt(inputEnd - input);
+            auto outputSize = clampToUInt(outputEnd - output);
+            mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+            mStream.avail_in = uInt(inputSize);
+            mStream.next_out = reinterpret_cast<Bytef*>(output);
+            mStream.avail_out = uInt(outputSize);
+            int r = inflate(&mStream, Z_NO_FLUSH);
+            input += inputSize - mStream.avail_in;
+            output += outputSize - mStream.avail_out;
+            switch (r) {
+                case Z_STREAM_END:
+                    return true;
+                case Z_OK:
+                case Z_BUF_ERROR:
+                    return false;
+                default:
+                    throw AZLibException("zlib decompress error " + AString::number(r));
+            }
+        }
+
+    private:
+        z_stream mStream{};
+    };
+}
+
+_unique<ICompressionCodec::Encoder> AZlibCodec::makeEncoder(int level) {
+    return std::make_unique<ZlibEncoder>(level == DEFAULT_LEVEL ? Z_DEFAULT_COMPRESSION : level);
+}
+
+_unique<ICompressionCodec::Decoder> AZlibCodec::makeDecoder() {
+    return std::make_unique<ZlibDecoder>();
+}
+
+const _<AZlibCodec>& AZlibCodec::inst() {
+    static auto codec = _new<AZlibCodec>();
+    return codec;
+}
@@ -0,0 +1,37 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "ICompressionCodec.h"
+
+/**
+ * @brief zlib (deflate) compression.
+ * @ingroup io
+ * @details
+ * Compression levels are 0 (no compression) to 9 (best compression). The data is compatible with LZ::compress and
+ * LZ::decompress.
+ */
+class API_AUI_CORE AZlibCodec: public ICompressionCodec {
+public:
+    _unique<Encoder> makeEncoder(int level) override;
+    _unique<Decoder> makeDecoder() override;
+
+    /**
+     * @brief Shared instance.
+     */
+    static const _<AZlibCodec>& inst();
+};
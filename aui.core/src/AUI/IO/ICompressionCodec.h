@@ -0,0 +1,79 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "AUI/Core.h"
+#include "AUI/Common/SharedPtrTypes.h"
+
+/**
+ * @brief Compression algorithm for ACompressedInputStream and ACompressedOutputStream.
+ * @ingroup io
+ * @details
+ * AUI provides AZlibCodec. Other algorithms (i.e. zstd or LZ4) are plugged in by implementing this interface.
+ *
+ * Encoders and decoders process the data by parts of any size, so the streams work in a constant memory.
+ */
+class API_AUI_CORE ICompressionCodec {
+public:
+    /**
+     * @brief Codec's default compression level.
+     */
+    static constexpr int DEFAULT_LEVEL = -1;
+
+    class Encoder {
+    public:
+        virtual ~Encoder() = default;
+
+        /**
+         * @brief Compresses a part of the data.
+         * @param input beginning of the input; advanced by the number of consumed bytes.
+         * @param inputEnd end of the input.
+         * @param output beginning of the output space; advanced by the number of produced bytes.
+         * @param outputEnd end of the output space.
+         * @param finish the input is the last part of the data.
+         * @return true, if finish is set and the compressed data is completely written.
+         * @details
+         * The encoder may keep the consumed data in its internal state; call encode with finish = true until it
+         * returns true to get the rest of the compressed data.
+         */
+        virtual bool encode(const char*& input, const char* inputEnd, char*& output, char* outputEnd, bool finish) = 0;
+    };
+
+    class Decoder {
+    public:
+        virtual ~Decoder() = default;
+
+        /**
+         * @brief Decompresses a part of the data.
+         * @param input beginning of the input; advanced by the number of consumed bytes.
+         * @param inputEnd end of the input.
+         * @param output beginning of the output space; advanced by the number of produced bytes.
+         * @param outputEnd end of the output space.
+         * @return true, if the end of the compressed data is reached.
+         * @throws AException if the input is not a valid compressed data.
+         */
+        virtual bool decode(const char*& input, const char* inputEnd, char*& output, char* outputEnd) = 0;
+    };
+
+    virtual ~ICompressionCodec() = default;
+
+    /**
+     * @param level codec-specific compression level or DEFAULT_LEVEL.
+     */
+    virtual _unique<Encoder> makeEncoder(int level) = 0;
+    virtual _unique<Decoder> makeDecoder() = 0;
+};
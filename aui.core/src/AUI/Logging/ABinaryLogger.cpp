@@ -0,0 +1,246 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ABinaryLogger.h"
+#include <AUI/IO/AFileOutputStream.h>
+#include <AUI/IO/AEOFException.h>
+#include <AUI/Thread/AThread.h>
+#include <fmt/args.h>
+#include <ctime>
+
+namespace {
+    constexpr std::size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    std::atomic_uint32_t gThreadKeyCounter = 0;
+
+    std::uint32_t currentThreadKey() {
+        thread_local std::uint32_t key = ++gThreadKeyCounter;
+        return key;
+    }
+
+    const char* levelName(int level) {
+        switch (level) {
+            case ALogger::INFO: return "INFO";
+            case ALogger::WARN: return "WARN";
+            case ALogger::ERR: return "ERR";
+            case ALogger::DEBUG: return "DEBUG";
+            default: return "UNKNOWN";
+        }
+    }
+
+    /**
+     * @brief Reads little-endian values of the binary log.
+     */
+    struct Reader {
+        IInputStream& input;
+
+        /**
+         * @return false on the end of the stream.
+         */
+        bool tryReadByte(std::uint8_t& byte) {
+            char c;
+            if (input.read(&c, 1) == 0) {
+                return false;
+            }
+            byte = std::uint8_t(c);
+            return true;
+        }
+
+        std::uint64_t readInt(unsigned bytes) {
+            char buffer[8];
+            input.readExact(buffer, bytes);
+            std::uint64_t result = 0;
+            for (unsigned i = 0; i < bytes; ++i) {
+                result |= std::uint64_t(std::uint8_t(buffer[i])) << (i * 8);
+            }
+            return result;
+        }
+
+        std::string readString(unsigned lengthBytes) {
+            // the length is untrusted: the string grows while the data is actually read, so a corrupted length hits
+            // the end of the input instead of allocating up to 4 GiB
+            static constexpr std::uint64_t CHUNK_SIZE = 64 * 1024;
+            auto length = readInt(lengthBytes);
+            std::string result;
+            while (result.size() < length) {
+                auto offset = result.size();
+                result.resize(offset + (std::min)(length - offset, CHUNK_SIZE));
+                input.readExact(result.data() + offset, result.size() - offset);
+            }
+            return result;
+        }
+    };
+
+    struct FormatDefinition {
+        int level;
+        std::string tag;
+        std::string format;
+    };
+}
+
+ABinaryLogger::ABinaryLogger(_<IOutputStream> output): mOutput(std::move(output)) {
+    mPending.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+}
+
+ABinaryLogger::ABinaryLogger(const APath& path): ABinaryLogger(_new<AFileOutputStream>(path)) {}
+
+ABinaryLogger::~ABinaryLogger() {
+    try {
+        flush();
+    } catch (...) {}
+}
+
+std::string& ABinaryLogger::argsBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+void ABinaryLogger::write(ALogger::Level level, const char* tag, const char* format, const std::string& args) {
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    auto threadKey = currentThreadKey();
+
+    std::unique_lock lock(mSync);
+    auto [formatIt, newFormat] = mFormatIds.try_emplace(FormatKey{tag, format, level}, std::uint32_t(mFormatIds.size()));
+    if (newFormat) {
+        auto tagView = std::string_view(tag).substr(0, 0xffff);
+        auto formatView = std::string_view(format).substr(0, 0xffff);
+        mPending.push_back(char(RECORD_FORMAT));
+        putInt(mPending, formatIt->second, 4);
+        mPending.push_back(char(level));
+        putInt(mPending, tagView.size(), 2);
+        mPending.append(tagView);
+        putInt(mPending, formatView.size(), 2);
+        mPending.append(formatView);
+    }
+    if (mKnownThreads.insert(threadKey).second) {
+        std::string name = "?";
+        if (auto thread = AThread::current()) {
+            name = thread->threadName().toStdString();
+        }
+        name.resize((std::min)(name.size(), std::size_t(0xffff)));
+        mPending.push_back(char(RECORD_THREAD));
+        putInt(mPending, threadKey, 4);
+        putInt(mPending, name.size(), 2);
+        mPending.append(name);
+    }
+    mPending.push_back(char(RECORD_ENTRY));
+    putInt(mPending, formatIt->second, 4);
+    putInt(mPending, threadKey, 4);
+    putInt(mPending, std::uint64_t(time), 8);
+    mPending.append(args);
+
+    if (mPending.size() >= FLUSH_THRESHOLD) {
+        flushLocked();
+    }
+}
+
+void ABinaryLogger::flush() {
+    std::unique_lock lock(mSync);
+    flushLocked();
+}
+
+void ABinaryLogger::flushLocked() {
+    if (mPending.empty()) {
+        return;
+    }
+    mOutput->write(mPending.data(), mPending.size());
+    mPending.clear();
+}
+
+void ABinaryLogger::decode(IInputStream& input, IOutputStream& output) {
+    Reader reader{input};
+    char magic[sizeof(FILE_MAGIC)];
+    try {
+        input.readExact(magic, sizeof(magic));
+    } catch (const AEOFException&) {
+        throw AException("not a binary log");
+    }
+    if (std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        throw AException("not a binary log");
+    }
+
+    std::unordered_map<std::uint32_t, FormatDefinition> formats;
+    std::unordered_map<std::uint32_t, std::string> threads;
+    std::string line;
+    std::uint8_t record;
+    try {
+        while (reader.tryReadByte(record)) {
+            switch (record) {
+                case RECORD_FORMAT: {
+                    auto id = std::uint32_t(reader.readInt(4));
+                    auto& definition = formats[id];
+                    definition.level = int(reader.readInt(1));
+                    definition.tag = reader.readString(2);
+                    definition.format = reader.readString(2);
+                    break;
+                }
+                case RECORD_THREAD: {
+                    auto key = std::uint32_t(reader.readInt(4));
+                    threads[key] = reader.readString(2);
+                    break;
+                }
+                case RECORD_ENTRY: {
+                    auto formatIt = formats.find(std::uint32_t(reader.readInt(4)));
+                    if (formatIt == formats.end()) {
+                        throw AException("binary log entry refers to an unknown format");
+                    }
+                    auto threadIt = threads.find(std::uint32_t(reader.readInt(4)));
+                    auto time = std::int64_t(reader.readInt(8));
+                    auto argc = reader.readInt(1);
+
+                    fmt::dynamic_format_arg_store<fmt::format_context> args;
+                    for (std::uint64_t i = 0; i < argc; ++i) {
+                        std::uint8_t type;
+                        if (!reader.tryReadByte(type)) {
+                            throw AEOFException();
+                        }
+                        switch (type) {
+                            case ARG_INT: args.push_back(std::int64_t(reader.readInt(8))); break;
+                            case ARG_UINT: args.push_back(reader.readInt(8)); break;
+                            case ARG_DOUBLE: args.push_back(std::bit_cast<double>(reader.readInt(8))); break;
+                            case ARG_BOOL: args.push_back(reader.readInt(1) != 0); break;
+                            case ARG_STRING: args.push_back(reader.readString(4)); break;
+                            default: throw AException("binary log entry has an unknown argument type");
+                        }
+                    }
+
+                    std::time_t seconds = time / 1'000'000;
+                    char formattedTime[16] = {};
+                    std::strftime(formattedTime, sizeof(formattedTime), "%H:%M:%S", localtime(&seconds));
+
+                    const auto& definition = formatIt->second;
+                    line.clear();
+                    fmt::format_to(std::back_inserter(line), "[{}.{:06}][{}][{}][{}]: ",
+                                   formattedTime, time % 1'000'000,
+                                   threadIt != threads.end() ? std::string_view(threadIt->second) : "?",
+                                   definition.tag, levelName(definition.level));
+                    try {
+                        fmt::vformat_to(std::back_inserter(line), definition.format, args);
+                    } catch (const fmt::format_error& e) {
+                        fmt::format_to(std::back_inserter(line), "{} <format error: {}>", definition.format, e.what());
+                    }
+                    line.push_back('\n');
+                    output.write(line.data(), line.size());
+                    break;
+                }
+                default:
+                    throw AException("binary log has an unknown record kind");
+            }
+        }
+    } catch (const AEOFException&) {
+        throw AException("binary log is truncated");
+    }
+}
@@ -0,0 +1,253 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <AUI/Logging/ALogger.h>
+#include <AUI/IO/IInputStream.h>
+#include <AUI/IO/IOutputStream.h>
+#include <AUI/IO/APath.h>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @brief Compact binary log sink for high-frequency logging.
+ * @ingroup core
+ * @details
+ * Unlike ALogger, ABinaryLogger does not format the messages. Each entry is written as an id of its format string
+ * followed by the raw values of its arguments; the format strings and the thread names are written once per file.
+ * The resulting file is converted to text offline with ABinaryLogger::decode or with `aui.toolbox binlog2txt`.
+ *
+ * Format strings use the fmt syntax:
+ * @code{cpp}
+ * static constexpr auto LOG_TAG = "Network";
+ * ABinaryLogger binaryLog("network.binlog");
+ * ...
+ * ALOG_BINARY(binaryLog, DEBUG, LOG_TAG, "received {} bytes from {}", size, address);
+ * @endcode
+ *
+ * Integer, floating point, boolean and string arguments are stored as is; values of other types are converted to
+ * string with `operator<<`.
+ *
+ * @note The tag and the format string are identified by their addresses, so they must have static storage duration
+ * (i.e. be string literals or constants).
+ */
+class API_AUI_CORE ABinaryLogger {
+public:
+    /**
+     * @brief Record kinds of the binary log.
+     * @details
+     * The file starts with the 8 byte FILE_MAGIC followed by records. Each record starts with its kind byte. All
+     * integers are little-endian.
+     */
+    enum Record: std::uint8_t {
+        /**
+         * @brief u32 format id, u8 level, u16 tag length, tag, u16 format length, format.
+         */
+        RECORD_FORMAT = 1,
+
+        /**
+         * @brief u32 thread key, u16 name length, name.
+         */
+        RECORD_THREAD = 2,
+
+        /**
+         * @brief u32 format id, u32 thread key, i64 microseconds since epoch, u8 argument count, arguments.
+         */
+        RECORD_ENTRY = 3,
+    };
+
+    /**
+     * @brief Argument types. An argument is written as its type byte followed by its value.
+     */
+    enum ArgType: std::uint8_t {
+        /**
+         * @brief i64
+         */
+        ARG_INT = 1,
+
+        /**
+         * @brief u64
+         */
+        ARG_UINT = 2,
+
+        /**
+         * @brief f64
+         */
+        ARG_DOUBLE = 3,
+
+        /**
+         * @brief u8
+         */
+        ARG_BOOL = 4,
+
+        /**
+         * @brief u32 length, utf8 bytes
+         */
+        ARG_STRING = 5,
+    };
+
+    static constexpr char FILE_MAGIC[8] = {'A', 'U', 'I', 'B', 'L', 'O', 'G', 1};
+
+    /**
+     * @param output stream to write the log to.
+     */
+    explicit ABinaryLogger(_<IOutputStream> output);
+
+    /**
+     * @param path log file.
+     */
+    explicit ABinaryLogger(const APath& path);
+
+    ~ABinaryLogger();
+
+    /**
+     * @brief Sets the minimal level of entries to be written.
+     * @see ALogger::setMinLevel
+     */
+    void setMinLevel(ALogger::Level level) noexcept {
+        mMinSeverity.store(ALogger::severity(level), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    bool isEnabled(ALogger::Level level) const noexcept {
+        return ALogger::isCompiledIn(level) &&
+               ALogger::severity(level) >= mMinSeverity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Writes an entry.
+     * @param level level
+     * @param tag tag. Must have static storage duration.
+     * @param format fmt format string. Must have static storage duration.
+     * @param args arguments
+     * @details
+     * Consider using ALOG_BINARY which does not evaluate the arguments when the entry is filtered out.
+     */
+    template<std::size_t N, typename... Args>
+    void log(ALogger::Level level, const char* tag, const char (&format)[N], const Args&... args) {
+        static_assert(sizeof...(Args) <= 255, "too many arguments");
+        if (!isEnabled(level)) {
+            return;
+        }
+        auto& buffer = argsBuffer();
+        buffer.clear();
+        buffer.push_back(char(sizeof...(Args)));
+        (encodeArg(buffer, args), ...);
+        write(level, tag, format, buffer);
+    }
+
+    /**
+     * @brief Writes the buffered records to the output stream.
+     */
+    void flush();
+
+    /**
+     * @brief Converts the binary log to text.
+     * @param input binary log
+     * @param output text output, an entry per line.
+     * @throws AException if the input is not a valid binary log.
+     */
+    static void decode(IInputStream& input, IOutputStream& output);
+
+private:
+    struct FormatKey {
+        const char* tag;
+        const char* format;
+        ALogger::Level level;
+
+        bool operator==(const FormatKey&) const noexcept = default;
+    };
+
+    struct FormatKeyHash {
+        std::size_t operator()(const FormatKey& k) const noexcept {
+            return std::hash<const void*>{}(k.format) ^ (std::hash<const void*>{}(k.tag) << 1) ^ std::size_t(k.level);
+        }
+    };
+
+    _<IOutputStream> mOutput;
+    std::atomic_int mMinSeverity = 0;
+
+    AMutex mSync;
+    std::string mPending;
+    std::unordered_map<FormatKey, std::uint32_t, FormatKeyHash> mFormatIds;
+    std::unordered_set<std::uint32_t> mKnownThreads;
+
+    static std::string& argsBuffer();
+
+    void write(ALogger::Level level, const char* tag, const char* format, const std::string& args);
+    void flushLocked();
+
+    static void putInt(std::string& buffer, std::uint64_t value, unsigned bytes) {
+        for (unsigned i = 0; i < bytes; ++i) {
+            buffer.push_back(char(value >> (i * 8)));
+        }
+    }
+
+    static void putString(std::string& buffer, std::string_view string) {
+        buffer.push_back(char(ARG_STRING));
+        putInt(buffer, string.size(), 4);
+        buffer.append(string);
+    }
+
+    template<typename T>
+    static void encodeArg(std::string& buffer, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            buffer.push_back(char(ARG_BOOL));
+            buffer.push_back(char(value));
+        } else if constexpr (std::is_same_v<T, char>) {
+            putString(buffer, std::string_view(&value, 1));
+        } else if constexpr (std::is_enum_v<T>) {
+            encodeArg(buffer, static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            buffer.push_back(char(ARG_INT));
+            putInt(buffer, std::uint64_t(std::int64_t(value)), 8);
+        } else if constexpr (std::is_integral_v<T>) {
+            buffer.push_back(char(ARG_UINT));
+            putInt(buffer, std::uint64_t(value), 8);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            buffer.push_back(char(ARG_DOUBLE));
+            putInt(buffer, std::bit_cast<std::uint64_t>(double(value)), 8);
+        } else if constexpr (std::is_constructible_v<std::string_view, T>) {
+            putString(buffer, std::string_view(value));
+        } else if constexpr (std::is_base_of_v<AString, T>) {
+            putString(buffer, value.toStdString());
+        } else {
+            std::ostringstream stream;
+            stream << value;
+            putString(buffer, stream.str());
+        }
+    }
+};
+
+/**
+ * @brief Writes an entry to ABinaryLogger. The arguments are not evaluated if the entry is filtered out.
+ * @param logger ABinaryLogger instance
+ * @param level DEBUG, INFO, WARN or ERR
+ * @param tag tag
+ * @param ... format string followed by arguments
+ */
+#define ALOG_BINARY(logger, level, tag, ...) \
+    do { \
+        if (ALogger::isCompiledIn(ALogger::level) && (logger).isEnabled(ALogger::level)) { \
+            (logger).log(ALogger::level, tag, __VA_ARGS__); \
+        } \
+    } while (0)
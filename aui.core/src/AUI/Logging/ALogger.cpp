@@ -15,7 +15,12 @@
 // License along with this library. If not, see <http://www.gnu.org/licenses/>.
 
 #include "ALogger.h"
+#include <AUI/Common/AUtf8String.h>
 #include "AUI/Platform/AProcess.h"
+#include <bit>
+#include <condition_variable>
+#include <thread>
+#include <AUI/Thread/AConditionVariable.h>
 
 #if AUI_PLATFORM_ANDROID
 #include <android/log.h>
@@ -25,6 +30,267 @@
 
 #endif
 
+namespace {
+    /**
+     * @brief Per-thread cache of the formatted entry parts which rarely change.
+     */
+    struct ThreadCache {
+        std::time_t time = -1;
+        char formattedTime[16] = {};
+
+        AString threadName;
+        std::string threadNameUtf8;
+        bool hasThreadName = false;
+
+        /**
+         * @brief Reused buffer for the formatted entry.
+         */
+        std::string line;
+
+        std::string_view formattedTimeNow() {
+            auto now = std::time(nullptr);
+            if (now != time) {
+                time = now;
+                std::strftime(formattedTime, sizeof(formattedTime), "%H:%M:%S", localtime(&now));
+            }
+            return formattedTime;
+        }
+
+        std::string_view currentThreadName() {
+            if (auto currentThread = AThread::current()) {
+                if (!hasThreadName || currentThread->threadName() != threadName) {
+                    threadName = currentThread->threadName();
+                    threadNameUtf8 = threadName.toStdString();
+                    hasThreadName = true;
+                }
+                return threadNameUtf8;
+            }
+            return "?";
+        }
+    };
+
+    ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    std::atomic_uint64_t gAsyncWriterId = 0;
+}
+
+/**
+ * @brief Backend of the asynchronous mode.
+ * @details
+ * Each logging thread owns a single producer single consumer ring buffer of formatted entries. The writer thread (or a
+ * thread calling ALogger::flush) drains the buffers of all threads and writes the entries to the outputs in one batch.
+ */
+struct ALogger::AsyncWriter {
+    struct Ring {
+        AVector<char> data;
+        std::size_t mask;
+
+        /**
+         * @brief Written by the producer only. Advanced after the whole entry is copied.
+         */
+        alignas(64) std::atomic_size_t head = 0;
+
+        /**
+         * @brief Written by the consumer only.
+         */
+        alignas(64) std::atomic_size_t tail = 0;
+
+        /**
+         * @brief The producer is writing to the ring. The writer waits for it to be false when the asynchronous mode
+         * is being disabled.
+         */
+        std::atomic_bool busy = false;
+
+        explicit Ring(std::size_t capacity): data(capacity), mask(capacity - 1) {}
+    };
+
+    ALogger& logger;
+
+    /**
+     * @brief Identifies the rings of the current start() call in the thread local caches of the producers.
+     */
+    std::atomic_uint64_t id = 0;
+    AsyncParams params;
+    std::atomic_bool active = false;
+    std::atomic_bool wakeup = false;
+    std::atomic_size_t dropped = 0;
+
+    AMutex ringsSync;
+    AVector<_<Ring>> rings;
+
+    /**
+     * @brief Makes the consumer single.
+     */
+    AMutex drainSync;
+
+    AMutex threadSync;
+    std::condition_variable_any cv;
+    bool stop = false;
+    std::thread thread;
+
+    explicit AsyncWriter(ALogger& logger): logger(logger) {}
+
+    void start(AsyncParams p) {
+        params = p;
+        {
+            // the rings were drained by shutdown(); new ones are sized with the new params
+            std::unique_lock lock(ringsSync);
+            rings.clear();
+        }
+        id = ++gAsyncWriterId;
+        stop = false;
+        active = true;
+        thread = std::thread([this] {
+            std::unique_lock lock(threadSync);
+            while (!stop) {
+                cv.wait_for(lock, params.flushInterval, [&] { return stop || wakeup.load(); });
+                wakeup = false;
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        });
+    }
+
+    void shutdown() {
+        active = false;
+        for (;;) {
+            // wait for the producers which have not noticed the deactivation
+            bool busy;
+            {
+                std::unique_lock lock(ringsSync);
+                busy = std::any_of(rings.begin(), rings.end(), [](const _<Ring>& r) { return r->busy.load(); });
+            }
+            if (!busy) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock lock(threadSync);
+            stop = true;
+        }
+        cv.notify_all();
+        thread.join();
+        drain();
+    }
+
+    Ring& ringForCurrentThread() {
+        struct ThreadRing {
+            const AsyncWriter* writer;
+            std::uint64_t id;
+            _<Ring> ring;
+        };
+        thread_local AVector<ThreadRing> threadRings;
+        const auto currentId = id.load();
+        for (const auto& r : threadRings) {
+            if (r.id == currentId) {
+                return *r.ring;
+            }
+        }
+        // forget the ring of the previous start() of this writer
+        threadRings.removeIf([&](const ThreadRing& r) { return r.writer == this; });
+        auto ring = _new<Ring>(std::bit_ceil((std::max)(params.bufferSize, std::size_t(256))));
+        {
+            std::unique_lock lock(ringsSync);
+            rings << ring;
+        }
+        threadRings.push_back({ this, currentId, ring });
+        return *ring;
+    }
+
+    /**
+     * @return false if the entry should be written synchronously.
+     */
+    bool push(std::string_view line) {
+        auto& ring = ringForCurrentThread();
+        if (line.size() > ring.data.size()) {
+            return false;
+        }
+
+        ring.busy = true;
+        ARaiiHelper busyReset = [&] { ring.busy.store(false, std::memory_order_release); };
+        if (!active) {
+            return false;
+        }
+
+        auto head = ring.head.load(std::memory_order_relaxed);
+        while (ring.data.size() - (head - ring.tail.load(std::memory_order_acquire)) < line.size()) {
+            if (params.overflow == AsyncParams::OVERFLOW_DROP) {
+                dropped += 1;
+                return true;
+            }
+            wakeUp();
+            std::this_thread::yield();
+            if (!active) {
+                return false;
+            }
+        }
+
+        auto offset = head & ring.mask;
+        auto firstPart = (std::min)(line.size(), ring.data.size() - offset);
+        std::memcpy(ring.data.data() + offset, line.data(), firstPart);
+        std::memcpy(ring.data.data(), line.data() + firstPart, line.size() - firstPart);
+        ring.head.store(head + line.size(), std::memory_order_release);
+
+        if (head + line.size() - ring.tail.load(std::memory_order_relaxed) >= params.flushThreshold) {
+            wakeUp();
+        }
+        return true;
+    }
+
+    void wakeUp() {
+        if (!wakeup.exchange(true)) {
+            cv.notify_one();
+        }
+    }
+
+    void drain() {
+        std::unique_lock drainLock(drainSync);
+        AVector<_<Ring>> snapshot;
+        {
+            std::unique_lock lock(ringsSync);
+            // forget rings of finished threads
+            rings.removeIf([](const _<Ring>& r) {
+                return r.use_count() == 1 && r->head.load() == r->tail.load();
+            });
+            snapshot = rings;
+        }
+
+        std::unique_lock lock(logger.mLogSync);
+        bool written = false;
+        if (auto d = dropped.exchange(0)) {
+            written = true;
+            auto& cache = threadCache();
+            logger.writeLocked(fmt::format("[{}][Logger][Logger][WARN]: {} entries dropped due to buffer overflow\n",
+                                           cache.formattedTimeNow(), d));
+        }
+        for (const auto& ring : snapshot) {
+            auto tail = ring->tail.load(std::memory_order_relaxed);
+            auto head = ring->head.load(std::memory_order_acquire);
+            if (head == tail) {
+                continue;
+            }
+            auto offset = tail & ring->mask;
+            auto size = head - tail;
+            auto firstPart = (std::min)(size, ring->data.size() - offset);
+            logger.writeLocked({ ring->data.data() + offset, firstPart });
+            if (firstPart != size) {
+                logger.writeLocked({ ring->data.data(), size - firstPart });
+            }
+            ring->tail.store(head, std::memory_order_release);
+            written = true;
+        }
+        if (written) {
+            fflush(stdout);
+            if (logger.mLogFile) fflush(logger.mLogFile->nativeHandle());
+        }
+    }
+};
+
 ALogger::ALogger()
 {
 #ifdef AUI_SHARED_PTR_FIND_INSTANCES
@@ -34,6 +300,10 @@ ALogger::ALogger()
 #endif
 }
 
+ALogger::ALogger(AString filename) {
+    setLogFileImpl(std::move(filename));
+}
+
 static ALogger& globalImpl(AOptional<APath> path = std::nullopt) {
     static ALogger l(std::move(path.valueOr(APath::getDefaultPath(APath::TEMP).makeDirs() / "aui.{}.log"_format(AProcess::self()->getPid()))));
     return l;
@@ -48,6 +318,10 @@ void ALogger::setLogFileForGlobal(APath path) {
     globalImpl(std::move(path));
 }
 
+ALogger::Tag::Tag(const AString& string): mValue(string.toStdString()) {}
+
+ALogger::Tag::Tag(const AUtf8String& utf8): mValue(utf8.toStdString()) {}
+
 void ALogger::log(Level level, std::string_view prefix, std::string_view message)
 {
     {
@@ -101,27 +375,25 @@ void ALogger::log(Level level, std::string_view prefix, std::string_view message
         break;
     }
 
-    std::time_t t = std::time(nullptr);
-    std::tm* tm;
-    tm = localtime(&t);
-    char timebuf[64];
-    std::strftime(timebuf, sizeof(timebuf), "%H:%M:%S", tm);
-
-    std::string threadName;
-    if (auto currentThread = AThread::current()) {
-        threadName = currentThread->threadName().toStdString();
+    auto& cache = threadCache();
+    auto& line = cache.line;
+    line.clear();
+    if (message.length() == 0) {
+        fmt::format_to(std::back_inserter(line), "[{}][{}][{}]: {}\n",
+                       cache.formattedTimeNow(), cache.currentThreadName(), levelName, prefix);
     } else {
-        threadName = "?";
+        fmt::format_to(std::back_inserter(line), "[{}][{}][{}][{}]: {}\n",
+                       cache.formattedTimeNow(), cache.currentThreadName(), prefix, levelName, message);
     }
 
-    std::unique_lock lock(mLogSync);
-    if (message.length() == 0) {
-        printf("[%s][%s][%s]: %s\n", timebuf, threadName.c_str(), levelName, prefix.data());
-        if (mLogFile) fprintf(mLogFile->nativeHandle(), "[%s][%s[%s]: %s\n", timebuf, threadName.c_str(), levelName, prefix.data());
-    } else {
-        printf("[%s][%s][%s][%s]: %s\n", timebuf, threadName.c_str(), prefix.data(), levelName, message.data());
-        if (mLogFile) fprintf(mLogFile->nativeHandle(), "[%s][%s][%s][%s]: %s\n", timebuf, threadName.c_str(), prefix.data(), levelName, message.data());
+    if (auto asyncWriter = mAsyncWriter.load(std::memory_order_acquire)) {
+        if (asyncWriter->push(line)) {
+            return;
+        }
     }
+
+    std::unique_lock lock(mLogSync);
+    writeLocked(line);
     fflush(stdout);
     if (mLogFile) fflush(mLogFile->nativeHandle());
 #endif
@@ -133,4 +405,37 @@ void ALogger::setLogFileImpl(AString path) {
     log(INFO, "Logger",  ("Log file: " + mLogFile->path()).toStdString());
 }
 
-ALogger::~ALogger() = default;
+void ALogger::writeLocked(std::string_view lines) {
+    fwrite(lines.data(), 1, lines.size(), stdout);
+    if (mLogFile) fwrite(lines.data(), 1, lines.size(), mLogFile->nativeHandle());
+}
+
+void ALogger::setAsync(bool enabled, AsyncParams params) {
+#if !AUI_PLATFORM_ANDROID
+    std::unique_lock lock(mAsyncSync);
+    if (enabled == isAsync()) {
+        return;
+    }
+    if (enabled) {
+        if (!mAsyncWriterStorage) {
+            mAsyncWriterStorage = std::make_unique<AsyncWriter>(*this);
+        }
+        mAsyncWriterStorage->start(params);
+        mAsyncWriter = mAsyncWriterStorage.get();
+    } else {
+        mAsyncWriter = nullptr;
+        mAsyncWriterStorage->shutdown();
+    }
+#endif
+}
+
+
+void ALogger::flush() {
+    if (auto asyncWriter = mAsyncWriter.load()) {
+        asyncWriter->drain();
+    }
+}
+
+ALogger::~ALogger() {
+    setAsync(false);
+}
@@ -25,8 +25,21 @@
 #include <fmt/format.h>
 #include <fmt/chrono.h>
 #include <AUI/Thread/AMutexWrapper.h>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Minimal severity of log entries compiled into the binary: 0 = DEBUG, 1 = INFO, 2 = WARN, 3 = ERR.
+ * @details
+ * Set by the AUI_LOG_MIN_LEVEL CMake option. Entries below this severity written with ALOG_DEBUG, ALOG_INFO, etc...
+ * are eliminated by the compiler along with their arguments.
+ */
+#ifndef AUI_LOG_MIN_LEVEL
+#define AUI_LOG_MIN_LEVEL 0
+#endif
 
 class AString;
+class AUtf8String;
 
 /**
  * @brief A logger class.
@@ -60,6 +73,16 @@ class AString;
  *   }
  * }
  * @endcode
+ *
+ * By default, each entry is written (and flushed) to the console and the log file by the logging thread itself.
+ * Applications logging heavily from multiple threads can switch the logger to the asynchronous mode with
+ * ALogger::setAsync.
+ *
+ * Entries below the minimal level (see ALogger::setMinLevel) are not formatted at all. Use ALOG_DEBUG, ALOG_INFO,
+ * ALOG_WARN and ALOG_ERR macros on hot paths: they do not evaluate the arguments of a filtered out entry and are
+ * removed entirely if the level is below AUI_LOG_MIN_LEVEL.
+ *
+ * For high-frequency logging, consider ABinaryLogger.
  */
 class API_AUI_CORE ALogger final
 {
@@ -72,12 +95,55 @@ public:
         DEBUG,
 	};
 
+    /**
+     * @return severity of the level; DEBUG is the least severe, ERR is the most severe.
+     */
+    static constexpr int severity(Level level) noexcept {
+        switch (level) {
+            case DEBUG: return 0;
+            case INFO:  return 1;
+            case WARN:  return 2;
+            default:    return 3;
+        }
+    }
+
+    /**
+     * @return false if entries of the level are eliminated at compile time by AUI_LOG_MIN_LEVEL.
+     */
+    static constexpr bool isCompiledIn(Level level) noexcept {
+        return severity(level) >= AUI_LOG_MIN_LEVEL;
+    }
+
+
+    /**
+     * @brief Tag of a log entry.
+     * @details
+     * Accepts string literals, `std::string`, AString and AUtf8String. The tag is kept in UTF-8, so string literal tags
+     * are not transcoded.
+     */
+    class API_AUI_CORE Tag {
+    public:
+        Tag(const char* utf8): mValue(utf8) {}
+        Tag(std::string_view utf8): mValue(utf8) {}
+        Tag(std::string utf8) noexcept: mValue(std::move(utf8)) {}
+        Tag(const AString& string);
+        Tag(const AUtf8String& utf8);
+
+        [[nodiscard]]
+        std::string_view view() const noexcept {
+            return mValue;
+        }
+
+    private:
+        std::string mValue;
+    };
 
     struct LogWriter {
         private:
             ALogger& mLogger;
             Level mLevel;
-            AString mPrefix;
+            bool mEnabled;
+            Tag mPrefix;
             struct Buffer {
             private:
                 struct StackBuffer {
@@ -134,13 +200,13 @@ public:
 
                 [[nodiscard]]
                 std::string_view str() const {
-                    // assuming there's a null terminator
+                    // assuming there's a null terminator; it is not a part of the string
                     if (std::holds_alternative<StackBuffer>(mBuffer)) {
                         auto& stack = std::get<StackBuffer>(mBuffer);
                         return {stack.buffer, static_cast<std::string_view::size_type>(stack.currentIterator - stack.buffer) - 1};
                     }
                     auto& h = std::get<HeapBuffer>(mBuffer);
-                    return {h.data(), h.size()};
+                    return {h.data(), h.size() - 1};
                 }
             };
 
@@ -170,21 +236,28 @@ public:
             }
 
         public:
-            LogWriter(ALogger& logger, Level level, AString prefix) :
+            LogWriter(ALogger& logger, Level level, Tag prefix) :
                 mLogger(logger),
                 mLevel(level),
+                mEnabled(logger.isEnabled(level)),
                 mPrefix(std::move(prefix)) {
 
             }
 
             ~LogWriter() {
+                if (!mEnabled) {
+                    return;
+                }
                 mBuffer.write(0); // null terminator
                 auto s = mBuffer.str();
-                mLogger.log(mLevel, mPrefix.toStdString().c_str(), s);
+                mLogger.log(mLevel, mPrefix.view(), s);
             }
 
             template<typename T>
             LogWriter& operator<<(const T& t) noexcept {
+                if (!mEnabled) {
+                    return *this;
+                }
                 // avoid usage of std::ostream because it's expensive
                 if constexpr(std::is_constructible_v<std::string_view, T>) {
                     std::string_view stringView(t);
@@ -214,9 +287,7 @@ public:
      * @details
      * For the global logger, use ALogger::info, ALogger::warn, etc...
      */
-    ALogger(AString filename) {
-        setLogFileImpl(std::move(filename));
-    }
+    ALogger(AString filename);
 
     ~ALogger();
 
@@ -229,6 +300,26 @@ public:
         return global().mDebug;
     }
 
+    /**
+     * @brief Sets the minimal level of entries to be written.
+     * @details
+     * Entries of less severe levels are dropped before formatting. The default minimal level is DEBUG, i.e. all
+     * entries are written.
+     *
+     * Unlike AUI_LOG_MIN_LEVEL, the filter is applied at runtime.
+     */
+    void setMinLevel(Level level) noexcept {
+        mMinSeverity.store(severity(level), std::memory_order_relaxed);
+    }
+
+    /**
+     * @return true if entries of the level are written by this logger.
+     */
+    [[nodiscard]]
+    bool isEnabled(Level level) const noexcept {
+        return isCompiledIn(level) && severity(level) >= mMinSeverity.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Sets log file.
      * @param path path to the log file.
@@ -254,6 +345,72 @@ public:
         return mLogFile.valueOrException().path();
     }
 
+    /**
+     * @brief Parameters of the asynchronous mode.
+     * @see ALogger::setAsync
+     */
+    struct AsyncParams {
+        /**
+         * @brief Capacity of a per-thread buffer, in bytes. Rounded up to a power of two.
+         */
+        std::size_t bufferSize = 64 * 1024;
+
+        /**
+         * @brief Amount of pending bytes in a thread's buffer which wakes up the writer thread before flushInterval.
+         */
+        std::size_t flushThreshold = 16 * 1024;
+
+        /**
+         * @brief Maximal delay between logging an entry and writing it.
+         */
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100);
+
+        /**
+         * @brief What to do when the thread's buffer is full.
+         */
+        enum {
+            /**
+             * @brief Wait until the writer thread frees the buffer.
+             */
+            OVERFLOW_BLOCK,
+
+            /**
+             * @brief Drop the entry. The number of dropped entries is logged by the writer thread.
+             */
+            OVERFLOW_DROP,
+        } overflow = OVERFLOW_BLOCK;
+    };
+
+    /**
+     * @brief Enables or disables the asynchronous mode.
+     * @param enabled true to enable.
+     * @param params parameters of the asynchronous mode. Applied when the asynchronous mode is enabled.
+     * @details
+     * In the asynchronous mode, a logging thread only formats the entry and puts it to its own lock-free buffer.
+     * A background writer thread takes the entries from all threads' buffers and writes them to the console and the
+     * log file in batches, flushing once per batch. Entries of a single thread keep their order; entries of different
+     * threads may be slightly reordered.
+     *
+     * onLogged callback is still called by the logging thread.
+     *
+     * Disabling the asynchronous mode writes all pending entries.
+     */
+    void setAsync(bool enabled, AsyncParams params);
+
+    void setAsync(bool enabled) {
+        setAsync(enabled, AsyncParams());
+    }
+
+    [[nodiscard]]
+    bool isAsync() const noexcept {
+        return mAsyncWriter.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /**
+     * @brief Writes all entries pending in the asynchronous mode.
+     */
+    void flush();
+
     void onLogged(std::function<void(const AString& prefix, const AString& message, Level level)> callback) {
         std::unique_lock lock(mOnLogged);
         mOnLogged = std::move(callback);
@@ -287,21 +444,21 @@ public:
         action();
     }
 
-    static LogWriter info(const AString& str)
+    static LogWriter info(Tag str)
     {
-        return {global(), INFO, str};
+        return {global(), INFO, std::move(str)};
     }
-    static LogWriter warn(const AString& str)
+    static LogWriter warn(Tag str)
     {
-        return {global(), WARN, str};
+        return {global(), WARN, std::move(str)};
     }
-    static LogWriter err(const AString& str)
+    static LogWriter err(Tag str)
     {
-        return {global(), ERR, str};
+        return {global(), ERR, std::move(str)};
     }
-    static LogWriter debug(const AString& str)
+    static LogWriter debug(Tag str)
     {
-        return {global(), DEBUG, str};
+        return {global(), DEBUG, std::move(str)};
     }
 
     /**
@@ -309,20 +466,35 @@ public:
      * @param level level
      * @param prefix prefix
      */
-    LogWriter log(Level level, const AString& prefix)
+    LogWriter log(Level level, Tag prefix)
     {
-        return {*this, level, prefix};
+        return {*this, level, std::move(prefix)};
     }
 
 
 private:
+    struct AsyncWriter;
+
 	ALogger();
 
     AOptional<AFileOutputStream> mLogFile;
     AMutex mLogSync;
+
+    /**
+     * @brief Active asynchronous writer; nullptr if the asynchronous mode is disabled.
+     */
+    std::atomic<AsyncWriter*> mAsyncWriter = nullptr;
+    AMutex mAsyncSync;
+
+    /**
+     * @brief Owns the asynchronous writer. It is kept when the asynchronous mode is disabled so the threads' buffers
+     * can be reused.
+     */
+    _unique<AsyncWriter> mAsyncWriterStorage;
     AMutexWrapper<std::function<void(const AString& prefix, const AString& message, Level level)>> mOnLogged;
 
     bool mDebug = true;
+    std::atomic_int mMinSeverity = 0;
 
     void setLogFileImpl(AString path);
 
@@ -335,6 +507,11 @@ private:
      */
     void log(Level level, std::string_view prefix, std::string_view message);
 
+    /**
+     * @brief Writes formatted entries to the console and the log file. mLogSync must be locked.
+     */
+    void writeLocked(std::string_view lines);
+
 };
 
 template<std::size_t L, typename T, glm::qualifier Q>
@@ -349,6 +526,30 @@ inline std::ostream& operator<<(std::ostream& o, glm::vec<L, T, Q> vec) {
     return o;
 }
 
-#define ALOG_DEBUG(str) if (ALogger::global().isDebug()) ALogger::debug(str)
+#define AUI_IMPL_LOG_IF(level) if (ALogger::isCompiledIn(ALogger::level) && ALogger::global().isEnabled(ALogger::level))
+
+/**
+ * @brief Writes a debug entry to the global logger; neither the tag nor the streamed values are evaluated if the entry
+ * is filtered out.
+ * @code{cpp}
+ * ALOG_DEBUG(LOG_TAG) << "Downloaded " << bytes << " bytes";
+ * @endcode
+ */
+#define ALOG_DEBUG(str) AUI_IMPL_LOG_IF(DEBUG) if (ALogger::global().isDebug()) ALogger::debug(str)
+
+/**
+ * @brief Same as ALOG_DEBUG, but for ALogger::INFO.
+ */
+#define ALOG_INFO(str) AUI_IMPL_LOG_IF(INFO) ALogger::info(str)
+
+/**
+ * @brief Same as ALOG_DEBUG, but for ALogger::WARN.
+ */
+#define ALOG_WARN(str) AUI_IMPL_LOG_IF(WARN) ALogger::warn(str)
+
+/**
+ * @brief Same as ALOG_DEBUG, but for ALogger::ERR.
+ */
+#define ALOG_ERR(str) AUI_IMPL_LOG_IF(ERR) ALogger::err(str)
 
 #include <AUI/Traits/strings.h>
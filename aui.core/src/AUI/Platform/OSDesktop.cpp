@@ -41,29 +41,33 @@ protected:
     void processMessagesImpl() override {
         assert(("AAbstractThread::processMessages() should not be called from other thread",
                 mId == std::this_thread::get_id()));
-        std::unique_lock lock(mQueueLock, std::defer_lock);
-
         using namespace std::chrono;
         using namespace std::chrono_literals;
 
-        for (std::size_t i = 0; i < 10 && !mMessageQueue.empty() && lock.try_lock(); ++i)
+        mMessageQueue.popAll(mPendingMessages);
+        for (std::size_t i = 0; i < 10 && !mPendingMessages.empty(); ++i)
         {
-            auto f = std::move(mMessageQueue.front());
-            mMessageQueue.pop_front();
-            lock.unlock();
+            auto f = std::move(mPendingMessages.front());
+            mPendingMessages.pop_front();
             auto time = util::measureExecutionTime<microseconds>(f.proc);
 
             if (time >= 1ms) {
+#if AUI_MESSAGE_ORIGIN_TRACING
                 ALogger::warn("Performance")
                     << "Execution of a task took " << time.count() << "us to execute which may cause UI lag.\n"
                     << f.stacktrace
                     << " - ...\n";
+#else
+                ALogger::warn("Performance")
+                    << "Execution of a task took " << time.count() << "us to execute which may cause UI lag. "
+                    << "Build AUI with AUI_MESSAGE_ORIGIN_TRACING=ON to find out the task's origin.";
+#endif
             }
         }
 
         {
             static std::size_t prevRecord = 1;
-            auto currentSize = mMessageQueue.size();
+            auto currentSize = mPendingMessages.size() + mMessageQueue.size();
             if (auto r = currentSize / 10000; r > prevRecord) {
                 prevRecord = r;
                 ALogger::warn("Performance") << currentSize << " tasks for UI thread?";
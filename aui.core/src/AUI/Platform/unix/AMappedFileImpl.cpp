@@ -0,0 +1,81 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <AUI/IO/AMappedFile.h>
+#include <AUI/Platform/ErrorToException.h>
+
+AMappedFile::AMappedFile(const APath& path, Mode mode): mMode(mode) {
+    int fd = ::open(path.toStdString().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        aui::impl::unix_based::lastErrorToException("unable to open {}"_format(path));
+    }
+    struct stat s;
+    if (fstat(fd, &s) != 0) {
+        ::close(fd);
+        aui::impl::unix_based::lastErrorToException("unable to stat {}"_format(path));
+    }
+    mSize = std::size_t(s.st_size);
+    if (mSize == 0) {
+        // empty files can't be mapped
+        ::close(fd);
+        return;
+    }
+    void* data = mmap(nullptr, mSize,
+                      mode == Mode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+
+    // the mapping holds its own reference to the file
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        mSize = 0;
+        aui::impl::unix_based::lastErrorToException("unable to map {}"_format(path));
+    }
+    mData = static_cast<char*>(data);
+}
+
+void AMappedFile::unmap() noexcept {
+    if (mData) {
+        munmap(mData, mSize);
+        mData = nullptr;
+    }
+}
+
+void AMappedFile::advise(Access access, std::size_t offset, std::size_t size) noexcept {
+    if (!mData || offset >= mSize) {
+        return;
+    }
+    size = std::min(size, mSize - offset);
+
+    // madvise requires a page aligned address
+    static const auto pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+    auto alignment = offset % pageSize;
+    offset -= alignment;
+    size += alignment;
+
+    int advice = [&] {
+        switch (access) {
+            case Access::SEQUENTIAL: return MADV_SEQUENTIAL;
+            case Access::RANDOM: return MADV_RANDOM;
+            case Access::WILL_NEED: return MADV_WILLNEED;
+            default: return MADV_NORMAL;
+        }
+    }();
+    madvise(mData + offset, size, advice);
+}
@@ -0,0 +1,67 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Windows.h>
+#include <AUI/IO/AMappedFile.h>
+#include <AUI/Platform/ErrorToException.h>
+
+AMappedFile::AMappedFile(const APath& path, Mode mode): mMode(mode) {
+    HANDLE file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        aui::impl::lastErrorToException("unable to open {}"_format(path));
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        aui::impl::lastErrorToException("unable to get size of {}"_format(path));
+    }
+    mSize = std::size_t(size.QuadPart);
+    if (mSize == 0) {
+        // empty files can't be mapped
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMapping(file, nullptr, mode == Mode::READ_ONLY ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0,
+                                       nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        mSize = 0;
+        aui::impl::lastErrorToException("unable to map {}"_format(path));
+    }
+    void* data = MapViewOfFile(mapping, mode == Mode::READ_ONLY ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+
+    // the view holds its own reference to the mapping
+    CloseHandle(mapping);
+    if (!data) {
+        mSize = 0;
+        aui::impl::lastErrorToException("unable to map {}"_format(path));
+    }
+    mData = static_cast<char*>(data);
+}
+
+void AMappedFile::unmap() noexcept {
+    if (mData) {
+        UnmapViewOfFile(mData);
+        mData = nullptr;
+    }
+}
+
+void AMappedFile::advise(Access access, std::size_t offset, std::size_t size) noexcept {
+    // windows 7 has no access pattern hints for the mapped views (PrefetchVirtualMemory appeared in windows 8); the
+    // hints are optional, so ignore them
+}
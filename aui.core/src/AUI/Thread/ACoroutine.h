@@ -0,0 +1,277 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <coroutine>
+#include <AUI/Thread/AFuture.h>
+#include <AUI/Thread/AThreadPool.h>
+#include <AUI/Common/ATimer.h>
+
+/**
+ * @defgroup coroutines Coroutines
+ * @ingroup core
+ * @brief C++20 coroutine support.
+ * @details
+ * A function returning AFuture<T> can be a coroutine: it may <code>co_await</code> other AFutures, hop between threads
+ * with aui::co::resumeOn and wait for timers with aui::co::delay. Suspended coroutines do not occupy any thread.
+ *
+ * @code{cpp}
+ * AFuture<int> fetchLength(AString url) {
+ *     AString page = co_await (async { return download(url); });
+ *     co_await aui::co::delay(100ms);
+ *     co_return page.length();
+ * }
+ * @endcode
+ *
+ * The coroutine starts executing immediately on the calling thread. After a <code>co_await</code> it is resumed on
+ * the awaiting thread if the thread runs an event loop (i.e. UI thread), or on AThreadPool::global() otherwise.
+ *
+ * As with any other AFuture, destruction of all AFuture instances of the coroutine cancels it: the suspended
+ * coroutine is destroyed instead of being resumed, releasing (and thus cancelling) the AFuture it awaits. Keep the
+ * AFuture in AAsyncHolder to run the coroutine in background.
+ *
+ * If the awaited AFuture is cancelled (see AFuture::cancel) or its task is interrupted, <code>co_await</code> throws
+ * AInvocationTargetException.
+ */
+
+namespace aui::impl::future {
+    /**
+     * @brief Executor the coroutine is resumed on.
+     */
+    struct CoroutineExecutor {
+        AThreadPool* pool = nullptr;
+        _<AAbstractThread> thread;
+
+        /**
+         * @return the current thread if it runs an event loop, AThreadPool::global() otherwise.
+         */
+        static CoroutineExecutor current() {
+            auto thread = AThread::current();
+            if (thread->getCurrentEventLoop() != nullptr) {
+                return { nullptr, std::move(thread) };
+            }
+            return { &AThreadPool::global(), nullptr };
+        }
+
+        /**
+         * @brief Resumes the coroutine on the executor, or destroys it if its AFuture is not referenced anymore.
+         */
+        template<typename Promise>
+        void resume(std::coroutine_handle<Promise> handle) const {
+            std::function<void()> task = [handle] {
+                if constexpr (requires { handle.promise().isAbandoned(); }) {
+                    if (handle.promise().isAbandoned()) {
+                        handle.destroy();
+                        return;
+                    }
+                }
+                handle.resume();
+            };
+            if (thread) {
+                post(*thread, std::move(task));
+            } else {
+                post(*pool, std::move(task));
+            }
+        }
+    };
+
+    template<typename T>
+    struct PromiseBase {
+        /**
+         * @brief The returned AFuture; the coroutine does not keep it alive.
+         */
+        InnerWeak<T> result;
+
+        AFuture<T> get_return_object() {
+            AFuture<T> future;
+            result = future.inner();
+            return future;
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void unhandled_exception() noexcept {
+            if (auto wrapper = result.lock()) {
+                wrapper->ptr()->reportException();
+            }
+        }
+
+        [[nodiscard]]
+        bool isAbandoned() const noexcept {
+            return result.expired();
+        }
+    };
+
+    template<typename T>
+    struct Promise: PromiseBase<T> {
+        void return_value(T value) {
+            supply<T>(this->result, [&] { return std::move(value); });
+        }
+    };
+
+    template<>
+    struct Promise<void>: PromiseBase<void> {
+        void return_void() {
+            supply<void>(result, [] {});
+        }
+    };
+
+    template<typename T>
+    struct FutureAwaiter {
+        AFuture<T> future;
+
+        bool await_ready() const noexcept {
+            return future.hasResult();
+        }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) {
+            /*
+             * A single callback for the value, the exception and the interruption. Once it is registered, another
+             * thread may resume the coroutine and destroy its frame (including this awaiter), so the awaiter is not
+             * accessed after that.
+             */
+            auto inner = future.inner();
+            (*inner)->addCallback([executor = CoroutineExecutor::current(), handle](auto&) {
+                executor.resume(handle);
+            });
+        }
+
+        T await_resume() {
+            if constexpr (std::is_void_v<T>) {
+                future.get();
+            } else {
+                return *future;
+            }
+        }
+    };
+}
+
+template<typename T, typename... Args>
+struct std::coroutine_traits<AFuture<T>, Args...> {
+    using promise_type = aui::impl::future::Promise<T>;
+};
+
+/**
+ * @brief Suspends the coroutine until the AFuture is completed.
+ * @ingroup coroutines
+ * @return value of the AFuture. Throws AInvocationTargetException if the AFuture has failed, was cancelled or
+ *         interrupted.
+ */
+template<typename T>
+aui::impl::future::FutureAwaiter<T> operator co_await(AFuture<T> future) {
+    return { std::move(future) };
+}
+
+namespace aui::co {
+    /**
+     * @brief Awaitable moving the coroutine to an executor.
+     * @see aui::co::resumeOn
+     */
+    struct ResumeOn {
+        aui::impl::future::CoroutineExecutor executor;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) const {
+            executor.resume(handle);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Awaitable resuming the coroutine after a timeout.
+     * @see aui::co::delay
+     */
+    template<typename Duration>
+    struct Delay {
+        AScheduler& scheduler;
+        Duration timeout;
+
+        bool await_ready() const noexcept {
+            return timeout <= Duration::zero();
+        }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) const {
+            // the coroutine is not resumed on the scheduler's thread in order to not delay other timers
+            scheduler.enqueue(timeout, [executor = aui::impl::future::CoroutineExecutor::current(), handle] {
+                executor.resume(handle);
+            });
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Continues the coroutine on a thread of the thread pool.
+     * @ingroup coroutines
+     * @code{cpp}
+     * co_await aui::co::resumeOn(AThreadPool::global());
+     * @endcode
+     */
+    inline ResumeOn resumeOn(AThreadPool& pool) {
+        return { { &pool, nullptr } };
+    }
+
+    /**
+     * @brief Continues the coroutine on the thread (i.e. UI thread). The thread should process its messages.
+     * @ingroup coroutines
+     * @code{cpp}
+     * co_await aui::co::resumeOn(view->getThread());
+     * @endcode
+     */
+    inline ResumeOn resumeOn(_<AAbstractThread> thread) {
+        return { { nullptr, std::move(thread) } };
+    }
+
+    /**
+     * @brief Suspends the coroutine for the specified time, driven by the scheduler.
+     * @ingroup coroutines
+     * @details
+     * The scheduler's thread (the thread calling AScheduler::loop()) only wakes the coroutine up; the coroutine is
+     * resumed as after co_await on AFuture.
+     */
+    template<typename Duration>
+    Delay<Duration> delay(AScheduler& scheduler, Duration timeout) {
+        return { scheduler, timeout };
+    }
+
+    /**
+     * @brief Suspends the coroutine for the specified time, driven by the ATimer's scheduler.
+     * @ingroup coroutines
+     * @code{cpp}
+     * co_await aui::co::delay(500ms);
+     * @endcode
+     */
+    template<typename Duration>
+    Delay<Duration> delay(Duration timeout) {
+        ATimer::timerThread();
+        return { ATimer::scheduler(), timeout };
+    }
+}
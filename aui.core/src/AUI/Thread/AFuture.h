@@ -19,14 +19,21 @@
 #include <atomic>
 #include <functional>
 #include <optional>
+#include <utility>
 #include "AConditionVariable.h"
 #include "AMutex.h"
 #include <AUI/Common/SharedPtrTypes.h>
+#include <AUI/Common/AOptional.h>
+#include <AUI/Common/AVector.h>
 #include <AUI/Common/AString.h>
 #include <AUI/Common/AException.h>
 #include <AUI/Reflect/AReflect.h>
 
 class AThreadPool;
+class AAbstractThread;
+
+template<typename T>
+class AFuture;
 
 
 class AInvocationTargetException: public AException {
@@ -116,17 +123,110 @@ namespace aui::impl::future {
             AMutex mutex;
             AConditionVariable cv;
             TaskCallback task;
-            OnSuccessCallback onSuccess;
-            std::function<void(const AException& exception)> onError;
             _<AAbstractThread> thread;
             bool cancelled = false;
 
+            /**
+             * @brief Futures (or their shared state) this future is computed from.
+             * @details
+             * Set by AFuture::then, AFuture::all, AFuture::any and AFuture::reduce. Keeps the source futures alive while
+             * this future is alive, so destruction of this future cancels them.
+             */
+            _<void> upstream;
+
+            /**
+             * @brief Callback registered by onSuccess or onError. Called once the result is set.
+             */
+            struct callback_node {
+                callback_node* next = nullptr;
+
+                virtual ~callback_node() = default;
+                virtual void call(Inner& inner) = 0;
+            };
+
+            template<typename F>
+            struct callback_impl final: callback_node {
+                F f;
+
+                explicit callback_impl(F f): f(std::move(f)) {}
+
+                void call(Inner& inner) override {
+                    f(inner);
+                }
+            };
+
+            /**
+             * @brief Registered callbacks, the last registered first; completedMarker() once the result is set.
+             * @details
+             * Registration pushes the callback with a CAS, without locking the mutex. The thread setting the result
+             * takes the whole list with a single exchange and calls the callbacks before waking up the threads waiting
+             * for the result; a callback registered after that is called immediately by the registering thread.
+             */
+            std::atomic<callback_node*> callbacks = nullptr;
+
             explicit Inner(std::function<Value()> task) noexcept: task(std::move(task)) {
                 if constexpr(isVoid) {
                     value = false;
                 }
             }
 
+            ~Inner() {
+                auto head = callbacks.load();
+                while (head != nullptr && head != completedMarker()) {
+                    delete std::exchange(head, head->next);
+                }
+            }
+
+            static callback_node* completedMarker() noexcept {
+                return reinterpret_cast<callback_node*>(alignof(callback_node));
+            }
+
+            /**
+             * @brief Registers the callback accepting Inner&, or calls it if the result is already set.
+             * @details
+             * The callback is called once the value, the exception or the interruption is reported (see cancel()).
+             */
+            template<typename F>
+            void addCallback(F&& f) {
+                auto head = callbacks.load(std::memory_order_acquire);
+                if (head == completedMarker()) {
+                    f(*this);
+                    return;
+                }
+                _unique<callback_node> node = std::make_unique<callback_impl<std::decay_t<F>>>(std::forward<F>(f));
+                do {
+                    if (head == completedMarker()) {
+                        node->call(*this);
+                        return;
+                    }
+                    node->next = head;
+                } while (!callbacks.compare_exchange_weak(head, node.get(), std::memory_order_acq_rel,
+                                                          std::memory_order_acquire));
+                node.release();
+            }
+
+            /**
+             * @brief Calls the registered callbacks in the order of registration. Should be called after the result
+             * is set, before notifying cv.
+             */
+            void runCallbacks() {
+                auto head = callbacks.exchange(completedMarker(), std::memory_order_acq_rel);
+                if (head == completedMarker()) {
+                    return;
+                }
+                callback_node* ordered = nullptr;
+                while (head != nullptr) {
+                    auto next = head->next;
+                    head->next = ordered;
+                    ordered = head;
+                    head = next;
+                }
+                while (ordered != nullptr) {
+                    _unique<callback_node> node(std::exchange(ordered, ordered->next));
+                    node->call(*this);
+                }
+            }
+
             void waitForTask() noexcept {
                 std::unique_lock lock(mutex);
                 bool rethrowInterrupted = false;
@@ -188,9 +288,18 @@ namespace aui::impl::future {
                 std::unique_lock lock(mutex);
                 if (!cancelled) {
                     cancelled = true;
-                    if (thread && !hasResult()) {
+                    if (hasResult()) {
+                        return;
+                    }
+                    if (thread) {
                         thread->interrupt();
+                        return;
                     }
+                    // the task would never be executed; report the interruption so the callbacks waiting for any
+                    // result (i.e. a suspended coroutine) are called.
+                    interrupted = true;
+                    runCallbacks();
+                    cv.notify_all();
                 }
             }
 
@@ -227,22 +336,22 @@ namespace aui::impl::future {
                             if (auto sharedPtrLock = innerWeak.lock()) {
                                 lock.lock();
                                 value = true;
+                                runCallbacks();
                                 cv.notify_all();
-                                notifyOnSuccessCallback();
+                                lock.unlock(); // unlock earlier because destruction of shared_ptr may cause deadlock
 
                                 (void)sharedPtrLock; // sharedPtrLock is *used*
-                                lock.unlock(); // unlock earlier because destruction of shared_ptr may cause deadlock
                             }
                         } else {
                             auto result = func();
                             if (auto sharedPtrLock = innerWeak.lock()) {
                                 lock.lock();
                                 value = std::move(result);
+                                runCallbacks();
                                 cv.notify_all();
-                                notifyOnSuccessCallback();
+                                lock.unlock(); // unlock earlier because destruction of shared_ptr may cause deadlock
 
                                 (void)sharedPtrLock; // sharedPtrLock is *used*
-                                lock.unlock(); // unlock earlier because destruction of shared_ptr may cause deadlock
                             }
                         }
                     } catch (const AException&) {
@@ -263,26 +372,46 @@ namespace aui::impl::future {
             void reportInterrupted() noexcept {
                 std::unique_lock lock(mutex);
                 interrupted = true;
+                runCallbacks();
                 cv.notify_all();
             }
 
             void reportException() noexcept {
                 std::unique_lock lock(mutex);
                 exception.emplace();
+                runCallbacks();
                 cv.notify_all();
-                AUI_NULLSAFE(onError)(*exception);
             }
 
-
-            void notifyOnSuccessCallback() {
-                if (value && onSuccess) {
-                    if constexpr(isVoid) {
-                        onSuccess();
-                    } else {
-                        onSuccess(*value);
-                    }
-                    onSuccess = nullptr;
+            /**
+             * @brief Stores an exception reported by another future.
+             */
+            void forwardException(const AException& e) noexcept {
+                std::unique_lock lock(mutex);
+                if (auto invocationTargetException = dynamic_cast<const AInvocationTargetException*>(&e)) {
+                    exception = *invocationTargetException;
+                } else {
+                    // not reported by a future; keep the message, and the exception being handled (if any) as the
+                    // cause
+                    exception.emplace(e.getMessage());
                 }
+                runCallbacks();
+                cv.notify_all();
+            }
+
+            template<typename V>
+            void supplyValue(V&& v) noexcept {
+                std::unique_lock lock(mutex);
+                value = std::forward<V>(v);
+                runCallbacks();
+                cv.notify_all();
+            }
+
+            void supplyValue() noexcept requires isVoid {
+                std::unique_lock lock(mutex);
+                value = true;
+                runCallbacks();
+                cv.notify_all();
             }
         };
 
@@ -332,52 +461,25 @@ namespace aui::impl::future {
 
         template<typename Callback>
         void onSuccess(Callback&& callback) const noexcept {
-            std::unique_lock lock((*mInner)->mutex);
-            if constexpr(isVoid) {
-                if ((*mInner)->onSuccess) {
-                    (*mInner)->onSuccess = [prev = std::move((*mInner)->onSuccess),
-                            callback = std::forward<Callback>(callback)]() mutable {
-                        prev();
-                        callback();
-                    };
-                } else {
-                    (*mInner)->onSuccess = [callback = std::forward<Callback>(callback)]() mutable {
-                        callback();
-                    };
+            (*mInner)->addCallback([callback = std::forward<Callback>(callback)](Inner& inner) mutable {
+                if (!inner.value) {
+                    return;
                 }
-            } else {
-                if ((*mInner)->onSuccess) {
-                    (*mInner)->onSuccess = [prev = std::move((*mInner)->onSuccess),
-                            callback = std::forward<Callback>(callback)](const Value& v) mutable {
-                        prev(v);
-                        callback(v);
-                    };
+                if constexpr(isVoid) {
+                    callback();
                 } else {
-                    (*mInner)->onSuccess = [callback = std::forward<Callback>(callback)](
-                            const Value& v) mutable {
-                        callback(v);
-                    };
+                    callback(*inner.value);
                 }
-            }
-            (*mInner)->notifyOnSuccessCallback();
+            });
         }
 
         template<aui::invocable<const AException&> Callback>
         void onError(Callback&& callback) const noexcept {
-            std::unique_lock lock((*mInner)->mutex);
-
-            if ((*mInner)->onError) {
-                (*mInner)->onError = [prev = std::move((*mInner)->onError),
-                        callback = std::forward<Callback>(callback)](const AException& v) {
-                    prev(v);
-                    callback(v);
-                };
-            } else {
-                (*mInner)->onError = [callback = std::forward<Callback>(callback)](
-                        const AException& v) {
-                    callback(v);
-                };
-            }
+            (*mInner)->addCallback([callback = std::forward<Callback>(callback)](Inner& inner) mutable {
+                if (inner.exception) {
+                    callback(*inner.exception);
+                }
+            });
         }
 
 
@@ -480,6 +582,175 @@ namespace aui::impl::future {
         }
     };
 
+    template<typename Value>
+    using InnerWeak = _weak<CancellationWrapper<typename Future<Value>::Inner>>;
+
+    /**
+     * @brief Executes the continuation task on the executor (AThreadPool or AAbstractThread).
+     */
+    template<typename Executor>
+    void post(Executor& executor, std::function<void()> task) {
+        if constexpr (std::is_base_of_v<AAbstractThread, Executor>) {
+            executor.enqueue(std::move(task));
+        } else {
+            executor.run(std::move(task));
+        }
+    }
+
+    /**
+     * @brief Posts the continuation of AFuture::then.
+     * @param executor _<AAbstractThread>, which is kept alive by the continuation, or pointer to AThreadPool, which
+     *        should outlive the resulting future.
+     * @details
+     * The resulting future is kept alive while posting, so an executor outliving the future is alive as well. If the
+     * resulting future is already destroyed, the continuation is not posted.
+     */
+    template<typename Result, typename ExecutorPtr>
+    void postContinuation(const ExecutorPtr& executor, const InnerWeak<Result>& resultWeak, std::function<void()> task) {
+        if (auto resultLock = resultWeak.lock()) {
+            post(*executor, std::move(task));
+        }
+    }
+
+    /**
+     * @brief Supplies the result of producer to the target future, if the target future is still alive.
+     */
+    template<typename Value, typename Producer>
+    void supply(const InnerWeak<Value>& target, Producer&& producer) {
+        auto wrapper = target.lock();
+        if (!wrapper) {
+            return;
+        }
+        auto& inner = wrapper->ptr();
+        try {
+            if constexpr (std::is_void_v<Value>) {
+                producer();
+                inner->supplyValue();
+            } else {
+                inner->supplyValue(producer());
+            }
+        } catch (const AException&) {
+            inner->reportException();
+        } catch (...) {
+            inner->reportInterrupted();
+            throw;
+        }
+    }
+
+    template<typename Value>
+    void forwardException(const InnerWeak<Value>& target, const AException& e) {
+        if (auto wrapper = target.lock()) {
+            wrapper->ptr()->forwardException(e);
+        }
+    }
+
+    /**
+     * @brief Shared state of AFuture::all, AFuture::any and AFuture::reduce.
+     * @details
+     * The state is owned by the resulting future (see Future::Inner::upstream) along with the source futures. Source
+     * futures report to the state through weak references, so there is no reference cycle and destruction of the
+     * resulting future cancels the sources. The state is advanced with atomics only; each source writes its own
+     * value slot.
+     */
+    template<typename T>
+    struct Combinator {
+        using Slot = std::conditional_t<std::is_void_v<T>, bool, T>;
+
+        AVector<AFuture<T>> sources;
+        AVector<AOptional<Slot>> values;
+        std::atomic_size_t remaining = 0;
+        std::atomic_bool settled = false;
+    };
+
+    /**
+     * @brief Calls onResult(state, index, value) or onError(state, exception) for each source future.
+     * @return state the resulting future should own
+     */
+    template<typename T, typename Range, typename OnResult, typename OnError>
+    _<Combinator<T>> combine(Range&& futures, OnResult onResult, OnError onError) {
+        auto state = _new<Combinator<T>>();
+        for (const auto& future : futures) {
+            state->sources << future;
+        }
+        state->values.resize(state->sources.size());
+        state->remaining = state->sources.size();
+
+        _weak<Combinator<T>> stateWeak = state;
+        for (std::size_t i = 0; i < state->sources.size(); ++i) {
+            const auto& source = state->sources[i];
+            if constexpr (std::is_void_v<T>) {
+                source.onSuccess([stateWeak, i, onResult]() {
+                    if (auto s = stateWeak.lock()) {
+                        onResult(*s, i, true);
+                    }
+                });
+            } else {
+                source.onSuccess([stateWeak, i, onResult](const T& value) {
+                    if (auto s = stateWeak.lock()) {
+                        onResult(*s, i, value);
+                    }
+                });
+            }
+            source.onError([stateWeak, onError](const AException& e) {
+                if (auto s = stateWeak.lock()) {
+                    onError(*s, e);
+                }
+            });
+        }
+        return state;
+    }
+
+    template<typename T, typename Result, typename Range, typename Finish>
+    AFuture<Result> whenAll(Range&& futures, Finish finish) {
+        AFuture<Result> result;
+        InnerWeak<Result> resultWeak = result.inner();
+        auto state = combine<T>(std::forward<Range>(futures),
+                                [resultWeak, finish](Combinator<T>& s, std::size_t index, const auto& value) {
+            s.values[index] = value;
+            if (s.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !s.settled.exchange(true)) {
+                supply<Result>(resultWeak, [&] { return finish(s); });
+            }
+        }, [resultWeak](Combinator<T>& s, const AException& e) {
+            if (!s.settled.exchange(true)) {
+                forwardException<Result>(resultWeak, e);
+            }
+        });
+        if (state->sources.empty()) {
+            supply<Result>(resultWeak, [&] { return finish(*state); });
+        }
+        (*result.inner())->upstream = std::move(state);
+        return result;
+    }
+
+    template<typename T, typename Range>
+    AFuture<T> whenAny(Range&& futures) {
+        AFuture<T> result;
+        InnerWeak<T> resultWeak = result.inner();
+        auto state = combine<T>(std::forward<Range>(futures),
+                                [resultWeak](Combinator<T>& s, std::size_t index, const auto& value) {
+            if (!s.settled.exchange(true)) {
+                if constexpr (std::is_void_v<T>) {
+                    supply<T>(resultWeak, [] {});
+                } else {
+                    supply<T>(resultWeak, [&]() -> const T& { return value; });
+                }
+            }
+        }, [resultWeak](Combinator<T>& s, const AException& e) {
+            // the result fails only if all sources have failed
+            if (s.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !s.settled.exchange(true)) {
+                forwardException<T>(resultWeak, e);
+            }
+        });
+        if (state->sources.empty()) {
+            try {
+                throw AException("AFuture::any: no futures supplied");
+            } catch (...) {
+                result.reportException();
+            }
+        }
+        (*result.inner())->upstream = std::move(state);
+        return result;
+    }
 }
 
 
@@ -545,10 +816,7 @@ public:
         auto& inner = (*super::mInner);
         assert(("task is already provided", inner->task == nullptr));
 
-        std::unique_lock lock(inner->mutex);
-        inner->value = std::move(v);
-        inner->cv.notify_all();
-        AUI_NULLSAFE(inner->onSuccess)(*inner->value);
+        inner->supplyValue(std::move(v));
     }
 
     /**
@@ -637,6 +905,128 @@ public:
         });
         return result;
     }
+
+    /**
+     * @brief Chains a continuation which is executed on the executor when this AFuture receives a value.
+     * @param executor AThreadPool the continuation is executed on. Should outlive the returned future.
+     * @param callback continuation accepting the value of this AFuture.
+     * @return future of the continuation's result.
+     * @details
+     * Unlike map(), the continuation does not occupy the thread supplying the value, and no thread is blocked while
+     * waiting for this AFuture. An exception of this AFuture or of the continuation is passed to the returned future.
+     *
+     * The returned future keeps this AFuture alive; destruction of the returned future cancels this AFuture as well.
+     *
+     * @code{cpp}
+     * AFuture<AString> text = async { return downloadPage(); };
+     * AFuture<size_t> wordCount = text.then(AThreadPool::global(), [](const AString& v) {
+     *     return v.split(' ').size();
+     * });
+     * @endcode
+     */
+    template<typename Executor, aui::invocable<const T&> Callback>
+    auto then(Executor& executor, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback, const T&>> {
+        static_assert(!std::is_base_of_v<AAbstractThread, Executor>,
+                      "pass the thread as _<AAbstractThread>, so the continuation keeps it alive");
+        return thenOn(&executor, std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief Chains a continuation which is executed on the thread when this AFuture receives a value.
+     * @param thread thread the continuation is executed on. Kept alive by the continuation.
+     * @param callback continuation accepting the value of this AFuture.
+     * @return future of the continuation's result.
+     * @details
+     * See AFuture::then(Executor&, Callback&&).
+     *
+     * @code{cpp}
+     * text.then(AThread::current(), [](const AString& v) { ... });
+     * @endcode
+     */
+    template<typename Thread, aui::invocable<const T&> Callback>
+    auto then(_<Thread> thread, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback, const T&>> {
+        return thenOn(std::move(thread), std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief Returns a future which receives values of all futures, in the order of the range.
+     * @param futures range of AFuture<T>.
+     * @details
+     * The returned future fails with the first exception reported by any of the futures. It does not block any
+     * thread; the value is supplied by the thread supplying the last value.
+     *
+     * The returned future keeps the futures alive; its destruction cancels them.
+     */
+    template<typename Range>
+    static AFuture<AVector<T>> all(Range&& futures) {
+        return aui::impl::future::whenAll<T, AVector<T>>(std::forward<Range>(futures),
+                                                         [](aui::impl::future::Combinator<T>& s) {
+            AVector<T> result;
+            result.reserve(s.values.size());
+            for (auto& v : s.values) {
+                result << std::move(*v);
+            }
+            return result;
+        });
+    }
+
+    /**
+     * @brief Returns a future which receives the first value supplied by any of the futures.
+     * @param futures range of AFuture<T>.
+     * @details
+     * The returned future fails only if all of the futures have failed (with the last exception).
+     *
+     * The returned future keeps the futures alive; its destruction cancels them.
+     */
+    template<typename Range>
+    static AFuture<T> any(Range&& futures) {
+        return aui::impl::future::whenAny<T>(std::forward<Range>(futures));
+    }
+
+    /**
+     * @brief Fan-in reduction of the futures' values.
+     * @param futures range of AFuture<T>.
+     * @param init initial accumulator value.
+     * @param op binary operation accepting the accumulator and a value; returns the new accumulator.
+     * @details
+     * The values are folded in the order of the range by the thread supplying the last value, so op does not need
+     * to be thread safe. Exceptions are handled as in AFuture::all.
+     *
+     * @code{cpp}
+     * AVector<AFuture<size_t>> wordCounts = ...;
+     * AFuture<size_t> total = AFuture<size_t>::reduce(wordCounts, size_t(0), std::plus<>{});
+     * @endcode
+     */
+    template<typename Range, typename Accumulator, aui::invocable<Accumulator, const T&> BinaryOp>
+    static AFuture<Accumulator> reduce(Range&& futures, Accumulator init, BinaryOp op) {
+        return aui::impl::future::whenAll<T, Accumulator>(std::forward<Range>(futures),
+                                                          [init = std::move(init), op = std::move(op)]
+                                                          (aui::impl::future::Combinator<T>& s) {
+            auto accumulator = init;
+            for (const auto& v : s.values) {
+                accumulator = op(std::move(accumulator), *v);
+            }
+            return accumulator;
+        });
+    }
+
+private:
+    template<typename ExecutorPtr, typename Callback>
+    auto thenOn(ExecutorPtr executor, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback, const T&>> {
+        using Result = std::invoke_result_t<Callback, const T&>;
+        AFuture<Result> result;
+        aui::impl::future::InnerWeak<Result> resultWeak = result.inner();
+        onSuccess([executor = std::move(executor), resultWeak, callback = std::forward<Callback>(callback)](const T& v) {
+            aui::impl::future::postContinuation<Result>(executor, resultWeak, [resultWeak, callback, v] {
+                aui::impl::future::supply<Result>(resultWeak, [&] { return callback(v); });
+            });
+        });
+        onError([resultWeak](const AException& e) {
+            aui::impl::future::forwardException<Result>(resultWeak, e);
+        });
+        (*result.inner())->upstream = super::mInner;
+        return result;
+    }
 };
 
 template<>
@@ -668,10 +1058,7 @@ public:
         auto& inner = (*super::mInner);
         assert(("task is already provided", inner->task == nullptr));
 
-        std::unique_lock lock(inner->mutex);
-        inner->value = true;
-        inner->cv.notify_all();
-        AUI_NULLSAFE(inner->onSuccess)();
+        inner->supplyValue();
     }
 
     AFuture& operator=(std::nullptr_t) noexcept {
@@ -733,6 +1120,75 @@ public:
         super::onError(std::forward<Callback>(callback));
         return *this;
     }
+
+    /**
+     * @brief Chains a continuation which is executed on the executor when this AFuture is completed.
+     * @param executor AThreadPool the continuation is executed on. Should outlive the returned future.
+     * @param callback continuation.
+     * @return future of the continuation's result.
+     * @details
+     * See AFuture<T>::then.
+     */
+    template<typename Executor, aui::invocable Callback>
+    auto then(Executor& executor, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback>> {
+        static_assert(!std::is_base_of_v<AAbstractThread, Executor>,
+                      "pass the thread as _<AAbstractThread>, so the continuation keeps it alive");
+        return thenOn(&executor, std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief Chains a continuation which is executed on the thread when this AFuture is completed.
+     * @param thread thread the continuation is executed on. Kept alive by the continuation.
+     * @param callback continuation.
+     * @return future of the continuation's result.
+     * @details
+     * See AFuture<T>::then.
+     */
+    template<typename Thread, aui::invocable Callback>
+    auto then(_<Thread> thread, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback>> {
+        return thenOn(std::move(thread), std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief Returns a future which is completed when all of the futures are completed.
+     * @param futures range of AFuture<>.
+     * @details
+     * See AFuture<T>::all.
+     */
+    template<typename Range>
+    static AFuture<> all(Range&& futures) {
+        return aui::impl::future::whenAll<void, void>(std::forward<Range>(futures),
+                                                      [](aui::impl::future::Combinator<void>&) {});
+    }
+
+    /**
+     * @brief Returns a future which is completed when any of the futures is completed.
+     * @param futures range of AFuture<>.
+     * @details
+     * See AFuture<T>::any.
+     */
+    template<typename Range>
+    static AFuture<> any(Range&& futures) {
+        return aui::impl::future::whenAny<void>(std::forward<Range>(futures));
+    }
+
+private:
+    template<typename ExecutorPtr, typename Callback>
+    auto thenOn(ExecutorPtr executor, Callback&& callback) const -> AFuture<std::invoke_result_t<Callback>> {
+        using Result = std::invoke_result_t<Callback>;
+        AFuture<Result> result;
+        aui::impl::future::InnerWeak<Result> resultWeak = result.inner();
+        onSuccess([executor = std::move(executor), resultWeak, callback = std::forward<Callback>(callback)]() {
+            aui::impl::future::postContinuation<Result>(executor, resultWeak, [resultWeak, callback] {
+                aui::impl::future::supply<Result>(resultWeak, [&] { return callback(); });
+            });
+        });
+        onError([resultWeak](const AException& e) {
+            aui::impl::future::forwardException<Result>(resultWeak, e);
+        });
+        (*result.inner())->upstream = super::mInner;
+        return result;
+    }
 };
 
 
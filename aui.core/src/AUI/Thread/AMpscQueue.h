@@ -0,0 +1,112 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <AUI/Traits/values.h>
+
+/**
+ * @brief Lock-free multiple producer single consumer queue.
+ * @ingroup core
+ * @tparam T stored type
+ * @details
+ * Any thread may push() to the queue. Only one thread (the consumer) may call popAll(), which takes all the pushed
+ * values at once with a single atomic operation and passes them in FIFO order.
+ *
+ * Used as a message queue of AAbstractThread.
+ */
+template<typename T>
+class AMpscQueue: public aui::noncopyable {
+public:
+    AMpscQueue() = default;
+
+    ~AMpscQueue() {
+        for (Node* node = mHead.exchange(nullptr, std::memory_order_acquire); node != nullptr;) {
+            delete std::exchange(node, node->next);
+        }
+    }
+
+    /**
+     * @brief Pushes a value to the queue. Thread safe.
+     */
+    void push(T value) {
+        // increment first so size() never underflows when popAll() runs concurrently
+        mSize.fetch_add(1, std::memory_order_relaxed);
+        auto node = new Node{ std::move(value), mHead.load(std::memory_order_relaxed) };
+        while (!mHead.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    AMpscQueue& operator<<(T value) {
+        push(std::move(value));
+        return *this;
+    }
+
+    /**
+     * @brief Moves all pushed values to the back of the destination container in FIFO order. Should be called from the
+     * consumer thread only.
+     * @param destination container with push_back method.
+     * @return count of the popped values.
+     */
+    template<typename Container>
+    std::size_t popAll(Container& destination) {
+        Node* head = mHead.exchange(nullptr, std::memory_order_acquire);
+        if (head == nullptr) {
+            return 0;
+        }
+
+        // the stack holds the most recent value first; reverse it to restore the push order
+        Node* reversed = nullptr;
+        std::size_t count = 0;
+        while (head != nullptr) {
+            auto next = head->next;
+            head->next = reversed;
+            reversed = head;
+            head = next;
+            ++count;
+        }
+        while (reversed != nullptr) {
+            destination.push_back(std::move(reversed->value));
+            delete std::exchange(reversed, reversed->next);
+        }
+        mSize.fetch_sub(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    /**
+     * @return approximate count of values in the queue.
+     */
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return mSize.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return mHead.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> mHead = nullptr;
+    std::atomic_size_t mSize = 0;
+};
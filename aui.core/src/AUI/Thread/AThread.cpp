@@ -169,10 +169,11 @@ void AThread::join()
 
 void AAbstractThread::enqueue(std::function<void()> f)
 {
-	{
-		std::unique_lock lock(mQueueLock);
-		mMessageQueue << Message{ AStacktrace::capture(2, 4), std::move(f) };
-	}
+#if AUI_MESSAGE_ORIGIN_TRACING
+	mMessageQueue << Message{ AStacktrace::capture(2, 4), std::move(f) };
+#else
+	mMessageQueue << Message{ std::move(f) };
+#endif
 	{
 		if (mCurrentEventLoop) {
 			std::unique_lock lock(mEventLoopLock);
@@ -188,14 +189,16 @@ void AAbstractThread::processMessagesImpl()
 {
     assert(("AAbstractThread::processMessages() should not be called from other thread",
             mId == std::this_thread::get_id()));
-	std::unique_lock lock(mQueueLock);
-	while (!mMessageQueue.empty())
+	mMessageQueue.popAll(mPendingMessages);
+	while (!mPendingMessages.empty())
 	{
-        auto f = std::move(mMessageQueue.front());
-		mMessageQueue.pop_front();
-		lock.unlock();
+        auto f = std::move(mPendingMessages.front());
+		mPendingMessages.pop_front();
 		f.proc();
-		lock.lock();
+        if (mPendingMessages.empty()) {
+            // take the messages pushed while we were processing the batch
+            mMessageQueue.popAll(mPendingMessages);
+        }
 	}
 }
 
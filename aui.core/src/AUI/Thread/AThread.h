@@ -19,6 +19,7 @@
 #include <utility>
 #include "AUI/Common/ADeque.h"
 #include "AMutex.h"
+#include "AMpscQueue.h"
 #include "AUI/Common/SharedPtrTypes.h"
 #include "AUI/Common/AString.h"
 #include <AUI/Platform/AStacktrace.h>
@@ -123,20 +124,28 @@ protected:
 
     AString mThreadName;
 
-    /**
-     * @brief Message queue mutex.
-     */
-    AMutex mQueueLock;
-
     struct Message {
+#if AUI_MESSAGE_ORIGIN_TRACING
+        /**
+         * @brief Stacktrace of the AAbstractThread::enqueue call. Captured only if AUI is built with
+         * <code>AUI_MESSAGE_ORIGIN_TRACING=ON</code> since capturing a stacktrace per message is expensive.
+         */
         AStacktrace stacktrace;
+#endif
         std::function<void()> proc;
     };
 
     /**
      * @brief Message queue.
+     * @details
+     * Lock-free; the owning thread takes all pending messages at once in processMessagesImpl.
+     */
+    AMpscQueue<Message> mMessageQueue;
+
+    /**
+     * @brief Messages taken from mMessageQueue but not processed yet. Accessed by this thread only.
      */
-    ADeque<Message> mMessageQueue;
+    ADeque<Message> mPendingMessages;
 
     AAbstractThread(const id& id) noexcept;
     void updateThreadName() noexcept;
@@ -18,6 +18,26 @@
 #include <glm/glm.hpp>
 #include <AUI/Common/AException.h>
 #include <AUI/Logging/ALogger.h>
+#include <random>
+
+namespace {
+    void executeTask(const std::function<void()>& func) {
+        try {
+            func();
+        }
+        catch (const AException& e) {
+            ALogger::err("uncaught exception in thread pool: " + e.getMessage());
+        }
+        catch (const AThread::Interrupted&)
+        {
+        }
+    }
+}
+
+AThreadPool::Worker*& AThreadPool::Worker::current() noexcept {
+    thread_local Worker* worker = nullptr;
+    return worker;
+}
 
 AThreadPool::Worker::Worker(AThreadPool& tp, size_t index) :
 	mThread(_new<AThread>([&, index]()
@@ -37,14 +57,7 @@ bool AThreadPool::Worker::processQueue(std::unique_lock<std::mutex>& mutex, AQue
 		queue.pop();
 		mutex.unlock();
 		try {
-			func();
-		}
-		catch (const AException& e) {
-            ALogger::err("uncaught exception in thread pool: " + e.getMessage());
-        }
-		catch (const AThread::Interrupted&)
-		{
-			//AThread::current()->resetInterruptFlag();
+			executeTask(func);
 		}
 		catch (const TryLaterException&)
 		{
@@ -59,6 +72,10 @@ bool AThreadPool::Worker::processQueue(std::unique_lock<std::mutex>& mutex, AQue
 }
 
 void AThreadPool::Worker::thread_fn() {
+    if (mTP.mScheduling == SCHEDULING_WORK_STEALING) {
+        thread_fn_work_stealing();
+        return;
+    }
 	std::unique_lock tpLock(mTP.mQueueLock);
 	while (mEnabled) {
 		while (!mTP.mQueueHighest.empty() || !mTP.mQueueMedium.empty() || !mTP.mQueueLowest.empty()) {
@@ -79,6 +96,46 @@ void AThreadPool::Worker::thread_fn() {
 	}
 }
 
+void AThreadPool::Worker::thread_fn_work_stealing() {
+    current() = this;
+    task func;
+    while (mEnabled) {
+        if (mTP.tryPopWorkStealing(*this, func)) {
+            try {
+                executeTask(func);
+            } catch (const TryLaterException&) {
+                std::unique_lock lock(mTP.mQueueLock);
+                mTP.mQueueTryLater.push(std::move(func));
+            }
+            func = nullptr;
+            continue;
+        }
+
+        std::unique_lock lock(mTP.mQueueLock);
+        if (!mEnabled) break;
+        mTP.mIdleWorkers += 1;
+        // the pending counter is incremented before the idle counter is checked by the producer (see
+        // notifyIdleWorker), so either we see the task here or the producer sees us idle and notifies.
+        if (mTP.pendingTaskCountWorkStealing() == 0) {
+            mTP.mCV.wait(lock);
+        }
+        mTP.mIdleWorkers -= 1;
+    }
+    current() = nullptr;
+
+    // hand over the tasks left in the local queue to the shared queues so they are not lost.
+    std::unique_lock tpLock(mTP.mQueueLock);
+    std::unique_lock localLock(mLocalQueue.lock);
+    for (int priority = PRIORITY_HIGHEST; priority <= PRIORITY_LOWEST; ++priority) {
+        auto& queue = mTP.sharedQueue(Priority(priority));
+        for (auto& t : mLocalQueue.tasks[priority]) {
+            queue.push(std::move(t));
+        }
+        mLocalQueue.tasks[priority].clear();
+    }
+    mTP.mCV.notify_one();
+}
+
 AThreadPool::Worker::~Worker() {
 	mThread->join();
 	mThread = nullptr;
@@ -89,26 +146,114 @@ void AThreadPool::Worker::aboutToDelete() {
 }
 
 
+AQueue<AThreadPool::task>& AThreadPool::sharedQueue(Priority priority) {
+    switch (priority)
+    {
+    case PRIORITY_HIGHEST:
+        return mQueueHighest;
+    case PRIORITY_LOWEST:
+        return mQueueLowest;
+    default:
+        return mQueueMedium;
+    }
+}
+
 void AThreadPool::run(const std::function<void()>& fun, Priority priority) {
-	std::unique_lock lck(mQueueLock);
+    if (mScheduling == SCHEDULING_WORK_STEALING) {
+        // the counter is incremented before the push, so a worker that pops the task never decrements it below zero.
+        mPendingTasks[priority] += 1;
+        if (auto worker = Worker::current(); worker != nullptr && &worker->mTP == this) {
+            // local LIFO push; no contention with other workers unless they are stealing from us.
+            std::unique_lock lock(worker->mLocalQueue.lock);
+            worker->mLocalQueue.tasks[priority].push_back(fun);
+        } else {
+            std::unique_lock lock(mQueueLock);
+            sharedQueue(priority).push(fun);
+        }
+        notifyIdleWorker();
+        return;
+    }
 
-	switch (priority)
-	{
-	case PRIORITY_MEDIUM:
-		mQueueMedium.push(fun);
-		break;
-	case PRIORITY_HIGHEST:
-		mQueueHighest.push(fun);
-		break;
-	case PRIORITY_LOWEST:
-		mQueueLowest.push(fun);
-		break;
-	}
+	std::unique_lock lck(mQueueLock);
+	sharedQueue(priority).push(fun);
 	if (mIdleWorkers > 0) {
         mCV.notify_one();
     }
 }
 
+void AThreadPool::notifyIdleWorker() {
+    if (mIdleWorkers == 0) {
+        return;
+    }
+    {
+        // the worker checks the pending counter under mQueueLock before going to sleep; acquiring the lock here
+        // guarantees the notification is not lost between the check and the wait.
+        std::unique_lock lock(mQueueLock);
+    }
+    mCV.notify_one();
+}
+
+size_t AThreadPool::pendingTaskCountWorkStealing() const noexcept {
+    return mPendingTasks[PRIORITY_HIGHEST] + mPendingTasks[PRIORITY_MEDIUM] + mPendingTasks[PRIORITY_LOWEST];
+}
+
+bool AThreadPool::tryPopWorkStealing(Worker& self, task& out) {
+    thread_local std::minstd_rand random(std::random_device{}());
+
+    for (int priority = PRIORITY_HIGHEST; priority <= PRIORITY_LOWEST; ++priority) {
+        if (mPendingTasks[priority] == 0) {
+            continue;
+        }
+
+        // 1. own local queue, newest first (cache friendly for nested tasks)
+        {
+            std::unique_lock lock(self.mLocalQueue.lock);
+            auto& local = self.mLocalQueue.tasks[priority];
+            if (!local.empty()) {
+                out = std::move(local.back());
+                local.pop_back();
+                mPendingTasks[priority] -= 1;
+                return true;
+            }
+        }
+
+        // 2. shared queue (tasks enqueued from foreign threads)
+        {
+            std::unique_lock lock(mQueueLock);
+            auto& queue = sharedQueue(Priority(priority));
+            if (!queue.empty()) {
+                out = std::move(queue.front());
+                queue.pop();
+                mPendingTasks[priority] -= 1;
+                return true;
+            }
+        }
+
+        // 3. steal the oldest task of a randomly chosen victim
+        std::shared_lock workersLock(mWorkersLock);
+        const auto workerCount = mWorkers.size();
+        if (workerCount == 0) {
+            continue;
+        }
+        const auto offset = random() % workerCount;
+        for (size_t i = 0; i < workerCount; ++i) {
+            auto& victim = *mWorkers[(offset + i) % workerCount];
+            if (&victim == &self) {
+                continue;
+            }
+            std::unique_lock lock(victim.mLocalQueue.lock);
+            auto& victimQueue = victim.mLocalQueue.tasks[priority];
+            if (!victimQueue.empty()) {
+                out = std::move(victimQueue.front());
+                victimQueue.pop_front();
+                mPendingTasks[priority] -= 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void AThreadPool::clear()
 {
 	std::unique_lock lck(mQueueLock);
@@ -122,6 +267,18 @@ void AThreadPool::clear()
 	while (!mQueueTryLater.empty())
 		mQueueTryLater.pop();
 
+    if (mScheduling == SCHEDULING_WORK_STEALING) {
+        std::shared_lock workersLock(mWorkersLock);
+        for (auto& worker : mWorkers) {
+            std::unique_lock localLock(worker->mLocalQueue.lock);
+            for (auto& tasks : worker->mLocalQueue.tasks) {
+                tasks.clear();
+            }
+        }
+        for (auto& pending : mPendingTasks) {
+            pending = 0;
+        }
+    }
 }
 
 void AThreadPool::runLaterTasks()
@@ -129,6 +286,9 @@ void AThreadPool::runLaterTasks()
 	std::unique_lock lck(mQueueLock);
 	while (!mQueueTryLater.empty())
 	{
+        if (mScheduling == SCHEDULING_WORK_STEALING) {
+            mPendingTasks[PRIORITY_LOWEST] += 1;
+        }
 		mQueueLowest.emplace(std::move(mQueueTryLater.front()));
 		mQueueTryLater.pop();
 	}
@@ -143,18 +303,23 @@ void AThreadPool::enqueue(const std::function<void()>& fun, Priority priority)
 AThreadPool& AThreadPool::global()
 {
     // deadlock fix for mingw
+#if AUI_THREADPOOL_WORK_STEALING
+	static AThreadPool* t = new AThreadPool(SCHEDULING_WORK_STEALING);
+#else
 	static AThreadPool* t = new AThreadPool;
+#endif
 	return *t;
 }
 
-AThreadPool::AThreadPool(size_t size) {
+AThreadPool::AThreadPool(size_t size, Scheduling scheduling): mScheduling(scheduling) {
+    std::unique_lock workersLock(mWorkersLock);
     mWorkers.reserve(size);
 	for (size_t i = 0; i < size; ++i)
 		mWorkers.push_back(std::make_unique<Worker>(*this, i));
 }
 
-AThreadPool::AThreadPool() :
-	AThreadPool(glm::max(std::thread::hardware_concurrency() - 1, 2u))
+AThreadPool::AThreadPool(Scheduling scheduling) :
+	AThreadPool(glm::max(std::thread::hardware_concurrency() - 1, 2u), scheduling)
 {
 }
 
@@ -163,7 +328,13 @@ AThreadPool::~AThreadPool() {
 	for (auto& f : mWorkers) {
         f->aboutToDelete();
 	}
-	for (auto& f : mWorkers) {
+    decltype(mWorkers) workers;
+    {
+        // workers being destroyed should not be visible for stealing
+        std::unique_lock workersLock(mWorkersLock);
+        workers = std::move(mWorkers);
+    }
+	for (auto& f : workers) {
         mCV.notify_all();
 		lck.unlock();
 		f.reset();
@@ -178,12 +349,19 @@ void AThreadPool::setWorkersCount(std::size_t workersCount) {
         while (mWorkers.size() > workersCount) {
             mCV.notify_all();
             mWorkers.last()->aboutToDelete();
+            std::unique_ptr<Worker> worker;
+            {
+                std::unique_lock workersLock(mWorkersLock);
+                worker = std::move(mWorkers.last());
+                mWorkers.pop_back();
+            }
             lck.unlock();
-            mWorkers.pop_back();
+            worker.reset();
             lck.lock();
         }
     } else {
         // have to add new workers
+        std::unique_lock workersLock(mWorkersLock);
         mWorkers.reserve(workersCount);
         while (mWorkers.size() < workersCount) {
             mWorkers.push_back(std::make_unique<Worker>(*this, mWorkers.size()));
@@ -193,5 +371,8 @@ void AThreadPool::setWorkersCount(std::size_t workersCount) {
 
 size_t AThreadPool::getPendingTaskCount()
 {
+    if (mScheduling == SCHEDULING_WORK_STEALING) {
+        return pendingTaskCountWorkStealing();
+    }
 	return mQueueHighest.size() + mQueueLowest.size() + mQueueMedium.size();
 }
@@ -19,9 +19,11 @@
 #include <AUI/Core.h>
 #include <cassert>
 #include <atomic>
+#include <shared_mutex>
 
 #include <AUI/Common/AVector.h>
 #include <AUI/Common/AQueue.h>
+#include <AUI/Common/ADeque.h>
 #include <AUI/Common/AException.h>
 #include <AUI/Thread/AThread.h>
 #include <AUI/Util/kAUI.h>
@@ -40,13 +42,31 @@ class API_AUI_CORE AThreadPool
 {
 private:
     class Worker {
+        friend class AThreadPool;
     private:
-        bool mEnabled = true;
+        std::atomic_bool mEnabled = true;
         _<AThread> mThread;
         bool processQueue(std::unique_lock<std::mutex>& mutex, AQueue<std::function<void()>>& queue);
         void thread_fn();
+        void thread_fn_work_stealing();
         AThreadPool& mTP;
+
+        /**
+         * @return worker of the caller thread or nullptr.
+         */
+        static Worker*& current() noexcept;
+
     public:
+        /**
+         * @brief Per-worker task deques (one per priority) used in SCHEDULING_WORK_STEALING mode.
+         * @details
+         * The owning worker pushes and pops from the back (LIFO), other workers steal from the front (FIFO).
+         */
+        struct LocalQueue {
+            std::mutex lock;
+            ADeque<std::function<void()>> tasks[3];
+        } mLocalQueue;
+
         Worker(AThreadPool& tp, size_t index);
         ~Worker();
         void aboutToDelete();
@@ -59,6 +79,30 @@ public:
         PRIORITY_MEDIUM,
         PRIORITY_LOWEST,
     };
+
+    /**
+     * @brief Task distribution strategy of the thread pool.
+     */
+    enum Scheduling
+    {
+        /**
+         * @brief All tasks are pushed to the shared priority queues guarded by a single mutex.
+         */
+        SCHEDULING_SHARED_QUEUE,
+
+        /**
+         * @brief Tasks enqueued from the pool's own workers are pushed to the worker's local deque; idle workers steal
+         * tasks from randomly chosen workers.
+         * @details
+         * Tasks enqueued from foreign threads are still pushed to the shared queues. Priority is respected across all
+         * queues: a worker does not pick a task of lower priority while a task of higher priority is available
+         * anywhere in the pool.
+         *
+         * This mode greatly reduces lock contention when workers spawn lots of small tasks (i.e. nested
+         * <code>AThreadPool::operator*</code> futures).
+         */
+        SCHEDULING_WORK_STEALING,
+    };
 protected:
     typedef std::function<void()> task;
     AVector<std::unique_ptr<Worker>> mWorkers;
@@ -68,19 +112,37 @@ protected:
     AQueue<task> mQueueTryLater;
     std::mutex mQueueLock;
     std::condition_variable mCV;
-    size_t mIdleWorkers = 0;
+    std::atomic_size_t mIdleWorkers = 0;
+    Scheduling mScheduling;
+
+    /**
+     * @brief Guards mWorkers against modification while idle workers are looking for a victim to steal from.
+     */
+    std::shared_mutex mWorkersLock;
+
+    /**
+     * @brief Count of pending tasks per priority (including tasks in local queues). SCHEDULING_WORK_STEALING only.
+     */
+    std::atomic_size_t mPendingTasks[3] = {0, 0, 0};
+
+    AQueue<task>& sharedQueue(Priority priority);
+    size_t pendingTaskCountWorkStealing() const noexcept;
+    bool tryPopWorkStealing(Worker& self, task& out);
+    void notifyIdleWorker();
 
 public:
     /**
      * @brief Initializes the thread pool with size of threads.
      * @param size thread count to initialize.
+     * @param scheduling task distribution strategy.
      */
-    AThreadPool(size_t size);
+    AThreadPool(size_t size, Scheduling scheduling = SCHEDULING_SHARED_QUEUE);
 
     /**
      * @brief Initializes the thread pool with <code>max(std::thread::hardware_concurrency() - 1, 2)</code> of threads.
+     * @param scheduling task distribution strategy.
      */
-    AThreadPool();
+    explicit AThreadPool(Scheduling scheduling = SCHEDULING_SHARED_QUEUE);
     ~AThreadPool();
     size_t getPendingTaskCount();
     void run(const std::function<void()>& fun, Priority priority = PRIORITY_MEDIUM);
@@ -92,9 +154,17 @@ public:
 
     /**
      * @return a global thread pool created with the default constructor.
+     * @details
+     * The global thread pool uses SCHEDULING_WORK_STEALING if AUI is built with <code>AUI_THREADPOOL_WORK_STEALING=ON
+     * </code>; otherwise, SCHEDULING_SHARED_QUEUE is used.
      */
     static AThreadPool& global();
 
+    [[nodiscard]]
+    Scheduling getScheduling() const noexcept {
+        return mScheduling;
+    }
+
     size_t getTotalWorkerCount() const {
         return mWorkers.size();
     }
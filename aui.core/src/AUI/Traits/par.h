@@ -0,0 +1,362 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <AUI/Thread/AThreadPool.h>
+#include <AUI/Thread/AConditionVariable.h>
+#include <AUI/Common/AVector.h>
+#include <AUI/Common/AOptional.h>
+
+/**
+ * @brief Parallel algorithms with dynamic load balancing.
+ * @details
+ * Unlike aui::parallel, which splits a range into one static piece per thread, aui::par algorithms split the range
+ * into chunks claimed by the participating threads on demand (guided scheduling: a chunk is a fraction of the
+ * remaining items, but not less than options::grain). Uneven work is therefore balanced between the threads.
+ *
+ * The calling thread participates in the work instead of blocking, so the algorithms can be called from the pool's
+ * own workers (nested parallelism) and complete even if the pool is busy. An exception thrown by the callback stops
+ * the distribution of the remaining chunks and is rethrown on the calling thread.
+ *
+ * The algorithms require random access iterators (AVector, ADeque, arrays).
+ *
+ * @code{cpp}
+ * AVector<AImage> images = ...;
+ * aui::par::for_each(images, [](AImage& image) {
+ *     blur(image);
+ * });
+ *
+ * auto total = aui::par::transform_reduce(models.begin(), models.end(), size_t(0), std::plus<>{}, [](const Model& m) {
+ *     return m.rebuild();
+ * });
+ * @endcode
+ */
+namespace aui::par {
+    struct options {
+        /**
+         * @brief Thread pool to run on. nullptr means AThreadPool::global().
+         */
+        AThreadPool* pool = nullptr;
+
+        /**
+         * @brief Minimal number of items in a chunk. Increase for cheap per-item work to reduce scheduling overhead.
+         */
+        std::size_t grain = 1;
+    };
+}
+
+namespace aui::impl::par {
+    /**
+     * @brief Shared state of a parallel loop over [0; count).
+     */
+    struct Loop {
+        std::size_t count;
+        std::size_t grain;
+        std::size_t participants;
+        std::atomic_size_t next = 0;
+
+        /**
+         * @brief Number of pool workers inside run(). The loop is finished when no chunks are left and active is 0.
+         */
+        std::atomic_size_t active = 0;
+
+        /**
+         * @brief Body of the loop; owned by the calling thread. Dereferenced only after a successful claim(), which is
+         * impossible after the calling thread has returned.
+         */
+        const std::function<void(std::size_t, std::size_t)>* body;
+
+        AMutex sync;
+        AConditionVariable cv;
+        std::exception_ptr exception;
+
+        Loop(std::size_t count, std::size_t grain, std::size_t participants,
+             const std::function<void(std::size_t, std::size_t)>* body) noexcept:
+            count(count), grain(grain), participants(participants), body(body) {}
+
+        bool claim(std::size_t& begin, std::size_t& end) noexcept {
+            auto current = next.load(std::memory_order_relaxed);
+            for (;;) {
+                if (current >= count) {
+                    return false;
+                }
+                auto remaining = count - current;
+                auto chunk = (std::min)(remaining, (std::max)(grain, remaining / (participants * 2)));
+                if (next.compare_exchange_weak(current, current + chunk)) {
+                    begin = current;
+                    end = current + chunk;
+                    return true;
+                }
+            }
+        }
+
+        void run() noexcept {
+            std::size_t begin, end;
+            while (claim(begin, end)) {
+                try {
+                    (*body)(begin, end);
+                } catch (...) {
+                    std::unique_lock lock(sync);
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    next = count; // do not distribute the remaining chunks
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Calls body(chunkBegin, chunkEnd) for chunks of [0; count) on the pool and the calling thread.
+     */
+    inline void forChunks(std::size_t count, const aui::par::options& options,
+                          const std::function<void(std::size_t, std::size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+        auto& pool = options.pool ? *options.pool : AThreadPool::global();
+        auto grain = (std::max)(options.grain, std::size_t(1));
+        auto helpers = (std::min)(pool.getTotalWorkerCount(), (count - 1) / grain);
+        if (helpers == 0) {
+            body(0, count);
+            return;
+        }
+
+        auto loop = _new<Loop>(count, grain, helpers + 1, &body);
+        for (std::size_t i = 0; i < helpers; ++i) {
+            pool.run([loop] {
+                loop->active += 1;
+                loop->run();
+                if (--loop->active == 0) {
+                    std::unique_lock lock(loop->sync);
+                    loop->cv.notify_all();
+                }
+            }, AThreadPool::PRIORITY_HIGHEST);
+        }
+        loop->run();
+
+        std::unique_lock lock(loop->sync);
+        loop->cv.wait(lock, [&] { return loop->active == 0; });
+        if (loop->exception) {
+            std::rethrow_exception(loop->exception);
+        }
+    }
+
+    template<typename Iterator>
+    concept random_access = std::random_access_iterator<Iterator>;
+
+    /**
+     * @brief Number of blocks for algorithms with a fixed partitioning (sort, scan).
+     */
+    inline std::size_t blockCount(std::size_t count, const aui::par::options& options) {
+        auto& pool = options.pool ? *options.pool : AThreadPool::global();
+        auto blocks = (pool.getTotalWorkerCount() + 1) * 4;
+        return (std::max)(std::size_t(1), (std::min)(blocks, count / (std::max)(options.grain, std::size_t(1))));
+    }
+}
+
+namespace aui::par {
+    /**
+     * @brief Calls functor(chunkBegin, chunkEnd) for chunks of the range in parallel.
+     * @param functor callback. <code>void(Iterator begin, Iterator end);</code>
+     */
+    template<aui::impl::par::random_access Iterator, typename Functor>
+    void for_chunks(Iterator begin, Iterator end, Functor&& functor, const options& options = {}) {
+        aui::impl::par::forChunks(std::distance(begin, end), options, [&](std::size_t b, std::size_t e) {
+            functor(begin + b, begin + e);
+        });
+    }
+
+    /**
+     * @brief Calls functor(index) for each index of [0; count) in parallel (parallel for loop).
+     */
+    template<typename Functor>
+    void for_index(std::size_t count, Functor&& functor, const options& options = {}) {
+        aui::impl::par::forChunks(count, options, [&](std::size_t b, std::size_t e) {
+            for (auto i = b; i != e; ++i) {
+                functor(i);
+            }
+        });
+    }
+
+    /**
+     * @brief Calls functor(item) for each item of the range in parallel.
+     */
+    template<aui::impl::par::random_access Iterator, typename Functor>
+    void for_each(Iterator begin, Iterator end, Functor&& functor, const options& options = {}) {
+        for_chunks(begin, end, [&](Iterator b, Iterator e) {
+            std::for_each(b, e, functor);
+        }, options);
+    }
+
+    /**
+     * @brief Calls functor(item) for each item of the container (i.e. AVector, ADeque) in parallel.
+     */
+    template<typename Container, typename Functor>
+    void for_each(Container& container, Functor&& functor, const options& options = {}) {
+        for_each(std::begin(container), std::end(container), std::forward<Functor>(functor), options);
+    }
+
+    /**
+     * @brief Writes functor(item) of each item of the range to output in parallel.
+     */
+    template<aui::impl::par::random_access Iterator, aui::impl::par::random_access OutputIterator, typename Functor>
+    OutputIterator transform(Iterator begin, Iterator end, OutputIterator output, Functor&& functor,
+                             const options& options = {}) {
+        for_chunks(begin, end, [&](Iterator b, Iterator e) {
+            std::transform(b, e, output + std::distance(begin, b), functor);
+        }, options);
+        return output + std::distance(begin, end);
+    }
+
+    /**
+     * @brief Reduces transform(item) of each item of the range with reduce in parallel.
+     * @param init initial value.
+     * @param reduce associative binary operation. Partial results are combined in the order of the range, so the
+     *        operation does not need to be commutative.
+     * @param transform unary operation applied to each item.
+     */
+    template<aui::impl::par::random_access Iterator, typename T, typename Reduce, typename Transform>
+    T transform_reduce(Iterator begin, Iterator end, T init, Reduce&& reduce, Transform&& transform,
+                       const options& options = {}) {
+        AMutex sync;
+        AVector<std::pair<std::size_t, T>> partials;
+        aui::impl::par::forChunks(std::distance(begin, end), options, [&](std::size_t b, std::size_t e) {
+            auto it = begin + b;
+            T partial = transform(*it);
+            for (++it; it != begin + e; ++it) {
+                partial = reduce(std::move(partial), transform(*it));
+            }
+            std::unique_lock lock(sync);
+            partials.emplace_back(b, std::move(partial));
+        });
+
+        std::sort(partials.begin(), partials.end(), [](const auto& l, const auto& r) { return l.first < r.first; });
+        for (auto& [index, partial] : partials) {
+            init = reduce(std::move(init), std::move(partial));
+        }
+        return init;
+    }
+
+    /**
+     * @brief Reduces the items of the range with reduce in parallel.
+     * @see transform_reduce
+     */
+    template<aui::impl::par::random_access Iterator, typename T, typename Reduce = std::plus<>>
+    T reduce(Iterator begin, Iterator end, T init, Reduce&& reduce = {}, const options& options = {}) {
+        return transform_reduce(begin, end, std::move(init), std::forward<Reduce>(reduce),
+                                [](const auto& v) -> decltype(auto) { return v; }, options);
+    }
+
+    /**
+     * @brief Sorts the range in parallel (not stable).
+     * @details
+     * The range is split into blocks which are sorted in parallel, then the blocks are merged pairwise in parallel.
+     */
+    template<aui::impl::par::random_access Iterator, typename Compare = std::less<>>
+    void sort(Iterator begin, Iterator end, Compare&& compare = {}, const options& options = {}) {
+        auto count = std::size_t(std::distance(begin, end));
+        auto blocks = aui::impl::par::blockCount(count, options);
+        auto boundary = [&](std::size_t block) {
+            return begin + count * block / blocks;
+        };
+        auto blockOptions = options;
+        blockOptions.grain = 1;
+
+        for_index(blocks, [&](std::size_t block) {
+            std::sort(boundary(block), boundary(block + 1), compare);
+        }, blockOptions);
+
+        for (std::size_t width = 1; width < blocks; width *= 2) {
+            for_index((blocks + width * 2 - 1) / (width * 2), [&](std::size_t pair) {
+                auto first = pair * width * 2;
+                auto middle = (std::min)(first + width, blocks);
+                auto last = (std::min)(first + width * 2, blocks);
+                if (middle != last) {
+                    std::inplace_merge(boundary(first), boundary(middle), boundary(last), compare);
+                }
+            }, blockOptions);
+        }
+    }
+
+    /**
+     * @brief Sorts the container (i.e. AVector, ADeque) in parallel.
+     */
+    template<typename Container, typename Compare = std::less<>>
+    void sort(Container& container, Compare&& compare = {}, const options& options = {}) {
+        sort(std::begin(container), std::end(container), std::forward<Compare>(compare), options);
+    }
+
+    /**
+     * @brief Computes inclusive prefix "sums" of the range in parallel.
+     * @param output output range; may be equal to begin.
+     * @param op associative binary operation.
+     * @return end of the output range.
+     * @details
+     * Two passes: block totals are computed in parallel, then each block is scanned in parallel starting from the
+     * total of the preceding blocks.
+     */
+    template<aui::impl::par::random_access Iterator, aui::impl::par::random_access OutputIterator,
+             typename Op = std::plus<>>
+    OutputIterator inclusive_scan(Iterator begin, Iterator end, OutputIterator output, Op&& op = {},
+                                  const options& options = {}) {
+        using T = typename std::iterator_traits<Iterator>::value_type;
+        auto count = std::size_t(std::distance(begin, end));
+        if (count == 0) {
+            return output;
+        }
+        auto blocks = aui::impl::par::blockCount(count, options);
+        auto boundary = [&](std::size_t block) {
+            return count * block / blocks;
+        };
+        auto blockOptions = options;
+        blockOptions.grain = 1;
+
+        // the last block's total is not needed
+        AVector<AOptional<T>> totals(blocks);
+        for_index(blocks - 1, [&](std::size_t block) {
+            auto it = begin + boundary(block);
+            T total = *it;
+            for (++it; it != begin + boundary(block + 1); ++it) {
+                total = op(std::move(total), *it);
+            }
+            totals[block] = std::move(total);
+        }, blockOptions);
+
+        AVector<AOptional<T>> carries(blocks);
+        for (std::size_t block = 1; block < blocks; ++block) {
+            carries[block] = carries[block - 1] ? op(*carries[block - 1], *totals[block - 1]) : *totals[block - 1];
+        }
+
+        for_index(blocks, [&](std::size_t block) {
+            auto it = begin + boundary(block);
+            auto out = output + boundary(block);
+            AOptional<T> sum = carries[block];
+            for (; it != begin + boundary(block + 1); ++it, ++out) {
+                sum = sum ? op(std::move(*sum), *it) : T(*it);
+                *out = *sum;
+            }
+        }, blockOptions);
+        return output + count;
+    }
+}
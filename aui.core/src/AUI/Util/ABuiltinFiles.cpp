@@ -16,48 +16,221 @@
 
 #include "ABuiltinFiles.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <unordered_map>
 #include "LZ.h"
 #include "AUI/Common/AString.h"
 #include "AUI/IO/AByteBufferInputStream.h"
+#include "AUI/IO/AIOException.h"
+
+namespace {
+    /*
+     * Packed data layout:
+     * - MAGIC;
+     * - uint32 entry count;
+     * - index records sorted by path: uint32 path offset, uint32 path size, uint32 data offset, uint32 data size,
+     *   uint8 compressed flag. Offsets are relative to the beginning of the packed data;
+     * - paths;
+     * - data of the entries; compressed entries are LZ::compressFrame frames.
+     *
+     * Integers are written by AUI serialization.
+     */
+    constexpr std::size_t INDEX_RECORD_SIZE = 4 * sizeof(std::uint32_t) + sizeof(std::uint8_t);
+    constexpr std::size_t HEADER_SIZE = ABuiltinFiles::MAGIC.size() + sizeof(std::uint32_t);
+
+    template<typename T>
+    T readAt(const char* data) noexcept {
+        T result;
+        std::memcpy(&result, data, sizeof(T));
+        return result;
+    }
+}
 
 void ABuiltinFiles::loadBuffer(AByteBuffer& data)
 {
 	AByteBuffer unpacked;
 	LZ::decompress(data, unpacked);
     AByteBufferInputStream bis(unpacked);
+    auto& self = inst();
+    std::unique_lock lock(self.mMutex);
 	while (bis.available())
 	{
 		std::string file;
         AByteBuffer b;
         bis >> aui::serialize_sized(file);
         bis >> aui::serialize_sized(b);
-        inst().mBuffers[AString(file)] = std::move(b);
+        auto& path = self.mPaths.emplace_back(std::move(file));
+        auto& buffer = self.mBuffers.emplace_back(std::move(b));
+        self.mEntries << Entry{ path, buffer.data(), buffer.size(), false, &buffer };
 	}
+    self.mSorted = false;
+}
+
+void ABuiltinFiles::load(const unsigned char* data, size_t size) {
+    auto begin = reinterpret_cast<const char*>(data);
+    if (size < HEADER_SIZE || std::string_view(begin, MAGIC.size()) != MAGIC) {
+        // packed by the previous version of aui.toolbox
+        AByteBuffer b(data, size);
+        loadBuffer(b);
+        return;
+    }
+
+    auto count = readAt<std::uint32_t>(begin + MAGIC.size());
+    if (count > (size - HEADER_SIZE) / INDEX_RECORD_SIZE) {
+        throw AIOException("malformed builtin files: index is out of bounds");
+    }
+    auto& self = inst();
+    std::unique_lock lock(self.mMutex);
+    self.mEntries.reserve(self.mEntries.size() + count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        auto record = begin + HEADER_SIZE + i * INDEX_RECORD_SIZE;
+        auto pathOffset = readAt<std::uint32_t>(record);
+        auto pathSize = readAt<std::uint32_t>(record + 4);
+        auto dataOffset = readAt<std::uint32_t>(record + 8);
+        auto dataSize = readAt<std::uint32_t>(record + 12);
+        auto compressed = readAt<std::uint8_t>(record + 16) != 0;
+        if (std::size_t(pathOffset) + pathSize > size || std::size_t(dataOffset) + dataSize > size) {
+            throw AIOException("malformed builtin files: entry is out of bounds");
+        }
+        self.mEntries << Entry{ { begin + pathOffset, pathSize }, begin + dataOffset, dataSize, compressed };
+    }
+    self.mSorted = false;
+}
+
+ABuiltinFiles::CompressedEntry ABuiltinFiles::compressEntry(AByteBufferView data, int level) {
+    AByteBuffer compressed;
+    LZ::compressFrame(data, compressed, level);
+
+    // keep the compressed data only if it's worth decompressing
+    if (compressed.size() < data.size() - data.size() / 8) {
+        return { std::move(compressed), true };
+    }
+    return { AByteBuffer(data), false };
+}
+
+AByteBuffer ABuiltinFiles::pack(const AVector<PackEntry>& files, int level) {
+    // compress every distinct content once
+    std::unordered_map<std::string_view, CompressedEntry> contents;
+    for (const auto& file : files) {
+        std::string_view content(file.data.data(), file.data.size());
+        if (!contents.contains(content)) {
+            contents.emplace(content, compressEntry(file.data, level));
+        }
+    }
+    AVector<PackCompressedEntry> entries;
+    entries.reserve(files.size());
+    for (const auto& file : files) {
+        const auto& content = contents.at(std::string_view(file.data.data(), file.data.size()));
+        entries << PackCompressedEntry{ file.path, content.data, content.compressed };
+    }
+    return packCompressed(entries);
+}
+
+AByteBuffer ABuiltinFiles::packCompressed(const AVector<PackCompressedEntry>& entries) {
+    struct Packed {
+        std::string path;
+        const PackCompressedEntry* entry;
+    };
+    AVector<Packed> packed;
+    packed.reserve(entries.size());
+    for (const auto& entry : entries) {
+        packed << Packed{ entry.path.toStdString(), &entry };
+    }
+    std::sort(packed.begin(), packed.end(), [](const Packed& l, const Packed& r) { return l.path < r.path; });
+
+    // offsets of the data; entries with the same data view share the offset
+    std::size_t pathOffset = HEADER_SIZE + packed.size() * INDEX_RECORD_SIZE;
+    std::size_t dataOffset = pathOffset;
+    for (const auto& p : packed) {
+        dataOffset += p.path.size();
+    }
+    std::map<std::pair<const char*, std::size_t>, std::size_t> dataOffsets;
+    AVector<AByteBufferView> data;
+    for (const auto& p : packed) {
+        auto [it, inserted] = dataOffsets.emplace(std::make_pair(p.entry->data.data(), p.entry->data.size()),
+                                                  dataOffset);
+        if (inserted) {
+            data << p.entry->data;
+            dataOffset += p.entry->data.size();
+        }
+    }
+    if (dataOffset > std::numeric_limits<std::uint32_t>::max()) {
+        throw AIOException("builtin files are too large to be packed");
+    }
+
+    AByteBuffer result;
+    result.reserve(dataOffset);
+    result.write(MAGIC.data(), MAGIC.size());
+    result << std::uint32_t(packed.size());
+    for (const auto& p : packed) {
+        result << std::uint32_t(pathOffset) << std::uint32_t(p.path.size())
+               << std::uint32_t(dataOffsets[{ p.entry->data.data(), p.entry->data.size() }])
+               << std::uint32_t(p.entry->data.size())
+               << std::uint8_t(p.entry->compressed);
+        pathOffset += p.path.size();
+    }
+    for (const auto& p : packed) {
+        result.write(p.path.data(), p.path.size());
+    }
+    for (const auto& d : data) {
+        result.write(d.data(), d.size());
+    }
+    return result;
+}
+
+void ABuiltinFiles::sort() {
+    // stable, so the entry loaded last wins over the duplicates, as it was with AMap
+    std::stable_sort(mEntries.begin(), mEntries.end(), [](const Entry& l, const Entry& r) { return l.path < r.path; });
+    auto last = std::unique(mEntries.rbegin(), mEntries.rend(), [](const Entry& l, const Entry& r) {
+        return l.path == r.path;
+    });
+    mEntries.erase(mEntries.begin(), last.base());
+    mSorted = true;
+}
+
+AOptional<AByteBufferView> ABuiltinFiles::find(const AString& file) {
+    std::unique_lock lock(mMutex);
+    if (!mSorted) {
+        sort();
+    }
+    auto path = file.toStdString();
+    auto it = std::lower_bound(mEntries.begin(), mEntries.end(), path, [](const Entry& entry, const std::string& path) {
+        return entry.path < path;
+    });
+    if (it == mEntries.end() || it->path != path) {
+        return std::nullopt;
+    }
+    if (it->buffer) {
+        return AByteBufferView(*it->buffer);
+    }
+    if (!it->compressed) {
+        return AByteBufferView(it->data, it->size);
+    }
+
+    // decompressed on the first access
+    auto& buffer = mBuffers.emplace_back();
+    LZ::decompressFrame({ it->data, it->size }, buffer);
+    it->buffer = &buffer;
+    return AByteBufferView(buffer);
 }
 
 _<IInputStream> ABuiltinFiles::open(const AString& file)
 {
-	if (auto c = inst().mBuffers.contains(file))
+	if (auto buffer = inst().find(file))
 	{
-		return _new<AByteBufferInputStream>(c->second);
+		return _new<AByteBufferInputStream>(*buffer);
 	}
 	return nullptr;
 }
 
 AOptional<AByteBufferView> ABuiltinFiles::getBuffer(const AString& file) {
-    if (auto c = inst().mBuffers.contains(file))
-    {
-        return AByteBufferView(c->second);
-    }
-    return std::nullopt;
+    return inst().find(file);
 }
 
 ABuiltinFiles& ABuiltinFiles::inst() {
     static ABuiltinFiles f;
     return f;
 }
-
-void ABuiltinFiles::load(const unsigned char* data, size_t size) {
-    AByteBuffer b(data, size);
-    inst().loadBuffer(b);
-}
@@ -16,26 +16,125 @@
 
 #pragma once
 
+#include <deque>
+#include <string_view>
 #include "AUI/Core.h"
 #include "AUI/Common/AByteBuffer.h"
-#include "AUI/Common/AMap.h"
+#include "AUI/Common/AVector.h"
 #include "AUI/Common/SharedPtr.h"
 #include "AUI/IO/IInputStream.h"
+#include "AUI/Thread/AMutex.h"
 #include <optional>
 
 class AString;
 
+/**
+ * @brief Files embedded into the application by aui.toolbox (<code>aui_compile_assets</code>).
+ * @ingroup core
+ * @details
+ * The packed data is a sorted index of the files followed by the entries; each entry is either stored as is or
+ * compressed independently (see LZ::compressFrame). Loading the packed data only registers the index: the data is
+ * neither copied nor decompressed. Stored entries are accessed in place; compressed entries are decompressed on the
+ * first access and are kept in memory.
+ *
+ * The data passed to load() must outlive the application (as the static arrays generated by aui.toolbox do).
+ *
+ * The data packed by the previous versions of aui.toolbox (single zlib blob) is still supported; it is decompressed and
+ * copied while loading.
+ */
 class API_AUI_CORE ABuiltinFiles
 {
-private:
-	AMap<AString, AByteBuffer> mBuffers;
+public:
+    struct PackEntry {
+        /**
+         * @brief Asset path, i.e. "img/logo.svg".
+         */
+        AString path;
+        AByteBufferView data;
+    };
 
-	static ABuiltinFiles& inst();
-	ABuiltinFiles() = default;
+    /**
+     * @brief Magic at the beginning of the indexed packed data.
+     */
+    static constexpr std::string_view MAGIC = "AUIPACK2";
 
-public:
 	static void loadBuffer(AByteBuffer& data);
 	static void load(const unsigned char* data, size_t size);
 	static _<IInputStream> open(const AString& file);
     static AOptional<AByteBufferView> getBuffer(const AString& file);
+
+    /**
+     * @brief Entry data prepared by compressEntry().
+     */
+    struct CompressedEntry {
+        AByteBuffer data;
+        bool compressed;
+    };
+
+    /**
+     * @brief Entry of packCompressed().
+     */
+    struct PackCompressedEntry {
+        AString path;
+
+        /**
+         * @brief Data returned by compressEntry(). Entries with the same view (data pointer and size) share the data in
+         * the packed data.
+         */
+        AByteBufferView data;
+        bool compressed;
+    };
+
+    /**
+     * @brief Builds the packed data for load().
+     * @param files files to pack. Files with identical contents are stored once.
+     * @param level zlib compression level. Files which are not compressible (i.e. png) are stored as is.
+     */
+    static AByteBuffer pack(const AVector<PackEntry>& files, int level = 9);
+
+    /**
+     * @brief Compresses the file data for packCompressed(), if it is worth it.
+     * @details
+     * Thread safe; can be used to compress the files in parallel.
+     */
+    static CompressedEntry compressEntry(AByteBufferView data, int level = 9);
+
+    /**
+     * @brief Builds the packed data for load() from the entries compressed by compressEntry().
+     */
+    static AByteBuffer packCompressed(const AVector<PackCompressedEntry>& entries);
+
+private:
+    struct Entry {
+        std::string_view path;
+        const char* data;
+        std::size_t size;
+        bool compressed;
+
+        /**
+         * @brief Decompressed data of a compressed entry or the data of a legacy entry.
+         */
+        AByteBuffer* buffer = nullptr;
+    };
+
+    AMutex mMutex;
+
+    /**
+     * @brief Sorted by path after sort().
+     */
+    AVector<Entry> mEntries;
+    bool mSorted = true;
+
+    /**
+     * @brief Storage of the decompressed and legacy data. std::deque never relocates its elements, so the views given
+     * out stay valid.
+     */
+    std::deque<AByteBuffer> mBuffers;
+    std::deque<std::string> mPaths;
+
+	static ABuiltinFiles& inst();
+	ABuiltinFiles() = default;
+
+    void sort();
+    AOptional<AByteBufferView> find(const AString& file);
 };
@@ -20,6 +20,22 @@
 
 #include "AScheduler.h"
 
+namespace {
+    /**
+     * @brief Number of children of a heap node. 4-ary heap is shallower than binary one and its children share
+     * cache lines.
+     */
+    constexpr std::size_t ARITY = 4;
+
+    template<typename Task>
+    bool isEarlier(const Task& lhs, const Task& rhs) noexcept {
+        if (lhs.executionTime != rhs.executionTime) {
+            return lhs.executionTime < rhs.executionTime;
+        }
+        return lhs.sequence < rhs.sequence;
+    }
+}
+
 
 AScheduler::AScheduler() {
 
@@ -35,20 +51,42 @@ bool AScheduler::iteration(ABitField<ASchedulerIteration> flag) {
         mCV.wait(lock);
     }
 
+    AVector<_<Timer>> expired;
     while (!mTasks.empty()) {
         auto now = currentTime();
-        if (now < mTasks.front().executionTime) {
+        if (now < mTasks.front()->executionTime) {
             if (flag & ASchedulerIteration::DONT_BLOCK_TIMED) {
                 return false;
             }
 
-            auto t = mTasks.front().executionTime;
+            auto t = mTasks.front()->executionTime;
             mCV.wait_until(lock, t);
             break;
         }
-        auto callback = std::move(mTasks.front().callback);
-        mTasks.pop_front();
-        callback();
+
+        // take all the expired tasks at once
+        while (!mTasks.empty() && !(now < mTasks.front()->executionTime)) {
+            expired << popEarliest();
+        }
+        for (const auto& task : expired) {
+            if (task->period.count() > 0) {
+                task->executionTime += task->period;
+                schedule(task);
+            }
+        }
+
+        lock.unlock();
+        for (const auto& task : expired) {
+            if (task->removed) {
+                continue;
+            }
+            task->callback();
+            if (task->period.count() == 0) {
+                task->callback = nullptr; // release the captured resources
+            }
+        }
+        expired.clear();
+        lock.lock();
     }
 
     return true;
@@ -65,12 +103,92 @@ void AScheduler::loop() {
     }
 }
 
-void AScheduler::removeTimer(TimerHandle t) {
+void AScheduler::removeTimer(const TimerHandle& t) {
+    if (!t) {
+        return;
+    }
     std::unique_lock lock(mSync);
+    t->removed = true;
 
-    mTasks.erase(std::remove_if(mTasks.begin(), mTasks.end(), [&](const Task& rhs) {
-        return rhs.timer == &*t;
-    }), mTasks.end());
-    mTimers.erase(t);
+    auto index = t->heapIndex;
+    if (index == NOT_SCHEDULED) {
+        return;
+    }
+    t->heapIndex = NOT_SCHEDULED;
+    auto last = std::move(mTasks.back());
+    mTasks.pop_back();
+    if (index < mTasks.size()) {
+        // fill the gap with the last task and restore the heap order
+        place(std::move(last), index);
+        if (index > 0 && isEarlier(*mTasks[index], *mTasks[(index - 1) / ARITY])) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
     mCV.notify_all();
 }
+
+void AScheduler::schedule(_<Timer> task) {
+    auto taskPtr = task.get();
+    task->sequence = mSequence++;
+    mTasks.push_back(std::move(task));
+    siftUp(mTasks.size() - 1);
+    if (mTasks.front().get() == taskPtr) {
+        // the earliest task has changed; wake up the waiting thread
+        mCV.notify_all();
+    }
+}
+
+_<AScheduler::Timer> AScheduler::popEarliest() noexcept {
+    auto earliest = std::move(mTasks.front());
+    earliest->heapIndex = NOT_SCHEDULED;
+    auto last = std::move(mTasks.back());
+    mTasks.pop_back();
+    if (!mTasks.empty()) {
+        place(std::move(last), 0);
+        siftDown(0);
+    }
+    return earliest;
+}
+
+void AScheduler::place(_<Timer> task, std::size_t index) noexcept {
+    task->heapIndex = index;
+    mTasks[index] = std::move(task);
+}
+
+void AScheduler::siftUp(std::size_t index) noexcept {
+    auto task = std::move(mTasks[index]);
+    while (index > 0) {
+        auto parent = (index - 1) / ARITY;
+        if (!isEarlier(*task, *mTasks[parent])) {
+            break;
+        }
+        place(std::move(mTasks[parent]), index);
+        index = parent;
+    }
+    place(std::move(task), index);
+}
+
+void AScheduler::siftDown(std::size_t index) noexcept {
+    auto task = std::move(mTasks[index]);
+    for (;;) {
+        auto firstChild = index * ARITY + 1;
+        if (firstChild >= mTasks.size()) {
+            break;
+        }
+        auto lastChild = (std::min)(firstChild + ARITY, mTasks.size());
+        auto earliest = firstChild;
+        for (auto child = firstChild + 1; child < lastChild; ++child) {
+            if (isEarlier(*mTasks[child], *mTasks[earliest])) {
+                earliest = child;
+            }
+        }
+        if (!isEarlier(*mTasks[earliest], *task)) {
+            break;
+        }
+        place(std::move(mTasks[earliest]), index);
+        index = earliest;
+    }
+    place(std::move(task), index);
+}
@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <functional>
-#include <list>
+#include <AUI/Common/AVector.h>
+#include <AUI/Common/SharedPtrTypes.h>
 #include <AUI/Thread/AMutex.h>
 #include <AUI/Thread/AConditionVariable.h>
 #include <AUI/Thread/IEventLoop.h>
@@ -60,24 +64,56 @@ AUI_ENUM_FLAG(ASchedulerIteration) {
 /**
  * @brief Basic scheduler used for timers.
  * @ingroup core
+ * @details
+ * Pending tasks are kept in a 4-ary min-heap ordered by execution time, so enqueue(), timer() and removeTimer() take
+ * O(log n) regardless of the number of pending tasks. Tasks with equal execution time are executed in the order they
+ * were enqueued. All expired tasks are taken from the heap at once and executed outside of the scheduler's lock, so
+ * the callbacks may freely enqueue or remove tasks.
  */
 class API_AUI_CORE AScheduler: public IEventLoop {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
 private:
     using SchedulerDuration = std::chrono::microseconds;
 
+    static constexpr std::size_t NOT_SCHEDULED = std::numeric_limits<std::size_t>::max();
+
     struct Timer {
-        std::chrono::milliseconds timeout;
-        std::chrono::high_resolution_clock::time_point nextExecution;
-        std::function<void()> callback;
-    };
+        TimePoint executionTime;
 
-    struct Task {
-        std::chrono::high_resolution_clock::time_point executionTime;
+        /**
+         * @brief Period of the timer; zero for a one-shot task.
+         */
+        SchedulerDuration period;
         std::function<void()> callback;
-        Timer* timer;
+
+        /**
+         * @brief Enqueue order; breaks ties between tasks with equal execution time.
+         */
+        std::uint64_t sequence = 0;
+
+        /**
+         * @brief Position in AScheduler::mTasks, or NOT_SCHEDULED. Guarded by AScheduler::mSync.
+         */
+        std::size_t heapIndex = NOT_SCHEDULED;
+
+        /**
+         * @brief Set by removeTimer(); checked right before the callback is called outside of the lock.
+         */
+        std::atomic_bool removed = false;
+
+        Timer(TimePoint executionTime, SchedulerDuration period, std::function<void()> callback) noexcept:
+            executionTime(executionTime), period(period), callback(std::move(callback)) {}
     };
+
 public:
-    using TimerHandle = std::list<Timer>::iterator;
+    /**
+     * @brief Handle of a scheduled task or timer, used to remove it.
+     * @details
+     * The handle stays valid after the task is executed or removed; removing such task is a no-op.
+     */
+    using TimerHandle = _<Timer>;
 
     AScheduler();
 
@@ -91,15 +127,20 @@ public:
     void notifyProcessMessages() override;
     void loop() override;
 
+    /**
+     * @brief Schedules a one-shot task.
+     * @param timeout timeout (i.e. 500ms)
+     * @param callback callback to be called
+     * @return handle which can be passed to removeTimer() to cancel the task.
+     */
     template<typename Duration>
-    void enqueue(Duration timeout, std::function<void()> callback) {
+    TimerHandle enqueue(Duration timeout, std::function<void()> callback) {
+        auto task = _new<Timer>(currentTime() + std::chrono::duration_cast<SchedulerDuration>(timeout),
+                                SchedulerDuration::zero(),
+                                std::move(callback));
         std::unique_lock lock(mSync);
-        Task asTask = {
-                std::chrono::duration_cast<SchedulerDuration>(timeout) + currentTime(),
-                std::move(callback)
-        };
-        enqueueTask(std::move(asTask));
-        mCV.notify_all();
+        schedule(task);
+        return task;
     }
 
     /**
@@ -112,64 +153,58 @@ public:
      */
     template<typename Duration>
     TimerHandle timer(Duration timeout, std::function<void()> callback) {
-        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
-        Timer asTimer = {
-                millis,
-                millis + currentTime(),
-                std::move(callback)
-        };
-
+        auto period = std::chrono::duration_cast<SchedulerDuration>(timeout);
+        assert(("zero period?", period.count() > 0));
+        auto timer = _new<Timer>(currentTime() + period, period, std::move(callback));
         std::unique_lock lock(mSync);
-        mTimers.push_back(std::move(asTimer));
-        auto t = std::prev(mTimers.end());
-        lock.unlock();
-        enqueueTimer(&*t);
-        return t;
+        schedule(timer);
+        return timer;
     }
 
-
-    void removeTimer(TimerHandle t);
+    /**
+     * @brief Removes a task or a timer.
+     * @details
+     * O(log n). After removeTimer() returns, the callback is not called anymore, unless it is already being called.
+     */
+    void removeTimer(const TimerHandle& t);
 
     bool emptyTasks() const noexcept {
+        std::unique_lock lock(mSync);
         return mTasks.empty();
     }
 
-
-private:
-    AMutex mSync;
-    AConditionVariable mCV;
-
-    std::list<Task> mTasks;
-    std::list<Timer> mTimers;
-
-    static std::chrono::high_resolution_clock::time_point currentTime() noexcept {
+protected:
+    /**
+     * @brief Current time the execution times are counted from.
+     * @details
+     * Can be overridden to run the scheduler on a fake clock (i.e. in tests). Blocking waits use the real clock, so
+     * such scheduler should be iterated with ASchedulerIteration::DONT_BLOCK.
+     */
+    virtual TimePoint currentTime() const noexcept {
         return std::chrono::high_resolution_clock::now();
     }
 
-    void enqueueTimer(Timer* timer) {
-        Task t = {
-            timer->nextExecution,
-            [this, timer]() {
-                timer->callback();
-                enqueueTimer(timer);
-            },
-            timer
-        };
-        timer->nextExecution += timer->timeout;
-        enqueueTask(std::move(t));
-    }
+private:
+    mutable AMutex mSync;
+    AConditionVariable mCV;
 
+    /**
+     * @brief 4-ary min-heap of pending tasks, ordered by executionTime and sequence.
+     */
+    AVector<_<Timer>> mTasks;
+    std::uint64_t mSequence = 0;
 
-    Task* enqueueTask(Task&& asTask) {
-        auto whereToInsert = std::find_if(mTasks.begin(), mTasks.end(), [&](const Task& rhs) {
-            return asTask.executionTime < rhs.executionTime;
-        });
+    /**
+     * @brief Pushes the task to the heap. mSync must be locked.
+     */
+    void schedule(_<Timer> task);
 
-        auto p = &*mTasks.insert(whereToInsert, std::move(asTask));
-        mCV.notify_all();
-        return p;
-    }
+    /**
+     * @brief Removes the earliest task from the heap. mSync must be locked.
+     */
+    _<Timer> popEarliest() noexcept;
 
+    void siftUp(std::size_t index) noexcept;
+    void siftDown(std::size_t index) noexcept;
+    void place(_<Timer> task, std::size_t index) noexcept;
 };
-
-
@@ -14,66 +14,109 @@
 // You should have received a copy of the GNU Lesser General Public
 // License along with this library. If not, see <http://www.gnu.org/licenses/>.
 
+#include <charconv>
+#include <cstdlib>
 #include "ATokenizer.h"
 #include "AUI/Common/AStringVector.h"
 #include "AUI/Common/AMap.h"
 #include "AUI/Common/ASet.h"
-#include "AUI/IO/AStringStream.h"
 
-ATokenizer::ATokenizer(const AString& fromString):
-    mInput(_new<AStringStream>(fromString))
+ATokenizer::ATokenizer(AByteBufferView buffer):
+    mBufferRead(buffer.data()),
+    mBufferEnd(buffer.data() + buffer.size())
 {
 }
 
-const std::string& ATokenizer::readString()
+ATokenizer::ATokenizer(const AString& fromString):
+    mOwnedInput(fromString.toStdString()),
+    mBufferRead(mOwnedInput.data()),
+    mBufferEnd(mOwnedInput.data() + mOwnedInput.size())
 {
-    mTemporaryStringBuffer.clear();
-    char c;
+}
 
-    try
-    {
-        for (;;) {
-            c = readChar();
-            if (isalnum(uint8_t (c)))
-            {
-                mTemporaryStringBuffer.push_back(c);
-            }
-            else
-            {
-                reverseByte();
-                return mTemporaryStringBuffer;
-            }
+bool ATokenizer::refill() {
+    if (!mInput) {
+        // the whole input is already in the memory
+        return false;
+    }
+    mBufferEnd = mBuffer + mInput->read(mBuffer, sizeof(mBuffer));
+    mBufferRead = mBuffer;
+    return mBufferEnd != mBufferRead;
+}
+
+namespace {
+    template<typename T>
+    T parseInteger(std::string_view token) {
+        if (token.empty()) {
+            return 0;
         }
-    } catch (...)
-    {
-        mEof = true;
+        bool negative = token.front() == '-';
+        if (negative) {
+            token.remove_prefix(1);
+        }
+        int base = 10;
+        if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+            token.remove_prefix(2);
+            base = 16;
+        }
+        std::uint64_t value = 0;
+        auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value, base);
+        if (ec != std::errc{} || end != token.data() + token.size()) {
+            return 0;
+        }
+        return static_cast<T>(negative ? 0 - value : value);
+    }
+
+    float parseFloat(std::string_view token) {
+        if (token.empty()) {
+            return 0;
+        }
+        float value = 0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc{} || end != token.data() + token.size()) {
+            return 0;
+        }
+#else
+        std::string nullTerminated(token);
+        char* end;
+        value = std::strtof(nullTerminated.c_str(), &end);
+        if (end != nullTerminated.c_str() + nullTerminated.size()) {
+            return 0;
+        }
+#endif
+        return value;
+    }
+
+    bool isIntegerChar(char c) noexcept {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == 'x' || c == 'X' || c == '-';
     }
+}
+
+const std::string& ATokenizer::readString()
+{
+    mTemporaryStringBuffer = readStringView();
     return mTemporaryStringBuffer;
 }
+
+std::string_view ATokenizer::readStringView() {
+    return readStringViewWhile([](char c) { return isalnum(uint8_t(c)) != 0; });
+}
+
 const std::string& ATokenizer::readString(const ASet<char>& applicableChars)
 {
-    mTemporaryStringBuffer.clear();
-    char c;
+    return readStringWhile([&](char c) {
+        return isalnum(uint8_t(c)) || applicableChars.find(c) != applicableChars.end();
+    });
+}
 
-    try
-    {
-        for (;;) {
-            c = readChar();
-            if (isalnum(uint8_t (c)) || applicableChars.find(c) != applicableChars.end())
-            {
-                mTemporaryStringBuffer.push_back(c);
-            }
-            else
-            {
-                reverseByte();
-                return mTemporaryStringBuffer;
-            }
-        }
-    } catch (...)
-    {
-        mEof = true;
+std::string_view ATokenizer::readStringViewUntil(char c) {
+    auto result = readStringViewWhile([c](char current) { return current != c; });
+    if (!mEof) {
+        // consume the delimiter
+        readChar();
     }
-    return mTemporaryStringBuffer;
+    return result;
 }
 
 
@@ -84,153 +127,21 @@ void ATokenizer::reverseByte()
 
 float ATokenizer::readFloat()
 {
-    mTemporaryAStringBuffer.clear();
-    try {
-        bool dot = false;
-        char c;
-        for (;;)
-        {
-            c = readChar();
-            switch (c)
-            {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '-':
-                mTemporaryAStringBuffer << c;
-                break;
-            case '.':
-                if (!dot)
-                {
-                    mTemporaryAStringBuffer << c;
-                    break;
-                }
-            default:
-                reverseByte();
-                return mTemporaryAStringBuffer.toFloat().valueOr(0);
-            }
-        }
-    } catch (...) {
-        mEof = true;
-    }
-    return mTemporaryAStringBuffer.toFloat().valueOr(0);
+    return parseFloat(readStringViewWhile([](char c) {
+        return (c >= '0' && c <= '9') || c == '-' || c == '.';
+    }));
 }
 
 template<typename T>
 T ATokenizer::readIntImpl() {
     static_assert(std::is_integral_v<T>, "readIntImpl accepts only integral type");
-    mTemporaryAStringBuffer.clear();
-    auto value = [&] {
-        if constexpr(sizeof(T) > 4) {
-            return mTemporaryAStringBuffer.toLongInt().valueOr(0);
-        } else {
-            return mTemporaryAStringBuffer.toInt().valueOr(0);
-        }
-    };
-    try {
-        char c;
-        for (;;)
-        {
-            c = readChar();
-            switch (c)
-            {
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
-                case 'x':
-                case 'X':
-
-                    // hex
-                case 'a':
-                case 'A':
-                case 'b':
-                case 'B':
-                case 'c':
-                case 'C':
-                case 'd':
-                case 'D':
-                case 'e':
-                case 'E':
-                case 'f':
-                case 'F':
-                case '-':
-                    mTemporaryAStringBuffer << c;
-                    break;
-                default:
-                    reverseByte();
-                    return value();
-            }
-        }
-    }
-    catch (...) {
-        mEof = true;
-    }
-    return value();
+    return parseInteger<T>(readStringViewWhile(isIntegerChar));
 }
 
 ATokenizer::Hexable<unsigned> ATokenizer::readUIntX() {
-    mTemporaryAStringBuffer.clear();
-    bool isHex = false;
-    try {
-        char c;
-        for (;;)
-        {
-            c = readChar();
-            switch (c)
-            {
-                case 'x':
-                case 'X':
-                    isHex = true;
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
-
-                    // hex
-                case 'a':
-                case 'A':
-                case 'b':
-                case 'B':
-                case 'c':
-                case 'C':
-                case 'd':
-                case 'D':
-                case 'e':
-                case 'E':
-                case 'f':
-                case 'F':
-                    mTemporaryAStringBuffer << c;
-                    break;
-                default:
-                    reverseByte();
-                    return {mTemporaryAStringBuffer.toUInt().valueOr(0), isHex};
-            }
-        }
-    }
-    catch (...) {
-        mEof = true;
-    }
-    return {mTemporaryAStringBuffer.toUInt().valueOr(0), isHex};
+    auto token = readStringViewWhile([](char c) { return c != '-' && isIntegerChar(c); });
+    bool isHex = token.find_first_of("xX") != std::string_view::npos;
+    return { parseInteger<unsigned>(token), isHex };
 }
 
 void ATokenizer::skipUntilUnescaped(char c) {
@@ -258,21 +169,23 @@ const std::string& ATokenizer::readStringUntilUnescaped(const ASet<char>& charac
 void ATokenizer::readStringUntilUnescaped(std::string& out, char c)
 {
     try {
-        for (char current; (current = readChar()) != c;)
+        for (;;)
         {
-            if (current == '\\')
-            {
-                char tmp = readChar();
-                switch (tmp) {
-                    case 'r': out += '\r'; break;
-                    case 'n': out += '\n'; break;
-                    case 't': out += '\t'; break;
-                    default: out += tmp;
-                }
+            // copy the run of plain characters at once
+            out += readStringViewWhile([c](char current) { return current != c && current != '\\'; });
+            if (mEof) {
+                return;
             }
-            else
-            {
-                out += current;
+            char current = readChar();
+            if (current == c) {
+                return;
+            }
+            char tmp = readChar();
+            switch (tmp) {
+                case 'r': out += '\r'; break;
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                default: out += tmp;
             }
         }
     }
@@ -280,7 +193,6 @@ void ATokenizer::readStringUntilUnescaped(std::string& out, char c)
         mEof = true;
     }
 }
-
 void ATokenizer::readStringUntilUnescaped(std::string& out, const ASet<char>& characters) {
     try {
         for (char current; !characters.contains(current = readChar());)
@@ -320,7 +232,25 @@ const std::string& ATokenizer::readString(size_t n) {
 }
 
 void ATokenizer::skipUntil(char c) {
-    for (char x; (x = readChar()) != c; );
+    if (mReverse) {
+        if (readChar() == c) {
+            return;
+        }
+    }
+    for (;;) {
+        if (mBufferRead >= mBufferEnd && !refill()) {
+            throw AEOFException();
+        }
+        auto found = static_cast<const char*>(std::memchr(mBufferRead, c, mBufferEnd - mBufferRead));
+        if (found) {
+            advancePosition(mBufferRead, found);
+            mBufferRead = found;
+            readChar();
+            return;
+        }
+        advancePosition(mBufferRead, mBufferEnd);
+        mBufferRead = mBufferEnd;
+    }
 }
 
 unsigned ATokenizer::readUInt() {
@@ -16,14 +16,24 @@
 
 #pragma once
 
+#include <cstring>
+#include <string_view>
 #include <utility>
+#include "AUI/Common/AByteBufferView.h"
 #include "AUI/Common/SharedPtr.h"
 #include "AUI/IO/IInputStream.h"
 #include "AUI/Common/AString.h"
 #include "AUI/Common/AColor.h"
 #include "AUI/Common/ASet.h"
-
-class API_AUI_CORE ATokenizer
+#include "AUI/Traits/values.h"
+
+/**
+ * @brief Reads tokens from a stream or from the memory.
+ * @details
+ * The stream is read by blocks of 4 KiB. When constructed from AByteBufferView (or AString), the tokenizer reads the
+ * memory directly; then the <code>read*View</code> functions return slices of the input without copying.
+ */
+class API_AUI_CORE ATokenizer: public aui::noncopyable
 {
 
 public:
@@ -32,6 +42,12 @@ public:
     {
     }
 
+    /**
+     * @brief Reads the memory directly.
+     * @param buffer input. The buffer must outlive the tokenizer.
+     */
+    explicit ATokenizer(AByteBufferView buffer);
+
     bool isEof() const {
         return mEof;
     }
@@ -44,36 +60,85 @@ public:
      */
     const std::string& readString();
 
+    /**
+     * @brief Same as readString, but does not copy the string if possible.
+     * @return read string; points to the input buffer or to the tokenizer's buffer. Valid until the next read.
+     */
+    std::string_view readStringView();
+
     /**
      * @brief Reads string while pred(char) == true.
      * @return read string
      */
     template<aui::predicate<char> Callable>
     const std::string& readStringWhile(Callable pred) {
-        mTemporaryStringBuffer.clear();
-        char c;
+        mTemporaryStringBuffer = readStringViewWhile(std::move(pred));
+        return mTemporaryStringBuffer;
+    }
 
-        try
-        {
-            for (;;) {
-                c = readChar();
-                if (pred(c))
-                {
-                    mTemporaryStringBuffer.push_back(c);
-                }
-                else
-                {
-                    reverseByte();
-                    return mTemporaryStringBuffer;
+    /**
+     * @brief Reads string while pred(char) == true, without copying if possible.
+     * @return read string; points to the input buffer or to the tokenizer's buffer. Valid until the next read.
+     */
+    template<aui::predicate<char> Callable>
+    std::string_view readStringViewWhile(Callable pred) {
+        const char* begin;
+        if (mReverse) {
+            if (!pred(mLastByte)) {
+                return {};
+            }
+            // the reversed byte is the last byte of the buffer read
+            mReverse = false;
+            begin = mBufferRead - 1;
+        } else {
+            begin = mBufferRead;
+        }
+
+        bool spilled = false;
+        for (;;) {
+            const char* end = mBufferRead;
+            while (end != mBufferEnd && pred(*end)) {
+                ++end;
+            }
+            advancePosition(mBufferRead, end);
+            mBufferRead = end;
+            if (end != mBufferEnd) {
+                // the terminating character is read and reversed, as readChar + reverseByte would do
+                readChar();
+                reverseByte();
+                if (!spilled) {
+                    return { begin, std::size_t(end - begin) };
                 }
+                mSpillBuffer.append(begin, end);
+                return mSpillBuffer;
+            }
+
+            if (!mInput) {
+                // the end of the memory input; the whole token is in the memory
+                mEof = true;
+                return { begin, std::size_t(end - begin) };
             }
-        } catch (...)
-        {
 
+            // the token continues in the next block of the stream
+            if (!spilled) {
+                mSpillBuffer.clear();
+                spilled = true;
+            }
+            mSpillBuffer.append(begin, end);
+            if (!refill()) {
+                mEof = true;
+                return mSpillBuffer;
+            }
+            begin = mBufferRead;
         }
-        return mTemporaryStringBuffer;
     }
 
+    /**
+     * @brief Reads string until c, without copying if possible. c is read but is not included to the result.
+     * @return read string; points to the input buffer or to the tokenizer's buffer. Valid until the next read.
+     */
+    std::string_view readStringViewUntil(char c);
+
     /**
      * @brief Reads <code>n</code> symbols.
      * @return read string
@@ -99,9 +164,7 @@ public:
 
         if (mBufferRead >= mBufferEnd) {
             // read next blob
-            mBufferEnd = mBuffer + mInput->read(mBuffer, sizeof(mBuffer));
-            mBufferRead = mBuffer;
-            if (mBufferEnd == mBufferRead) {
+            if (!refill()) {
                 throw AEOFException();
             }
         }
@@ -233,12 +296,21 @@ public:
 
 private:
     _<IInputStream> mInput;
-    AString mTemporaryAStringBuffer;
     std::string mTemporaryStringBuffer;
 
+    /**
+     * @brief Token which does not fit into a single block of the stream.
+     */
+    std::string mSpillBuffer;
+
+    /**
+     * @brief Utf8 of the string the tokenizer was constructed from.
+     */
+    std::string mOwnedInput;
+
     char mBuffer[4096];
-    char* mBufferRead = nullptr;
-    char* mBufferEnd = nullptr;
+    const char* mBufferRead = nullptr;
+    const char* mBufferEnd = nullptr;
 
     char mLastByte;
     bool mReverse = false;
@@ -249,4 +321,22 @@ private:
 
     template<typename T>
     T readIntImpl();
+
+    /**
+     * @brief Reads the next block of the stream.
+     * @return false if there is no more data.
+     */
+    bool refill();
+
+    /**
+     * @brief Updates row and column counters with the characters consumed without readChar.
+     */
+    void advancePosition(const char* begin, const char* end) noexcept {
+        for (const char* newline; (newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin)));) {
+            mRow += 1;
+            mColumn = 1;
+            begin = newline + 1;
+        }
+        mColumn += int(end - begin);
+    }
 };
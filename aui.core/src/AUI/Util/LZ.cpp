@@ -16,19 +16,22 @@
 
 #include "LZ.h"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include "AUI/Common/AByteBuffer.h"
+#include "AUI/IO/AZlibCodec.h"
 
 #include <zlib.h>
 
 
-void LZ::compress(AByteBufferView b, AByteBuffer& dst)
+void LZ::compress(AByteBufferView b, AByteBuffer& dst, int level)
 {
-    uLong len = b.size() * 3 / 2 + 0xff;
+    uLong len = compressBound(b.size());
 	dst.reserve(dst.getSize() + len);
 	int r = compress2(reinterpret_cast<Bytef*>(const_cast<char*>(dst.end())), &len,
-                      reinterpret_cast<Bytef*>(const_cast<char*>(b.data())), b.size(), Z_BEST_COMPRESSION);
+                      reinterpret_cast<Bytef*>(const_cast<char*>(b.data())), b.size(), level);
 	if (r != Z_OK)
 	{
 		throw std::runtime_error(std::string("zlib compress error ") + std::to_string(r));
@@ -38,19 +41,58 @@ void LZ::compress(AByteBufferView b, AByteBuffer& dst)
 
 void LZ::decompress(AByteBufferView b, AByteBuffer& dst)
 {
-	for (size_t i = 4;; i++) {
-		dst.reserve(b.size() * i);
-        uLong len = dst.endReserved() - dst.end();
-		int r = uncompress(reinterpret_cast<Bytef*>(dst.end()), &len,
-                           reinterpret_cast<Bytef*>(const_cast<char*>(b.data())), b.size());
-		switch (r) {
-		case Z_BUF_ERROR:
-			continue;
-		case Z_OK:
-			dst.setSize(dst.getSize() + len);
-			return;
-		default:
-			throw AZLibException("zlib decompress error " + AString::number(r));
-		}
-	}
-}
\ No newline at end of file
+    auto decoder = AZlibCodec::inst()->makeDecoder();
+    const char* input = b.data();
+    const char* inputEnd = b.data() + b.size();
+    dst.ensureReserved(std::max(b.size() * 4, std::size_t(0x100)));
+    for (;;) {
+        char* output = dst.end();
+        bool done = decoder->decode(input, inputEnd, output, dst.endReserved());
+        dst.setSize(output - dst.data());
+        if (done) {
+            return;
+        }
+        if (output == dst.endReserved()) {
+            dst.ensureReserved(std::max(dst.getSize(), std::size_t(0x100)));
+        } else if (input == inputEnd) {
+            throw AZLibException("zlib decompress error: truncated data");
+        }
+    }
+}
+
+void LZ::compressFrame(AByteBufferView b, AByteBuffer& dst, int level)
+{
+    dst << std::uint64_t(b.size());
+    compress(b, dst, level);
+}
+
+void LZ::decompressFrame(AByteBufferView frame, AByteBuffer& dst)
+{
+    std::uint64_t size;
+    if (frame.size() < sizeof(size)) {
+        throw AZLibException("zlib frame is too short");
+    }
+    std::memcpy(&size, frame.data(), sizeof(size));
+
+    auto decoder = AZlibCodec::inst()->makeDecoder();
+    const char* input = frame.data() + sizeof(size);
+    const char* inputEnd = frame.data() + frame.size();
+    if (dst.getAvailableToWrite() < size) {
+        dst.reserve(dst.getSize() + size);
+    }
+    char* output = dst.end();
+    char* outputEnd = output + size;
+    for (bool done = false; !done;) {
+        auto previousInput = input;
+        auto previousOutput = output;
+        done = decoder->decode(input, inputEnd, output, outputEnd);
+        if (!done && input == previousInput && output == previousOutput) {
+            // either the data is truncated or it does not fit into the declared size
+            throw AZLibException("zlib frame size mismatch");
+        }
+    }
+    if (output != outputEnd) {
+        throw AZLibException("zlib frame size mismatch");
+    }
+    dst.setSize(dst.getSize() + size);
+}
@@ -35,7 +35,38 @@ public:
 	}
 };
 
+/**
+ * @brief zlib compression of whole buffers.
+ * @details
+ * See ACompressedInputStream and ACompressedOutputStream for streaming compression.
+ */
 namespace LZ {
-	void API_AUI_CORE compress(AByteBufferView b, AByteBuffer& dst);
+    /**
+     * @brief Compresses the buffer and appends the compressed data to dst.
+     * @param level 0 (no compression) to 9 (best compression).
+     */
+	void API_AUI_CORE compress(AByteBufferView b, AByteBuffer& dst, int level = 9);
+
+    /**
+     * @brief Decompresses the buffer and appends the decompressed data to dst.
+     * @details
+     * The decompressed size is not known in advance, so dst is grown geometrically. Prefer compressFrame and
+     * decompressFrame for new data.
+     */
 	void API_AUI_CORE decompress(AByteBufferView b, AByteBuffer& dst);
+
+    /**
+     * @brief Compresses the buffer prefixed by its size and appends the frame to dst.
+     * @details
+     * The frame is the uncompressed size (uint64_t, as written by AUI serialization) followed by the zlib data.
+     */
+    void API_AUI_CORE compressFrame(AByteBufferView b, AByteBuffer& dst, int level = 9);
+
+    /**
+     * @brief Decompresses the frame written by compressFrame and appends the data to dst.
+     * @details
+     * dst is reallocated at most once.
+     * @throws AZLibException if the frame is malformed.
+     */
+    void API_AUI_CORE decompressFrame(AByteBufferView frame, AByteBuffer& dst);
 }
@@ -0,0 +1,124 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/Util/ABuiltinFiles.h>
+#include <AUI/Util/LZ.h>
+
+namespace {
+    AByteBufferView asBytes(std::string_view str) {
+        return AByteBufferView(str);
+    }
+}
+
+TEST(BuiltinFiles, IndexedLazy) {
+    std::string compressible(10000, 'z');
+    const char incompressible[] = "\x01\x7f\x33\xa0";
+
+    // the packed data must outlive the application
+    static auto packed = ABuiltinFiles::pack({
+        { "builtin-test/b.txt", asBytes(compressible) },
+        { "builtin-test/a.bin", AByteBufferView(incompressible, sizeof(incompressible) - 1) },
+        { "builtin-test/empty", {} },
+    });
+    EXPECT_LT(packed.size(), compressible.size());
+    ABuiltinFiles::load(reinterpret_cast<const unsigned char*>(packed.data()), packed.size());
+
+    auto stored = ABuiltinFiles::getBuffer("builtin-test/a.bin");
+    ASSERT_TRUE(stored);
+    EXPECT_EQ(std::string_view(stored->data(), stored->size()), std::string_view(incompressible, 4));
+    // stored entries are not copied
+    EXPECT_GE(stored->data(), packed.data());
+    EXPECT_LT(stored->data(), packed.data() + packed.size());
+
+    auto decompressed = ABuiltinFiles::getBuffer("builtin-test/b.txt");
+    ASSERT_TRUE(decompressed);
+    EXPECT_EQ(std::string_view(decompressed->data(), decompressed->size()), compressible);
+    // decompressed once
+    EXPECT_EQ(ABuiltinFiles::getBuffer("builtin-test/b.txt")->data(), decompressed->data());
+
+    EXPECT_EQ(ABuiltinFiles::getBuffer("builtin-test/empty")->size(), 0);
+    EXPECT_FALSE(ABuiltinFiles::getBuffer("builtin-test/missing"));
+    EXPECT_EQ(ABuiltinFiles::open("builtin-test/missing"), nullptr);
+
+    char buf[16];
+    EXPECT_EQ(ABuiltinFiles::open("builtin-test/a.bin")->read(buf, sizeof(buf)), 4);
+}
+
+TEST(BuiltinFiles, LegacyFormat) {
+    AByteBuffer blob;
+    blob << aui::serialize_sized(std::string("builtin-test/legacy.txt"));
+    blob << aui::serialize_sized(AByteBuffer::fromString("legacy"));
+    AByteBuffer compressed;
+    LZ::compress(blob, compressed);
+    ABuiltinFiles::load(reinterpret_cast<const unsigned char*>(compressed.data()), compressed.size());
+
+    auto buffer = ABuiltinFiles::getBuffer("builtin-test/legacy.txt");
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(std::string_view(buffer->data(), buffer->size()), "legacy");
+
+    // the file loaded last wins
+    static auto packed = ABuiltinFiles::pack({ { "builtin-test/legacy.txt", asBytes("indexed") } });
+    ABuiltinFiles::load(reinterpret_cast<const unsigned char*>(packed.data()), packed.size());
+    buffer = ABuiltinFiles::getBuffer("builtin-test/legacy.txt");
+    EXPECT_EQ(std::string_view(buffer->data(), buffer->size()), "indexed");
+}
+
+TEST(BuiltinFiles, IdenticalContentsStoredOnce) {
+    std::string contents(5000, 'q');
+    for (int i = 0; i < 5000; i += 7) contents[i] = char('a' + i % 26);
+
+    auto single = ABuiltinFiles::pack({ { "builtin-test/dup1.txt", asBytes(contents) } });
+    static auto packed = ABuiltinFiles::pack({
+        { "builtin-test/dup1.txt", asBytes(contents) },
+        { "builtin-test/dup2.txt", asBytes(std::string(contents)) },
+    });
+    // the second copy costs its index record and path only
+    EXPECT_LT(packed.size(), single.size() + 64);
+    ABuiltinFiles::load(reinterpret_cast<const unsigned char*>(packed.data()), packed.size());
+
+    for (const auto& path : { "builtin-test/dup1.txt", "builtin-test/dup2.txt" }) {
+        auto buffer = ABuiltinFiles::getBuffer(path);
+        ASSERT_TRUE(buffer);
+        EXPECT_EQ(std::string_view(buffer->data(), buffer->size()), contents);
+    }
+}
+
+TEST(BuiltinFiles, PackCompressed) {
+    std::string contents;
+    for (unsigned i = 0; contents.size() < 4000; i = i * 1103515245 + 12345) {
+        contents += char('a' + (i >> 16) % 16);
+    }
+    auto entry = ABuiltinFiles::compressEntry(asBytes(contents));
+    EXPECT_TRUE(entry.compressed);
+    EXPECT_LT(entry.data.size(), contents.size());
+    EXPECT_FALSE(ABuiltinFiles::compressEntry(asBytes("abc")).compressed);
+
+    auto single = ABuiltinFiles::packCompressed({ { "builtin-test/precompressed-a", entry.data, entry.compressed } });
+    static auto packed = ABuiltinFiles::packCompressed({
+        { "builtin-test/precompressed-b", entry.data, entry.compressed },
+        { "builtin-test/precompressed-a", entry.data, entry.compressed },
+    });
+    // both entries refer to the same data
+    EXPECT_LT(packed.size(), single.size() + 64);
+    ABuiltinFiles::load(reinterpret_cast<const unsigned char*>(packed.data()), packed.size());
+    for (const auto& path : { "builtin-test/precompressed-a", "builtin-test/precompressed-b" }) {
+        auto buffer = ABuiltinFiles::getBuffer(path);
+        ASSERT_TRUE(buffer);
+        EXPECT_EQ(std::string_view(buffer->data(), buffer->size()), contents);
+    }
+}
@@ -0,0 +1,110 @@
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/IO/ACompressedInputStream.h>
+#include <AUI/IO/ACompressedOutputStream.h>
+#include <AUI/IO/AByteBufferInputStream.h>
+#include <AUI/IO/AIOException.h>
+#include <AUI/Util/LZ.h>
+
+namespace {
+    AByteBuffer compressionTestData(std::size_t size) {
+        AByteBuffer data;
+        for (std::size_t i = 0; data.size() < size; ++i) {
+            auto line = "line " + std::to_string(i % 1000) + "\n";
+            data.write(line.data(), std::min(line.size(), size - data.size()));
+        }
+        return data;
+    }
+}
+
+TEST(Compression, StreamRoundTrip) {
+    for (int level : { 0, 1, ICompressionCodec::DEFAULT_LEVEL, 9 }) {
+        auto data = compressionTestData(200000);
+        auto compressed = _new<AByteBuffer>();
+        {
+            ACompressedOutputStream os(compressed, level);
+            // uneven writes
+            for (std::size_t i = 0; i < data.size();) {
+                auto size = std::min<std::size_t>(i % 7000 + 1, data.size() - i);
+                os.write(data.data() + i, size);
+                i += size;
+            }
+        }
+        if (level != 0) {
+            EXPECT_LT(compressed->size(), data.size() / 4);
+        }
+
+        // compatible with LZ
+        AByteBuffer decompressed;
+        LZ::decompress(*compressed, decompressed);
+        EXPECT_EQ(decompressed, data);
+
+        ACompressedInputStream is(_new<AByteBufferInputStream>(*compressed));
+        EXPECT_EQ(AByteBuffer::fromStream(is), data);
+    }
+}
+
+TEST(Compression, HighlyCompressible) {
+    AByteBuffer data;
+    data.resize(64 * 1024 * 1024);
+    std::memset(data.data(), 'a', data.size());
+    AByteBuffer compressed;
+    LZ::compress(data, compressed);
+    EXPECT_LT(compressed.size(), 128 * 1024);
+
+    AByteBuffer decompressed;
+    LZ::decompress(compressed, decompressed);
+    EXPECT_EQ(decompressed, data);
+}
+
+TEST(Compression, Frames) {
+    auto data = compressionTestData(100000);
+    AByteBuffer frame;
+    LZ::compressFrame(data, frame, 6);
+
+    AByteBuffer decompressed;
+    LZ::decompressFrame(frame, decompressed);
+    EXPECT_EQ(decompressed, data);
+    EXPECT_EQ(decompressed.capacity(), data.size());
+
+    EXPECT_THROW(LZ::decompressFrame(frame.slice(0, frame.size() / 2), decompressed), AZLibException);
+    EXPECT_THROW(LZ::decompressFrame(frame.slice(0, 4), decompressed), AZLibException);
+
+    // declared size is smaller than the actual data
+    auto wrongSize = frame;
+    wrongSize.at<std::uint64_t>(0) = data.size() - 1;
+    EXPECT_THROW(LZ::decompressFrame(wrongSize, decompressed), AZLibException);
+}
+
+TEST(Compression, Errors) {
+    auto data = compressionTestData(100000);
+    AByteBuffer compressed;
+    LZ::compress(data, compressed);
+
+    AByteBuffer decompressed;
+    EXPECT_THROW(LZ::decompress(compressed.slice(0, compressed.size() / 2), decompressed), AZLibException);
+    EXPECT_THROW(LZ::decompress(AByteBufferView("garbage", 7), decompressed), AZLibException);
+
+    ACompressedInputStream is(_new<AByteBufferInputStream>(compressed.slice(0, compressed.size() / 2)));
+    EXPECT_THROW(AByteBuffer::fromStream(is), AIOException);
+
+    auto os = _new<ACompressedOutputStream>(_new<AByteBuffer>());
+    os->finish();
+    EXPECT_THROW(os->write("a", 1), AIOException);
+}
@@ -23,6 +23,9 @@
 #include <AUI/IO/APath.h>
 #include <AUI/IO/AFileOutputStream.h>
 #include <AUI/IO/AFileInputStream.h>
+#include <AUI/IO/AMappedFile.h>
+#include <AUI/IO/AIOException.h>
+#include <AUI/Common/AByteBuffer.h>
 
 
 TEST(Path, Unix) {
@@ -59,3 +62,32 @@ TEST(Path, Windows) {
     }
     ASSERT_EQ(APath("C:/home/user/file.txt").filename(), "file.txt");
 }
+
+TEST(Path, MappedFile) {
+    std::string contents(10000, 'a');
+    contents += "end";
+    AFileOutputStream("test-mapped.txt").write(contents.data(), contents.size());
+
+    {
+        AMappedFile file("test-mapped.txt");
+        ASSERT_EQ(file.size(), contents.size());
+        EXPECT_EQ(std::string_view(file.data(), file.size()), contents);
+        file.advise(AMappedFile::Access::RANDOM, 4000, 100);
+        file.advise(AMappedFile::Access::WILL_NEED);
+    }
+    {
+        // changes of the copy-on-write mapping are not written to the file
+        AMappedFile file("test-mapped.txt", AMappedFile::Mode::COPY_ON_WRITE);
+        file.mutableData()[0] = 'b';
+        EXPECT_EQ(file.data()[0], 'b');
+        EXPECT_EQ(AMappedFile("test-mapped.txt").data()[0], 'a');
+    }
+    {
+        auto buffer = AByteBuffer::fromStream(AMappedFileInputStream("test-mapped.txt"));
+        EXPECT_EQ(std::string_view(buffer.data(), buffer.size()), contents);
+    }
+
+    AFileOutputStream("test-mapped-empty.txt");
+    EXPECT_TRUE(AMappedFile("test-mapped-empty.txt").empty());
+    EXPECT_THROW(AMappedFile("test-mapped-missing.txt"), AIOException);
+}
@@ -0,0 +1,237 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+#include <AUI/Logging/ALogger.h>
+#include <AUI/Logging/ABinaryLogger.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/IO/AFileInputStream.h>
+#include <AUI/IO/AByteBufferInputStream.h>
+#include <AUI/IO/APath.h>
+#include <AUI/Thread/AThreadPool.h>
+#include <AUI/Util/kAUI.h>
+#include <cstring>
+
+namespace {
+    std::size_t countLines(const APath& path, std::string_view needle) {
+        auto buffer = AByteBuffer::fromStream(AFileInputStream(path));
+        std::string_view contents(buffer.data(), buffer.size());
+        std::size_t result = 0;
+        for (std::size_t i = contents.find(needle); i != std::string_view::npos; i = contents.find(needle, i + 1)) {
+            ++result;
+        }
+        return result;
+    }
+}
+
+TEST(Logger, Async) {
+    auto path = APath::getDefaultPath(APath::TEMP) / "aui.logger.async.test.log";
+    {
+        ALogger logger(path);
+        logger.setAsync(true);
+        ASSERT_TRUE(logger.isAsync());
+
+        AFutureSet<> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads << asyncX [&logger, t] {
+                for (int i = 0; i < 50; ++i) {
+                    logger.log(ALogger::INFO, "AsyncTest") << "thread " << t << " entry " << i;
+                }
+            };
+        }
+        threads.waitForAll();
+        logger.flush();
+        EXPECT_EQ(countLines(path, "[AsyncTest][INFO]"), 200);
+
+        logger.log(ALogger::INFO, "AsyncTest") << "pending";
+        logger.setAsync(false); // writes the pending entries
+        EXPECT_FALSE(logger.isAsync());
+        EXPECT_EQ(countLines(path, "[AsyncTest][INFO]"), 201);
+
+        logger.log(ALogger::INFO, "AsyncTest") << "sync";
+        EXPECT_EQ(countLines(path, "[AsyncTest][INFO]"), 202);
+    }
+    path.removeFile();
+}
+
+TEST(Logger, AsyncDrop) {
+    auto path = APath::getDefaultPath(APath::TEMP) / "aui.logger.drop.test.log";
+    {
+        ALogger logger(path);
+        ALogger::AsyncParams params;
+        params.bufferSize = 1024;
+        params.flushInterval = std::chrono::hours(1);
+        params.flushThreshold = std::numeric_limits<std::size_t>::max();
+        params.overflow = ALogger::AsyncParams::OVERFLOW_DROP;
+        logger.setAsync(true, params);
+
+        for (int i = 0; i < 100; ++i) {
+            logger.log(ALogger::INFO, "DropTest") << "entry " << i;
+        }
+        logger.flush();
+        auto written = countLines(path, "[DropTest][INFO]");
+        EXPECT_GT(written, 0);
+        EXPECT_LT(written, 100);
+        EXPECT_EQ(countLines(path, "entries dropped"), 1);
+    }
+    path.removeFile();
+}
+
+TEST(Logger, AsyncLongEntry) {
+    auto path = APath::getDefaultPath(APath::TEMP) / "aui.logger.long.test.log";
+    {
+        ALogger logger(path);
+        logger.setAsync(true);
+        // does not fit into the LogWriter's stack buffer
+        logger.log(ALogger::INFO, "LongTest") << std::string(4096, 'x');
+        logger.flush();
+        EXPECT_EQ(countLines(path, "[LongTest][INFO]"), 1);
+    }
+    auto buffer = AByteBuffer::fromStream(AFileInputStream(path));
+    EXPECT_EQ(std::string_view(buffer.data(), buffer.size()).find('\0'), std::string_view::npos);
+    path.removeFile();
+}
+
+TEST(Logger, AsyncRestartWithOtherParams) {
+    auto path = APath::getDefaultPath(APath::TEMP) / "aui.logger.restart.test.log";
+    {
+        ALogger logger(path);
+        ALogger::AsyncParams params;
+        params.bufferSize = 256;
+        params.flushInterval = std::chrono::hours(1);
+        params.flushThreshold = std::numeric_limits<std::size_t>::max();
+        params.overflow = ALogger::AsyncParams::OVERFLOW_DROP;
+        logger.setAsync(true, params);
+        logger.log(ALogger::INFO, "RestartTest") << "small";
+        logger.setAsync(false);
+
+        // the ring of this thread must be recreated with the new size
+        params.bufferSize = 65536;
+        logger.setAsync(true, params);
+        for (int i = 0; i < 100; ++i) {
+            logger.log(ALogger::INFO, "RestartTest") << "entry " << i;
+        }
+        logger.flush();
+        EXPECT_EQ(countLines(path, "[RestartTest][INFO]"), 101);
+        EXPECT_EQ(countLines(path, "entries dropped"), 0);
+    }
+    path.removeFile();
+}
+
+TEST(Logger, MinLevel) {
+    auto path = APath::getDefaultPath(APath::TEMP) / "aui.logger.minlevel.test.log";
+    {
+        ALogger logger(path);
+        int formatted = 0;
+        auto count = [&] { ++formatted; return formatted; };
+
+        logger.setMinLevel(ALogger::WARN);
+        EXPECT_FALSE(logger.isEnabled(ALogger::DEBUG));
+        EXPECT_FALSE(logger.isEnabled(ALogger::INFO));
+        EXPECT_TRUE(logger.isEnabled(ALogger::WARN));
+        EXPECT_TRUE(logger.isEnabled(ALogger::ERR));
+
+        logger.log(ALogger::DEBUG, "MinLevelTest") << "skipped";
+        logger.log(ALogger::INFO, "MinLevelTest") << "skipped";
+        logger.log(ALogger::WARN, "MinLevelTest") << "written " << count();
+        logger.log(ALogger::ERR, "MinLevelTest") << "written " << count();
+        EXPECT_EQ(countLines(path, "[MinLevelTest]"), 2);
+        EXPECT_EQ(countLines(path, "skipped"), 0);
+
+        // the arguments are not even evaluated by the macros
+        ALogger::global().setMinLevel(ALogger::ERR);
+        ALOG_INFO("MinLevelTest") << count();
+        ALOG_DEBUG("MinLevelTest") << count();
+        ALogger::global().setMinLevel(ALogger::DEBUG);
+        EXPECT_EQ(formatted, 2);
+    }
+    path.removeFile();
+}
+
+TEST(Logger, Binary) {
+    static constexpr auto LOG_TAG = "BinaryTest";
+    auto output = _new<AByteBuffer>();
+    {
+        ABinaryLogger logger(output);
+        logger.setMinLevel(ALogger::INFO);
+        ALOG_BINARY(logger, INFO, LOG_TAG, "int {} uint {} double {:.2f} bool {}", -42, 42u, 3.14159, true);
+        ALOG_BINARY(logger, DEBUG, LOG_TAG, "skipped {}", 1);
+        for (int i = 0; i < 3; ++i) {
+            ALOG_BINARY(logger, WARN, LOG_TAG, "string {} char {} AString {}", "hello", 'c', AString("world"));
+        }
+        (asyncX [&logger] {
+            ALOG_BINARY(logger, ERR, LOG_TAG, "from another thread");
+        }).wait();
+    }
+
+    AByteBuffer text;
+    AByteBufferInputStream input(*output);
+    ABinaryLogger::decode(input, text);
+    std::string_view decoded(text.data(), text.size());
+    EXPECT_NE(decoded.find("[BinaryTest][INFO]: int -42 uint 42 double 3.14 bool true\n"), std::string_view::npos) << decoded;
+    EXPECT_EQ(decoded.find("skipped"), std::string_view::npos) << decoded;
+    EXPECT_NE(decoded.find("[BinaryTest][ERR]: from another thread\n"), std::string_view::npos) << decoded;
+    std::size_t repeated = 0;
+    for (auto i = decoded.find("[BinaryTest][WARN]: string hello char c AString world\n"); i != std::string_view::npos;
+         i = decoded.find("[BinaryTest][WARN]", i + 1)) {
+        ++repeated;
+    }
+    EXPECT_EQ(repeated, 3);
+
+    // the format string is stored once
+    std::string_view raw(output->data(), output->size());
+    EXPECT_EQ(raw.find("string {}"), raw.rfind("string {}"));
+
+    AByteBuffer truncated;
+    truncated.write(output->data(), output->size() - 3);
+    AByteBufferInputStream truncatedInput(truncated);
+    AByteBuffer ignored;
+    EXPECT_THROW(ABinaryLogger::decode(truncatedInput, ignored), AException);
+}
+
+TEST(Logger, BinaryCorruptedStringLength) {
+    auto output = _new<AByteBuffer>();
+    {
+        ABinaryLogger logger(output);
+        ALOG_BINARY(logger, INFO, "BinaryTest", "string {}", "abc");
+    }
+
+    // the log ends with the string argument: 4 byte length followed by "abc"; claim 4 GiB and drop the data
+    std::string raw(output->data(), output->size());
+    auto data = raw.rfind("abc");
+    ASSERT_NE(data, std::string::npos);
+    raw.resize(data);
+    std::memset(raw.data() + data - 4, 0xff, 4);
+
+    AByteBuffer corrupted;
+    corrupted.write(raw.data(), raw.size());
+    AByteBufferInputStream input(corrupted);
+    AByteBuffer ignored;
+    EXPECT_THROW(ABinaryLogger::decode(input, ignored), AException);
+}
+
+TEST(Logger, BinaryMacroIsStatement) {
+    auto output = _new<AByteBuffer>();
+    ABinaryLogger logger(output);
+    logger.setMinLevel(ALogger::INFO);
+    bool elseTaken = false;
+    if (true)
+        ALOG_BINARY(logger, DEBUG, "BinaryTest", "filtered out");
+    else
+        elseTaken = true;
+    EXPECT_FALSE(elseTaken);
+}
@@ -139,3 +139,49 @@ TEST(Scheduler, TimerCancellation) {
         1000ms,
     });
 }
+
+namespace {
+    /**
+     * Scheduler running on a fake clock, so the tasks enqueued with equal timeouts get exactly equal execution times.
+     */
+    class FakeClockScheduler: public AScheduler {
+    public:
+        TimePoint now = TimePoint(1h);
+
+    protected:
+        TimePoint currentTime() const noexcept override {
+            return now;
+        }
+    };
+}
+
+TEST(Scheduler, EnqueueOrderAndCancellation) {
+    FakeClockScheduler scheduler;
+    AVector<int> order;
+    AVector<AScheduler::TimerHandle> handles;
+    for (int i = 0; i < 100; ++i) {
+        // reversed timeouts; each 10 consecutive tasks share the same execution time
+        handles << scheduler.enqueue(std::chrono::milliseconds(1 + (99 - i) / 10), [&, i] { order << i; });
+    }
+    for (int i = 0; i < 100; i += 3) {
+        scheduler.removeTimer(handles[i]);
+    }
+
+    // nothing is expired yet
+    EXPECT_FALSE(scheduler.iteration(ASchedulerIteration::DONT_BLOCK));
+    EXPECT_TRUE(order.empty());
+
+    scheduler.now += 1s;
+    while (!scheduler.emptyTasks()) {
+        scheduler.iteration(ASchedulerIteration::DONT_BLOCK);
+    }
+
+    AVector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) continue;
+        expected << i;
+    }
+    // tasks with equal execution time are executed in the enqueue order
+    std::stable_sort(expected.begin(), expected.end(), [](int l, int r) { return (99 - l) / 10 < (99 - r) / 10; });
+    EXPECT_EQ(order, expected);
+}
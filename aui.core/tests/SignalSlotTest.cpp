@@ -19,6 +19,7 @@
 //
 
 
+#include <array>
 #include <gtest/gtest.h>
 #include <AUI/Common/AObject.h>
 #include <AUI/Common/ASignal.h>
@@ -291,3 +292,134 @@ TEST_F(SignalSlot, ObjectRemovalMultithread) {
     }
 }
 
+/**
+ * Checks that the coalescing signal delivers only the latest arguments of the emissions queued to the receiver's
+ * thread.
+ */
+TEST_F(SignalSlot, CrossThreadCoalescing) {
+    class Emitter: public AObject {
+    public:
+        Emitter() {
+            progress.setCrossThreadCoalescing(true);
+        }
+
+        void notify(int value) {
+            emit progress(value);
+        }
+
+    signals:
+        emits<int> progress;
+    };
+
+    class Receiver: public AObject {
+    public:
+        Receiver() {
+            setSlotsCallsOnlyOnMyThread(true);
+        }
+
+        int calls = 0;
+        int lastValue = -1;
+    };
+
+    static constexpr int EMISSIONS = 10'000;
+    auto emitter = _new<Emitter>();
+    auto receiver = _new<Receiver>();
+    AObject::connect(emitter->progress, receiver, [receiver = receiver.get()](int value) {
+        EXPECT_GT(value, receiver->lastValue);
+        receiver->calls += 1;
+        receiver->lastValue = value;
+    });
+
+    auto task = async {
+        for (int i = 0; i < EMISSIONS; ++i) {
+            emitter->notify(i);
+        }
+    };
+    task.wait();
+    AThread::processMessages();
+
+    EXPECT_EQ(receiver->lastValue, EMISSIONS - 1);
+    EXPECT_GE(receiver->calls, 1);
+    EXPECT_LT(receiver->calls, EMISSIONS);
+}
+
+
+/**
+ * Checks that the objects connected to a moved signal are relinked to the new signal, so destruction of either end
+ * breaks the connection.
+ */
+TEST_F(SignalSlot, MoveSignal) {
+    slave = _new<Slave>();
+    AObject::connect(master->message, slave, [&](const AString& msg) { slave->acceptMessage(msg); });
+
+    auto moved = std::make_unique<emits<AString>>(std::move(master->message));
+    EXPECT_FALSE(master->message);
+    EXPECT_TRUE(*moved);
+
+    EXPECT_CALL(*slave, acceptMessage(AString("hello")));
+    (*moved)("hello").invokeSignal(master.get());
+
+    // the slave unlinks itself from the new signal
+    EXPECT_CALL(*slave, die());
+    slave = nullptr;
+    EXPECT_FALSE(*moved);
+
+    // the new signal unlinks itself from the objects on destruction
+    auto other = _new<Slave>();
+    AObject::connect(*moved, other, [](const AString&) {});
+    moved = nullptr;
+    EXPECT_CALL(*other, die());
+    other = nullptr;
+}
+
+/**
+ * Checks slots whose callables do not fit in the slot's inline storage.
+ */
+TEST_F(SignalSlot, LargeCallable) {
+    slave = _new<Slave>();
+    std::array<AString, 8> captured;
+    captured.fill("captured");
+    AObject::connect(master->message, slave, [&, captured](const AString& msg) {
+        EXPECT_EQ(captured.back(), "captured");
+        slave->acceptMessage(msg);
+    });
+    AObject::connect(master->message, slave, [&, captured](const AString& msg) {
+        slave->acceptMessage(msg + captured.front());
+    });
+
+    EXPECT_CALL(*slave, acceptMessage(AString("hello")));
+    EXPECT_CALL(*slave, acceptMessage(AString("hellocaptured")));
+    master->broadcastMessage("hello");
+
+    EXPECT_CALL(*slave, die());
+}
+
+/**
+ * Checks that a cross-thread call queued before the signal's destruction is still delivered and is able to disconnect
+ * itself.
+ */
+TEST_F(SignalSlot, QueuedCallOutlivesSignal) {
+    class Receiver: public AObject {
+    public:
+        Receiver() {
+            setSlotsCallsOnlyOnMyThread(true);
+        }
+
+        AString received;
+    };
+
+    auto receiver = _new<Receiver>();
+    AObject::connect(master->message, receiver, [receiver = receiver.get()](const AString& msg) {
+        receiver->received = msg;
+        AObject::disconnect();
+    });
+
+    auto task = async {
+        master->broadcastMessage("hello");
+        master = nullptr;
+    };
+    task.wait();
+    AThread::processMessages();
+
+    EXPECT_EQ(receiver->received, "hello");
+}
@@ -20,6 +20,13 @@
 
 #include <gtest/gtest.h>
 #include <AUI/Common/AString.h>
+#include <AUI/Common/AUtf8.h>
+#include <AUI/Common/AUtf8String.h>
+#include <AUI/Common/AStringAtom.h>
+#include <AUI/Thread/AThreadPool.h>
+#include <AUI/Util/kAUI.h>
+#include <AUI/IO/APath.h>
+#include <AUI/Common/AByteBuffer.h>
 
 
 TEST(Strings, ToInt) {
@@ -86,3 +93,134 @@ TEST(Strings, ReplaceAll7) {
 TEST(Strings, ReplaceAll8) {
     EXPECT_EQ("abcdef"_as.replaceAll("bcd", ""), "aef");
 }
+
+TEST(Strings, Utf8Roundtrip) {
+    // 1, 2, 3 and 4 byte sequences
+    std::string utf8 = "a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80z";
+    AString decoded = utf8;
+    if constexpr (sizeof(wchar_t) == 4) {
+        EXPECT_EQ(decoded, AString(L"a\u00e9\u4e2d\U0001F600z"));
+    } else {
+        EXPECT_EQ(decoded.length(), 6); // surrogate pair
+    }
+    EXPECT_EQ(decoded.toStdString(), utf8);
+    auto buffer = decoded.toUtf8();
+    EXPECT_EQ(std::string_view(buffer.data(), buffer.size()), utf8);
+    EXPECT_TRUE(aui::utf8::isValid(utf8));
+
+    // non-ASCII character at every position around the vectorized blocks
+    for (std::size_t length = 0; length < 80; ++length) {
+        for (std::size_t position = 0; position < length; ++position) {
+            std::string input(length, 'x');
+            input.replace(position, 1, "\xd0\xaf");
+            AString s = input;
+            ASSERT_EQ(s.length(), length);
+            ASSERT_EQ(s[position], L'\u042f');
+            ASSERT_EQ(s.toStdString(), input);
+        }
+    }
+}
+
+TEST(Strings, Utf8Invalid) {
+    auto decode = [](std::string_view s) {
+        return AString::fromUtf8(s.data(), s.size());
+    };
+    const AString R(1, aui::utf8::REPLACEMENT_CHARACTER);
+
+    EXPECT_EQ(decode("a\x80" "b"), "a" + R + "b");            // lone continuation byte
+    EXPECT_EQ(decode("a\xc0\xaf" "b"), "a" + R + R + "b");     // overlong
+    EXPECT_EQ(decode("a\xe0\x80\xaf" "b"), "a" + R + R + R + "b");
+    EXPECT_EQ(decode("a\xed\xa0\x80" "b"), "a" + R + R + R + "b"); // encoded surrogate
+    EXPECT_EQ(decode("a\xf4\x90\x80\x80" "b"), "a" + R + R + R + R + "b"); // above U+10FFFF
+    EXPECT_EQ(decode("a\xe4\xb8" "b"), "a" + R + "b");        // truncated sequence
+    EXPECT_EQ(decode("a\xf0\x9f\x98"), "a" + R);
+
+    EXPECT_FALSE(aui::utf8::isValid("a\xe4\xb8"));
+    EXPECT_FALSE(aui::utf8::isValid("\xed\xa0\x80"));
+    EXPECT_FALSE(aui::utf8::isValid(std::string(100, 'a') + "\xff"));
+    EXPECT_EQ(aui::utf8::asciiPrefixLength(std::string(100, 'a') + "\xff"), 100);
+
+    // unpaired surrogates and invalid code points are encoded as U+FFFD
+    AString invalid;
+    invalid.push_back(wchar_t(0xd800));
+    invalid.push_back(L'a');
+    EXPECT_EQ(invalid.toStdString(), "\xef\xbf\xbd" "a");
+}
+
+TEST(Strings, Utf8String) {
+    AUtf8String s = "  caf\xc3\xa9, \xe4\xb8\xad, \xf0\x9f\x98\x80  ";
+    EXPECT_EQ(s.size(), 20);
+    EXPECT_EQ(s.codePointCount(), 14);
+    EXPECT_TRUE(s.isValidUtf8());
+
+    // zero-copy interop
+    std::string_view view = s;
+    EXPECT_EQ(view.data(), s.data());
+    EXPECT_EQ(s.bytes().data(), s.data());
+    EXPECT_EQ(s.toStdString().data(), s.data());
+
+    auto trimmed = s.trim();
+    EXPECT_EQ(trimmed, "caf\xc3\xa9, \xe4\xb8\xad, \xf0\x9f\x98\x80");
+    EXPECT_TRUE(trimmed.startsWith("caf"));
+    EXPECT_TRUE(trimmed.endsWith("\xf0\x9f\x98\x80"));
+    EXPECT_TRUE(trimmed.contains("\xe4\xb8\xad"));
+    EXPECT_EQ(trimmed.split(',').size(), 3);
+    EXPECT_EQ(trimmed.replacedAll(", ", "|"), "caf\xc3\xa9|\xe4\xb8\xad|\xf0\x9f\x98\x80");
+
+    // conversions to and from AString; decoding is explicit
+    static_assert(!std::is_convertible_v<AUtf8String, AString>);
+    static_assert(std::is_convertible_v<AString, AUtf8String>);
+    AString wide = trimmed.toAString();
+    EXPECT_EQ(AString(trimmed), wide);
+    EXPECT_EQ(wide.toStdString(), trimmed.toStdString());
+    AUtf8String back = wide;
+    EXPECT_EQ(back, trimmed);
+
+    EXPECT_EQ(AUtf8String("Hello").uppercase(), "HELLO");
+    EXPECT_EQ(AUtf8String("\xc3\x89" "COLE").lowercase(), AString(L"\u00e9cole").toStdString());
+    EXPECT_EQ(AUtf8String("-123").toInt(), -123);
+    EXPECT_EQ(AUtf8String("0x1f").toInt(), 0x1f);
+    EXPECT_EQ(AUtf8String::number(42), "42");
+    EXPECT_EQ(AUtf8String("{} + {}").format(1, "2"), "1 + 2");
+    EXPECT_EQ(fmt::format("[{}]", AUtf8String("x")), "[x]");
+
+    APath path = AUtf8String("dir\\file.txt");
+    EXPECT_EQ(path, "dir/file.txt");
+}
+
+TEST(Strings, Atom) {
+    AStringAtom a("button");
+    AStringAtom b(AString("button"));
+    AStringAtom c("label");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(&a.str(), &b.str()); // shared entry
+    EXPECT_EQ(a.str(), "button");
+    EXPECT_EQ(a, "button");
+    EXPECT_TRUE(AStringAtom().empty());
+    EXPECT_EQ(AStringAtom(), AStringAtom(""));
+
+    EXPECT_EQ(AStringAtom::find("button"), a);
+    EXPECT_FALSE(AStringAtom::find("strings.atom.never.interned").hasValue());
+
+    ASet<AStringAtom> set = { a, c };
+    EXPECT_TRUE(set.contains(b));
+    EXPECT_FALSE(set.contains(AStringAtom("checkbox")));
+
+    // concurrent interning of the same strings yields the same atoms
+    AVector<AFuture<AVector<AStringAtom>>> results;
+    for (int t = 0; t < 4; ++t) {
+        results << async {
+            AVector<AStringAtom> atoms;
+            for (int i = 0; i < 1000; ++i) {
+                atoms << AStringAtom("strings.atom.{}"_format(i));
+            }
+            return atoms;
+        };
+    }
+    auto first = *results.first();
+    for (auto& r : results) {
+        EXPECT_EQ(*r, first);
+    }
+}
@@ -27,9 +27,11 @@
 #include <ctime>
 #include "AUI/Common/ATimer.h"
 #include "AUI/Traits/parallel.h"
+#include "AUI/Traits/par.h"
 #include "AUI/Thread/AAsyncHolder.h"
 #include "AUI/Util/ARaiiHelper.h"
 #include "AUI/Thread/ACutoffSignal.h"
+#include "AUI/Thread/ACoroutine.h"
 
 using namespace std::chrono_literals;
 
@@ -348,6 +350,107 @@ TEST(Threading, FutureExecuteOnCallingThread) {
     ASSERT_TRUE(called) << "callback has not called";
 }
 
+TEST(Threading, FutureThen) {
+    AThreadPool localThreadPool(2);
+
+    // the source future is a temporary; the continuation keeps it alive
+    auto result = (localThreadPool * [] {
+        AThread::sleep(100ms);
+        return 21;
+    }).then(localThreadPool, [](int v) {
+        return AString::number(v * 2);
+    }).then(localThreadPool, [](const AString& v) {
+        return v + "!";
+    });
+    EXPECT_EQ(*result, "42!");
+
+    auto failed = (localThreadPool * []() -> int {
+        throw AException("failure");
+    }).then(localThreadPool, [](int v) {
+        ADD_FAILURE() << "continuation should not be called";
+        return v;
+    });
+    EXPECT_THROW(*failed, AInvocationTargetException);
+}
+
+TEST(Threading, FutureThenOnThread) {
+    AThreadPool localThreadPool(1);
+    auto callerThread = AThread::current();
+    auto result = (localThreadPool * [] {
+        return 21;
+    }).then(AThread::current(), [callerThread](int v) {
+        EXPECT_EQ(AThread::current(), callerThread);
+        return v * 2;
+    });
+    while (!result.hasResult()) {
+        AThread::processMessages();
+        AThread::sleep(1ms);
+    }
+    EXPECT_EQ(*result, 42);
+}
+
+TEST(Threading, FutureCallbacksRegistration) {
+    AThreadPool localThreadPool(4);
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        AFuture<int> future;
+        AVector<int> order;
+        future.onSuccess([&](int) { order << 0; });
+        future.onSuccess([&](int) { order << 1; });
+
+        // registration races with the value being supplied; every callback should be called exactly once
+        std::atomic_int calls = 0;
+        AFutureSet<> registrations;
+        for (int i = 0; i < 4; ++i) {
+            registrations << localThreadPool * [&] {
+                for (int j = 0; j < 100; ++j) {
+                    future.onSuccess([&](int v) {
+                        EXPECT_EQ(v, 1);
+                        calls += 1;
+                    });
+                }
+            };
+        }
+        future.supplyResult(1);
+        registrations.waitForAll();
+        EXPECT_EQ(calls, 400);
+        EXPECT_EQ(order, (AVector<int>{ 0, 1 }));
+    }
+}
+
+TEST(Threading, FutureAllAnyReduce) {
+    AThreadPool localThreadPool(2);
+    auto makeFutures = [&] {
+        AVector<AFuture<int>> futures;
+        for (int i = 0; i < 10; ++i) {
+            futures << localThreadPool * [i] {
+                AThread::sleep(std::chrono::milliseconds((10 - i) * 5));
+                return i;
+            };
+        }
+        return futures;
+    };
+
+    EXPECT_EQ(*AFuture<int>::all(makeFutures()), (AVector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_EQ(*AFuture<int>::reduce(makeFutures(), 0, std::plus<>{}), 45);
+
+    auto any = *AFuture<int>::any(makeFutures());
+    EXPECT_GE(any, 0);
+    EXPECT_LT(any, 10);
+
+    AVector<AFuture<>> voidFutures;
+    std::atomic_int counter = 0;
+    for (int i = 0; i < 10; ++i) {
+        voidFutures << localThreadPool * [&] { counter += 1; };
+    }
+    AFuture<>::all(voidFutures).wait();
+    EXPECT_EQ(counter, 10);
+
+    AVector<AFuture<int>> withFailure = makeFutures();
+    withFailure << localThreadPool * []() -> int { throw AException("failure"); };
+    EXPECT_THROW(*AFuture<int>::all(withFailure), AInvocationTargetException);
+    EXPECT_EQ(*AFuture<int>::all(AVector<AFuture<int>>{}), AVector<int>{});
+}
+
 TEST(Threading, AsyncHolder) {
 
     bool holderDestroyed = false;
@@ -368,3 +471,198 @@ TEST(Threading, AsyncHolder) {
     }
     holderDestroyed = true;
 }
+
+TEST(Threading, ParForEach) {
+    AThreadPool localThreadPool(3);
+    AVector<int> items(1000);
+    std::iota(items.begin(), items.end(), 0);
+
+    // uneven work: the last items are much heavier
+    std::atomic_int64_t sum = 0;
+    aui::par::for_each(items, [&](int& v) {
+        volatile int spin = 0;
+        for (int i = 0; i < v * 10; ++i) spin = spin + 1;
+        sum += v;
+        v *= 2;
+    }, { &localThreadPool });
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+    EXPECT_EQ(items[999], 1998);
+
+    // nested parallel loops on the same pool complete since the calling thread participates
+    std::atomic_int counter = 0;
+    aui::par::for_index(10, [&](std::size_t) {
+        aui::par::for_index(100, [&](std::size_t) { counter += 1; }, { &localThreadPool });
+    }, { &localThreadPool });
+    EXPECT_EQ(counter, 1000);
+
+    EXPECT_THROW(aui::par::for_index(100, [](std::size_t i) {
+        if (i == 50) throw AException("failure");
+    }, { &localThreadPool }), AException);
+}
+
+TEST(Threading, ParAlgorithms) {
+    AThreadPool localThreadPool(3);
+    std::mt19937 random(0);
+    AVector<int> items(100'000);
+    for (auto& v : items) {
+        v = std::uniform_int_distribution<int>(-1000, 1000)(random);
+    }
+
+    EXPECT_EQ(aui::par::reduce(items.begin(), items.end(), std::int64_t(0), std::plus<>{}, { &localThreadPool }),
+              std::accumulate(items.begin(), items.end(), std::int64_t(0)));
+
+    // non-commutative reduction keeps the order of the range
+    AVector<AString> words = { "a", "b", "c", "d", "e", "f", "g", "h" };
+    EXPECT_EQ(aui::par::transform_reduce(words.begin(), words.end(), AString(), std::plus<>{},
+                                         [](const AString& s) { return s + s; }, { &localThreadPool }),
+              "aabbccddeeffgghh");
+
+    AVector<int> scanned(items.size());
+    AVector<int> expectedScan(items.size());
+    aui::par::inclusive_scan(items.begin(), items.end(), scanned.begin(), std::plus<>{}, { &localThreadPool });
+    std::partial_sum(items.begin(), items.end(), expectedScan.begin());
+    EXPECT_EQ(scanned, expectedScan);
+
+    ADeque<int> sorted(items.begin(), items.end());
+    aui::par::sort(sorted, std::less<>{}, { &localThreadPool });
+    std::sort(items.begin(), items.end());
+    EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), items.begin(), items.end()));
+}
+
+namespace {
+    AFuture<int> coroutineSum(AThreadPool& pool, int a, int b) {
+        int x = co_await (pool * [a] { return a; });
+        co_await aui::co::resumeOn(pool);
+        int y = co_await (pool * [b] { return b; });
+        co_return x + y;
+    }
+
+    AFuture<> coroutineThrow(AThreadPool& pool) {
+        co_await (pool * [] { throw AException("failure"); });
+    }
+
+    AFuture<> coroutineDelay(std::atomic_bool& reached, std::chrono::milliseconds timeout) {
+        co_await aui::co::delay(timeout);
+        reached = true;
+    }
+
+    AFuture<> coroutineAwait(AFuture<> future) {
+        co_await future;
+    }
+}
+
+TEST(Threading, Coroutine) {
+    AThreadPool localThreadPool(2);
+    EXPECT_EQ(*coroutineSum(localThreadPool, 1, 2), 3);
+    EXPECT_THROW(*coroutineThrow(localThreadPool), AInvocationTargetException);
+
+    // thousands of suspended coroutines do not occupy threads
+    AVector<AFuture<int>> sums;
+    for (int i = 0; i < 1000; ++i) {
+        sums << coroutineSum(localThreadPool, i, i);
+    }
+    EXPECT_EQ(*AFuture<int>::reduce(sums, 0, std::plus<>{}), 999 * 1000);
+}
+
+TEST(Threading, CoroutineDelay) {
+    std::atomic_bool reached = false;
+    auto time = util::measureExecutionTime<std::chrono::milliseconds>([&] {
+        coroutineDelay(reached, 100ms).wait();
+    });
+    EXPECT_TRUE(reached);
+    EXPECT_GE(time.count(), 100);
+
+    // destruction of the AFuture cancels the suspended coroutine
+    reached = false;
+    coroutineDelay(reached, 100ms) = nullptr;
+    AThread::sleep(300ms);
+    EXPECT_FALSE(reached);
+}
+
+TEST(Threading, CoroutineAwaitCancelled) {
+    AThreadPool localThreadPool(1);
+    auto blocker = localThreadPool * [] {
+        AThread::sleep(200ms);
+    };
+
+    // the task is cancelled before the pool picks it up; the coroutine is resumed with an exception
+    auto task = localThreadPool * [] {
+        ADD_FAILURE() << "cancelled task has been executed";
+    };
+    auto coroutine = coroutineAwait(task);
+    task.cancel();
+    EXPECT_THROW(*coroutine, AInvocationTargetException);
+}
+
+TEST(Threading, WorkStealingNestedTasks) {
+    AThreadPool localThreadPool(4, AThreadPool::SCHEDULING_WORK_STEALING);
+    std::atomic_int counter = 0;
+    AFutureSet<> futures;
+    repeat(100) {
+        futures << localThreadPool * [&] {
+            // tasks enqueued from a worker are pushed to its local queue and stolen by idle workers
+            AFutureSet<> nested;
+            repeat(100) {
+                nested << localThreadPool * [&] {
+                    counter += 1;
+                };
+            }
+            nested.waitForAll();
+        };
+    }
+    futures.waitForAll();
+    EXPECT_EQ(counter, 100 * 100);
+
+    // tasks run by AFuture::wait on the waiting thread may still have their queue entries pending here, so the count
+    // is not necessarily zero; but it never exceeds the number of tasks (i.e. never underflows).
+    EXPECT_LE(localThreadPool.getPendingTaskCount(), 100 + 100 * 100);
+}
+
+TEST(Threading, WorkStealingPriority) {
+    AThreadPool localThreadPool(2, AThreadPool::SCHEDULING_WORK_STEALING);
+    AMutex sync;
+    AVector<int> order;
+
+    localThreadPool.run([&] {
+        // runs on a worker, so the tasks below are pushed to the worker's local queue
+        AThread::sleep(100ms);
+        localThreadPool.run([&] { std::unique_lock lock(sync); order << 2; }, AThreadPool::PRIORITY_LOWEST);
+        localThreadPool.run([&] { std::unique_lock lock(sync); order << 1; }, AThreadPool::PRIORITY_MEDIUM);
+        localThreadPool.run([&] { std::unique_lock lock(sync); order << 0; }, AThreadPool::PRIORITY_HIGHEST);
+    });
+    localThreadPool.run([&] {
+        // occupy the second worker so it does not steal the tasks above
+        AThread::sleep(300ms);
+    });
+    AThread::sleep(1000ms);
+    std::unique_lock lock(sync);
+    EXPECT_EQ(order, (AVector<int>{0, 1, 2}));
+}
+
+TEST(Threading, MessageQueueOrder) {
+    static constexpr int PRODUCERS = 4;
+    static constexpr int MESSAGES_PER_PRODUCER = 10'000;
+    auto consumer = AThread::current();
+    int received[PRODUCERS] = {0};
+    bool outOfOrder = false;
+
+    AFutureSet<> producers;
+    for (int producer = 0; producer < PRODUCERS; ++producer) {
+        producers << asyncX [&, producer] {
+            for (int i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+                consumer->enqueue([&, producer, i] {
+                    // messages of the same producer should be processed in the order they were sent
+                    outOfOrder |= received[producer] != i;
+                    received[producer] = i + 1;
+                });
+            }
+        };
+    }
+    producers.waitForAll();
+    AThread::processMessages();
+
+    EXPECT_FALSE(outOfOrder);
+    for (auto r : received) {
+        EXPECT_EQ(r, MESSAGES_PER_PRODUCER);
+    }
+}
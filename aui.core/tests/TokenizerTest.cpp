@@ -0,0 +1,154 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Util/ATokenizer.h>
+#include <AUI/IO/AStringStream.h>
+#include <AUI/Util/Util.h>
+
+namespace {
+    /**
+     * @brief Returns the data by small chunks so the tokens are split between the tokenizer's blocks.
+     */
+    class ChunkedInputStream: public IInputStream {
+    public:
+        ChunkedInputStream(std::string data, std::size_t chunkSize): mData(std::move(data)), mChunkSize(chunkSize) {}
+
+        size_t read(char* dst, size_t size) override {
+            size = std::min({ size, mChunkSize, mData.size() - mPosition });
+            std::memcpy(dst, mData.data() + mPosition, size);
+            mPosition += size;
+            return size;
+        }
+
+    private:
+        std::string mData;
+        std::size_t mChunkSize;
+        std::size_t mPosition = 0;
+    };
+
+    constexpr std::string_view TOKENIZER_INPUT = "width: 12.5px;\nheight 0x1F -42 \"quo\\\"ted\\n\" tail\nend";
+
+    void checkTokens(ATokenizer& t) {
+        EXPECT_EQ(t.readString(), "width");
+        EXPECT_EQ(t.readChar(), ':');
+        EXPECT_EQ(t.readChar(), ' ');
+        EXPECT_FLOAT_EQ(t.readFloat(), 12.5f);
+        EXPECT_EQ(t.readStringView(), "px");
+        t.skipUntil('\n');
+        EXPECT_EQ(t.getRow(), 2);
+        EXPECT_EQ(t.readString(), "height");
+        t.readChar();
+        auto hex = t.readUIntX();
+        EXPECT_EQ(hex.value, 0x1F);
+        EXPECT_TRUE(hex.isHex);
+        t.readChar();
+        EXPECT_EQ(t.readInt(), -42);
+        t.skipUntil('"');
+        EXPECT_EQ(t.readStringUntilUnescaped('"'), "quo\"ted\n");
+        t.readChar();
+        EXPECT_EQ(t.readStringViewUntil('\n'), "tail");
+        EXPECT_EQ(t.getRow(), 3);
+        EXPECT_EQ(t.readString(), "end");
+        EXPECT_TRUE(t.isEof());
+        EXPECT_THROW(t.readChar(), AEOFException);
+    }
+}
+
+TEST(Tokenizer, StreamAndMemoryAreEquivalent) {
+    {
+        ATokenizer t(_new<AStringStream>(AString(TOKENIZER_INPUT)));
+        checkTokens(t);
+    }
+    for (std::size_t chunkSize : { 1, 2, 3, 7 }) {
+        ATokenizer t(_new<ChunkedInputStream>(std::string(TOKENIZER_INPUT), chunkSize));
+        checkTokens(t);
+    }
+    {
+        ATokenizer t{AByteBufferView(TOKENIZER_INPUT)};
+        checkTokens(t);
+    }
+    {
+        ATokenizer t{AString(TOKENIZER_INPUT)};
+        checkTokens(t);
+    }
+}
+
+TEST(Tokenizer, ZeroCopy) {
+    std::string_view input = "alpha beta";
+    ATokenizer t{AByteBufferView(input)};
+    auto alpha = t.readStringView();
+    EXPECT_EQ(alpha.data(), input.data());
+    EXPECT_EQ(t.readChar(), ' ');
+    auto beta = t.readStringViewWhile([](char c) { return c != ' '; });
+    EXPECT_EQ(beta, "beta");
+    EXPECT_EQ(beta.data(), input.data() + 6);
+}
+
+TEST(Tokenizer, Numbers) {
+    ATokenizer t(AString("123 -7 0x10 4294967295 1.5.5 12ab -0.25"));
+    EXPECT_EQ(t.readInt(), 123);
+    t.readChar();
+    EXPECT_EQ(t.readInt(), -7);
+    t.readChar();
+    EXPECT_EQ(t.readInt(), 16);
+    t.readChar();
+    EXPECT_EQ(t.readUInt(), 4294967295u);
+    t.readChar();
+    EXPECT_FLOAT_EQ(t.readFloat(), 0.f); // malformed numbers are read as zero
+    t.readChar();
+    EXPECT_EQ(t.readInt(), 0);
+    t.readChar();
+    EXPECT_FLOAT_EQ(t.readFloat(), -0.25f);
+}
+
+TEST(TokenizerPerformance, Words) {
+    std::string input;
+    for (int i = 0; input.size() < 16 * 1024 * 1024; ++i) {
+        input += "word" + std::to_string(i) + ' ' + std::to_string(i * 0.5) + '\n';
+    }
+
+    std::size_t streamCount = 0;
+    auto streamTime = util::measureExecutionTime<std::chrono::microseconds>([&] {
+        ATokenizer t(_new<ChunkedInputStream>(input, input.size()));
+        for (;;) {
+            streamCount += t.readString().size();
+            if (t.isEof()) {
+                break;
+            }
+            t.readChar();
+            t.readFloat();
+            t.readChar();
+        }
+    }).count();
+    std::size_t memoryCount = 0;
+    auto memoryTime = util::measureExecutionTime<std::chrono::microseconds>([&] {
+        ATokenizer t{AByteBufferView(input)};
+        for (;;) {
+            memoryCount += t.readStringView().size();
+            if (t.isEof()) {
+                break;
+            }
+            t.readChar();
+            t.readFloat();
+            t.readChar();
+        }
+    }).count();
+    EXPECT_EQ(streamCount, memoryCount);
+
+    auto throughput = [&](long long us) { return double(input.size()) / double(std::max(us, 1ll)); };
+    printf("Tokenizer: stream %.0f MB/s, memory %.0f MB/s\n", throughput(streamTime), throughput(memoryTime));
+}
@@ -20,101 +20,73 @@
 
 #include <cassert>
 #include "AHash.h"
-#include <openssl/sha.h>
-#include <openssl/md5.h>
+#include "AHasher.h"
+#include <openssl/evp.h>
 #include <openssl/hmac.h>
 #include <AUI/IO/IInputStream.h>
+#include <AUI/Thread/AThreadPool.h>
 
 
-template<typename Functor>
-inline AByteBuffer sha_impl(Functor f, size_t s, AByteBufferView in) {
-    AByteBuffer out;
-    out.reserve(s);
-    out.setSize(s);
-    f((const unsigned char*)in.data(), in.size(), (unsigned char*)out.data());
-    return out;
-}
-
+namespace {
+    AByteBuffer digest(AHasher::Algorithm algorithm, AByteBufferView in) {
+        AHasher hasher(algorithm);
+        hasher.update(in);
+        return hasher.finalize();
+    }
 
-template<typename CTX, typename FInit, typename FUpdate, typename FFinal>
-inline AByteBuffer sha_impl(FInit init, FUpdate update, FFinal final, size_t s, aui::no_escape<IInputStream> in) {
-    AByteBuffer result;
-    result.reserve(s);
-    result.setSize(s);
+    AByteBuffer digest(AHasher::Algorithm algorithm, aui::no_escape<IInputStream> in) {
+        // large reads; the buffer is allocated on the heap to keep the stack of the caller small
+        constexpr std::size_t BUFFER_SIZE = 0x40000;
+        auto buffer = std::make_unique<char[]>(BUFFER_SIZE);
 
-    char tmp[0x10000];
+        AHasher hasher(algorithm);
+        for (size_t r; (r = in->read(buffer.get(), BUFFER_SIZE)) > 0;) {
+            hasher.write(buffer.get(), r);
+        }
+        return hasher.finalize();
+    }
 
-    CTX ctx;
-    init(&ctx);
-    for (size_t r; (r = in->read(tmp, sizeof(tmp))) > 0;) {
-        update(&ctx, tmp, r);
+    AByteBuffer rootOf(const AVector<AByteBuffer>& chunks) {
+        AHasher hasher(AHasher::Algorithm::SHA256);
+        for (const auto& chunk : chunks) {
+            hasher.update(chunk);
+        }
+        return hasher.finalize();
     }
-    final((unsigned char*) result.data(), &ctx);
-    return result;
 }
 
 
-
 AByteBuffer AHash::sha512(AByteBufferView in) {
-    return sha_impl(SHA512, 64, in);
+    return digest(AHasher::Algorithm::SHA512, in);
 }
 
 AByteBuffer AHash::sha512(aui::no_escape<IInputStream> in) {
-    return sha_impl<SHA512_CTX>(SHA512_Init, SHA512_Update, SHA512_Final, 64, in);
+    return digest(AHasher::Algorithm::SHA512, in);
 }
 
 AByteBuffer AHash::sha256(AByteBufferView in) {
-    return sha_impl(SHA256, 32, in);
+    return digest(AHasher::Algorithm::SHA256, in);
 }
 
 AByteBuffer AHash::sha256(aui::no_escape<IInputStream> in) {
-    return sha_impl<SHA256_CTX>(SHA256_Init, SHA256_Update, SHA256_Final, 32, in);
+    return digest(AHasher::Algorithm::SHA256, in);
 }
 
 
 AByteBuffer AHash::sha1(AByteBufferView in) {
-    return sha_impl(SHA1, 20, in);
+    return digest(AHasher::Algorithm::SHA1, in);
 }
 
 AByteBuffer AHash::sha1(aui::no_escape<IInputStream> in) {
-    return sha_impl<SHA_CTX>(SHA1_Init, SHA1_Update, SHA1_Final, 20, in);
+    return digest(AHasher::Algorithm::SHA1, in);
 }
 
 AByteBuffer AHash::md5(AByteBufferView in) {
-    return sha_impl(MD5, 16, in);
+    return digest(AHasher::Algorithm::MD5, in);
 }
 
 AByteBuffer AHash::md5(aui::no_escape<IInputStream> in) {
-    return sha_impl<MD5_CTX>(MD5_Init, MD5_Update, MD5_Final, 16, in);
-}
-
-
-
-template<typename Functor>
-inline AByteBuffer hmac_impl(Functor f, size_t s, AByteBufferView in) {
-    AByteBuffer out;
-    out.reserve(s);
-    out.setSize(s);
-    f((const unsigned char*)in.data(), in.size(), (unsigned char*)out.data());
-    return out;
-}
-
-
-template<typename CTX, typename FInit, typename FUpdate, typename FFinal>
-inline AByteBuffer hmac_impl(FInit init, FUpdate update, FFinal final, size_t s, aui::no_escape<IInputStream> in) {
-    AByteBuffer result;
-    result.reserve(s);
-    result.setSize(s);
-
-    char tmp[0x10000];
-
-    CTX ctx;
-    init(&ctx);
-    for (size_t r; (r = in->read(tmp, sizeof(tmp))) > 0;) {
-        update(&ctx, tmp, r);
-    }
-    final((unsigned char*) result.data(), &ctx);
-    return result;
+    return digest(AHasher::Algorithm::MD5, in);
 }
 
 AByteBuffer AHash::sha256hmac(AByteBufferView in, AByteBufferView key) {
@@ -132,3 +104,65 @@ AByteBuffer AHash::sha256hmac(AByteBufferView in, AByteBufferView key) {
     result.setSize(size);
     return result;
 }
+
+AHashTree AHash::sha256Tree(AByteBufferView in, std::size_t chunkSize) {
+    assert(("chunk size should not be zero", chunkSize != 0));
+    std::size_t chunkCount = std::max((in.size() + chunkSize - 1) / chunkSize, std::size_t(1));
+    AHashTree result{ chunkSize, AVector<AByteBuffer>(chunkCount), {} };
+    auto hashChunk = [&](std::size_t index) {
+        auto offset = index * chunkSize;
+        result.chunks[index] = sha256(in.slice(offset, std::min(chunkSize, in.size() - offset)));
+    };
+
+    if (chunkCount == 1) {
+        hashChunk(0);
+    } else {
+        AFutureSet<> tasks;
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            tasks << (AThreadPool::global() * [&, i] { hashChunk(i); });
+        }
+        tasks.waitForAll();
+    }
+    result.root = rootOf(result.chunks);
+    return result;
+}
+
+AHashTree AHash::sha256Tree(aui::no_escape<IInputStream> in, std::size_t chunkSize) {
+    assert(("chunk size should not be zero", chunkSize != 0));
+    AHashTree result{ chunkSize, {}, {} };
+
+    // bound the number of the chunks in the memory
+    const std::size_t maxChunksInFlight = AThreadPool::global().getTotalWorkerCount() + 1;
+    AVector<AFuture<AByteBuffer>> tasks;
+    auto collectChunk = [&] {
+        result.chunks << *tasks[result.chunks.size()];
+    };
+
+    for (bool first = true;; first = false) {
+        auto chunk = _new<AByteBuffer>();
+        chunk->resize(chunkSize);
+        std::size_t size = 0;
+        for (std::size_t r; size < chunkSize && (r = in->read(chunk->data() + size, chunkSize - size)) > 0;) {
+            size += r;
+        }
+        if (size == 0 && !first) {
+            break;
+        }
+        chunk->setSize(size);
+
+        if (tasks.size() - result.chunks.size() >= maxChunksInFlight) {
+            collectChunk();
+        }
+        tasks << (AThreadPool::global() * [chunk] {
+            return sha256(*chunk);
+        });
+        if (size < chunkSize) {
+            break;
+        }
+    }
+    while (result.chunks.size() < tasks.size()) {
+        collectChunk();
+    }
+    result.root = rootOf(result.chunks);
+    return result;
+}
@@ -22,6 +22,28 @@
 
 
 #include <AUI/Common/AByteBuffer.h>
+#include <AUI/Common/AVector.h>
+
+/**
+ * @brief Result of AHash::sha256Tree.
+ * @ingroup crypt
+ */
+struct AHashTree {
+    /**
+     * @brief Size of the chunks the data was split into. The last chunk may be shorter.
+     */
+    std::size_t chunkSize;
+
+    /**
+     * @brief SHA-256 of every chunk.
+     */
+    AVector<AByteBuffer> chunks;
+
+    /**
+     * @brief SHA-256 of the concatenated chunk hashes.
+     */
+    AByteBuffer root;
+};
 
 /**
  * @brief Various hash functions
@@ -41,6 +63,23 @@ namespace AHash {
     [[nodiscard]] API_AUI_CRYPT AByteBuffer md5(aui::no_escape<IInputStream> in);
 
     [[nodiscard]] API_AUI_CRYPT AByteBuffer sha256hmac(AByteBufferView in, AByteBufferView key);
+
+    static constexpr std::size_t DEFAULT_TREE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * @brief Chunked SHA-256: hashes the chunks of the data in parallel on AThreadPool::global().
+     * @details
+     * Intended for large files (i.e. mapped with AMappedFile). The root hash depends on the chunk size and differs from
+     * sha256() of the same data. The chunk hashes can be used to find the damaged parts of the data.
+     */
+    [[nodiscard]] API_AUI_CRYPT AHashTree sha256Tree(AByteBufferView in, std::size_t chunkSize = DEFAULT_TREE_CHUNK_SIZE);
+
+    /**
+     * @brief Chunked SHA-256 of a stream. The stream is read in the calling thread while the read chunks are hashed
+     * on AThreadPool::global().
+     * @see sha256Tree(AByteBufferView, std::size_t)
+     */
+    [[nodiscard]] API_AUI_CRYPT AHashTree sha256Tree(aui::no_escape<IInputStream> in, std::size_t chunkSize = DEFAULT_TREE_CHUNK_SIZE);
 }
 
 
@@ -0,0 +1,75 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+#include <cassert>
+#include "AHasher.h"
+#include <openssl/evp.h>
+#include "AUI/Common/AException.h"
+
+namespace {
+    const EVP_MD* evpOf(AHasher::Algorithm algorithm) noexcept {
+        switch (algorithm) {
+            case AHasher::Algorithm::MD5: return EVP_md5();
+            case AHasher::Algorithm::SHA1: return EVP_sha1();
+            case AHasher::Algorithm::SHA256: return EVP_sha256();
+            case AHasher::Algorithm::SHA512: return EVP_sha512();
+        }
+        return nullptr;
+    }
+}
+
+AHasher::AHasher(Algorithm algorithm): mContext(EVP_MD_CTX_new()), mAlgorithm(algorithm) {
+    if (!mContext) {
+        throw AException("Could not create digest context");
+    }
+    if (!EVP_DigestInit_ex(static_cast<EVP_MD_CTX*>(mContext), evpOf(algorithm), nullptr)) {
+        EVP_MD_CTX_free(static_cast<EVP_MD_CTX*>(mContext));
+        throw AException("Could not initialize digest");
+    }
+}
+
+AHasher::~AHasher() {
+    EVP_MD_CTX_free(static_cast<EVP_MD_CTX*>(mContext));
+}
+
+void AHasher::write(const char* src, size_t size) {
+    assert(("the hasher is moved", mContext != nullptr));
+    if (!EVP_DigestUpdate(static_cast<EVP_MD_CTX*>(mContext), src, size)) {
+        throw AException("Could not update digest");
+    }
+}
+
+AByteBuffer AHasher::finalize() {
+    assert(("the hasher is moved", mContext != nullptr));
+    auto context = static_cast<EVP_MD_CTX*>(mContext);
+    AByteBuffer result;
+    result.resize(EVP_MAX_MD_SIZE);
+    unsigned size = 0;
+    if (!EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(result.data()), &size) ||
+        !EVP_DigestInit_ex(context, evpOf(mAlgorithm), nullptr)) {
+        throw AException("Could not finalize digest");
+    }
+    result.setSize(size);
+    return result;
+}
+
+std::size_t AHasher::digestSize(Algorithm algorithm) noexcept {
+    return EVP_MD_size(evpOf(algorithm));
+}
+
+void AHashingOutputStream::write(const char* src, size_t size) {
+    mDestination->write(src, size);
+    mHasher.write(src, size);
+}
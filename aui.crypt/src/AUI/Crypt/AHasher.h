@@ -0,0 +1,109 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/Common/SharedPtrTypes.h>
+#include <AUI/IO/IOutputStream.h>
+
+/**
+ * @brief Incremental hash function.
+ * @ingroup crypt
+ * @details
+ * Data is fed with update() (or write(), so the hasher can be used as an IOutputStream), then finalize() returns the
+ * digest. Unlike AHash functions, the data does not need to be in the memory at once.
+ *
+ * @code{cpp}
+ * AHasher hasher(AHasher::Algorithm::SHA256);
+ * hasher.update(header);
+ * hasher.update(body);
+ * auto digest = hasher.finalize();
+ * @endcode
+ */
+class API_AUI_CRYPT AHasher: public IOutputStream {
+public:
+    enum class Algorithm {
+        MD5,
+        SHA1,
+        SHA256,
+        SHA512,
+    };
+
+    explicit AHasher(Algorithm algorithm);
+    AHasher(AHasher&& rhs) noexcept: mContext(rhs.mContext), mAlgorithm(rhs.mAlgorithm) {
+        rhs.mContext = nullptr;
+    }
+    ~AHasher() override;
+
+    void update(AByteBufferView data) {
+        write(data.data(), data.size());
+    }
+
+    void write(const char* src, size_t size) override;
+
+    /**
+     * @return digest of the data passed so far. The hasher is reset and can be used for new data.
+     */
+    [[nodiscard]]
+    AByteBuffer finalize();
+
+    [[nodiscard]]
+    Algorithm algorithm() const noexcept {
+        return mAlgorithm;
+    }
+
+    /**
+     * @return size of the digest in bytes.
+     */
+    [[nodiscard]]
+    static std::size_t digestSize(Algorithm algorithm) noexcept;
+
+private:
+    /**
+     * @brief EVP_MD_CTX
+     */
+    void* mContext;
+    Algorithm mAlgorithm;
+};
+
+/**
+ * @brief Writes the data to the underlying stream and hashes it on the way.
+ * @ingroup crypt
+ * @details
+ * Hashes the data while it is being copied or downloaded, so it is not read the second time.
+ *
+ * @code{cpp}
+ * AHashingOutputStream os(_new<AFileOutputStream>("artifact.zip"), AHasher::Algorithm::SHA256);
+ * os << *download;
+ * auto digest = os.hasher().finalize();
+ * @endcode
+ */
+class API_AUI_CRYPT AHashingOutputStream final: public IOutputStream {
+public:
+    AHashingOutputStream(_<IOutputStream> destination, AHasher::Algorithm algorithm):
+        mDestination(std::move(destination)), mHasher(algorithm) {}
+
+    void write(const char* src, size_t size) override;
+
+    [[nodiscard]]
+    AHasher& hasher() noexcept {
+        return mHasher;
+    }
+
+private:
+    _<IOutputStream> mDestination;
+    AHasher mHasher;
+};
@@ -23,6 +23,7 @@
 #include <AUI/Util/ARandom.h>
 #include <AUI/Common/AString.h>
 #include <AUI/Crypt/AHash.h>
+#include <AUI/Crypt/AHasher.h>
 #include <AUI/IO/AByteBufferInputStream.h>
 
 
@@ -39,3 +40,51 @@ TEST(Hash, Sha512) {
 
     ASSERT_EQ(AHash::sha512(_new<AByteBufferInputStream>(buffer)).toHexString(), "b45f03fb7627749aa177814526a23547436df87b3233393d86586b4ecd043327b94a67f7d1ee56ae43faf8b8290fd0cfb2b11d46134b331c4a1ff1f2da6a3ca8");
 }
+
+TEST(Hash, Incremental) {
+    AByteBuffer buffer = AByteBuffer::fromString("sdfzsrsrhsrhfxbuihusebrvjmsdfbvhsrhvbhfsvbhbhlsdbhjbsdhbdfhbhlefbhlABHJ");
+    AHasher hasher(AHasher::Algorithm::SHA512);
+    hasher.update(buffer.slice(0, 10));
+    hasher.update(buffer.slice(10, buffer.size() - 10));
+    ASSERT_EQ(hasher.finalize(), AHash::sha512(buffer));
+
+    // finalize resets the hasher
+    hasher.update(AByteBuffer::fromString("govno"));
+    ASSERT_EQ(hasher.finalize().toHexString(), "b7cbd9e15895669db8806632dc00894b4551e172220bdadedbae7005291e1a1586a172012e1319fbff968760bcc13d96015acdff8c115b8f1e3e7b421126bb03");
+
+    ASSERT_EQ(AHasher::digestSize(AHasher::Algorithm::SHA256), 32);
+    ASSERT_EQ(AHasher(AHasher::Algorithm::SHA1).finalize().toHexString(), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+}
+
+TEST(Hash, HashingOutputStream) {
+    auto copy = _new<AByteBuffer>();
+    AHashingOutputStream os(copy, AHasher::Algorithm::MD5);
+    os << AByteBufferInputStream(AByteBuffer::fromString("govno"));
+    ASSERT_EQ(os.hasher().finalize().toHexString(), "b3575f222f7b768c25160b879699118b");
+    ASSERT_EQ(*copy, AByteBuffer::fromString("govno"));
+}
+
+TEST(Hash, Sha256Tree) {
+    AByteBuffer data;
+    for (int i = 0; i < 100000; ++i) {
+        data << std::uint32_t(i * 2654435761u);
+    }
+    auto tree = AHash::sha256Tree(data, 65536);
+    ASSERT_EQ(tree.chunks.size(), 7);
+    ASSERT_EQ(tree.chunks[6], AHash::sha256(data.slice(6 * 65536, data.size() - 6 * 65536)));
+
+    AByteBuffer concatenated;
+    for (const auto& chunk : tree.chunks) {
+        concatenated << chunk;
+    }
+    ASSERT_EQ(tree.root, AHash::sha256(concatenated));
+
+    // the stream is split into the same chunks
+    ASSERT_EQ(AHash::sha256Tree(_new<AByteBufferInputStream>(data), 65536).root, tree.root);
+    ASSERT_NE(AHash::sha256Tree(data, 32768).root, tree.root);
+
+    // empty data is a single empty chunk
+    ASSERT_EQ(AHash::sha256Tree(AByteBufferView{}).chunks, (AVector<AByteBuffer>{ AHash::sha256(AByteBufferView{}) }));
+    ASSERT_EQ(AHash::sha256Tree(_new<AByteBufferInputStream>(AByteBufferView{})).root,
+              AHash::sha256Tree(AByteBufferView{}).root);
+}
@@ -80,6 +80,30 @@ public:
 			return mRow->getValue(index);
 		}
 
+        /*
+         * Typed accessors; faster than getValue because they do not construct AVariant.
+         */
+
+        bool isNull(size_t index) const {
+            return mRow->isNull(index);
+        }
+
+        std::int64_t getInt64(size_t index) const {
+            return mRow->getInt64(index);
+        }
+
+        double getDouble(size_t index) const {
+            return mRow->getDouble(index);
+        }
+
+        AString getString(size_t index) const {
+            return mRow->getString(index);
+        }
+
+        AByteBuffer getBlob(size_t index) const {
+            return mRow->getBlob(index);
+        }
+
         AVector<AVariant> range(size_t count) const {
             AVector<AVariant> v;
             for (size_t i = 0; i < count; ++i) {
@@ -25,4 +25,28 @@ public:
 	virtual ~ISqlDriverRow() = default;
 
 	virtual AVariant getValue(size_t index) = 0;
+
+    /*
+     * Typed accessors. Drivers override them to read the column without constructing AVariant.
+     */
+
+    virtual bool isNull(size_t index) {
+        return getValue(index).getType() == AVariantType::AV_NULL;
+    }
+
+    virtual std::int64_t getInt64(size_t index) {
+        return getValue(index).toInt();
+    }
+
+    virtual double getDouble(size_t index) {
+        return getValue(index).toDouble();
+    }
+
+    virtual AString getString(size_t index) {
+        return getValue(index).toString();
+    }
+
+    virtual AByteBuffer getBlob(size_t index) {
+        return AByteBuffer::fromString(getString(index));
+    }
 };
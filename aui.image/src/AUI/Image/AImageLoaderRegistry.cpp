@@ -17,6 +17,7 @@
 #include "AImageLoaderRegistry.h"
 
 #include "AUI/Common/AByteBuffer.h"
+#include "AUI/IO/AMappedFile.h"
 
 
 void AImageLoaderRegistry::registerRasterLoader(_<IImageLoader> imageLoader) {
@@ -71,8 +72,14 @@ _<AImage> AImageLoaderRegistry::loadRaster(AByteBufferView buffer) {
 }
 
 _<AImage> AImageLoaderRegistry::loadImage(const AUrl& url) {
-    auto buffer = AByteBuffer::fromStream(url.open());
-    if (auto r = loadRaster(buffer))
+    _<AImage> r;
+    if (url.schema() == "file") {
+        // decode straight from the page cache
+        r = loadRaster(AMappedFile(url.path()).view());
+    } else {
+        r = loadRaster(AByteBuffer::fromStream(url.open()));
+    }
+    if (r)
         return r;
     ALogger::warn("No applicable image loader for " + url.full());
     return nullptr;
@@ -15,9 +15,8 @@
 // License along with this library. If not, see <http://www.gnu.org/licenses/>.
 
 #include "AJson.h"
-#include "AUI/IO/AStringStream.h"
+#include "AJsonTape.h"
 #include "AUI/Common/AByteBuffer.h"
-#include "AUI/IO/AByteBufferInputStream.h"
 
 AString AJson::toString(const AJson& json) {
     AByteBuffer buffer;
@@ -25,13 +24,19 @@ AString AJson::toString(const AJson& json) {
     return AString::fromUtf8(buffer);
 }
 
+AUtf8String AJson::toUtf8String(const AJson& json) {
+    AByteBuffer buffer;
+    aui::serialize(buffer, json);
+    return AUtf8String(buffer);
+}
+
 AJson AJson::fromString(const AString& json) {
-    AStringStream sis(json);
-    return aui::deserialize<AJson>(sis);
+    auto utf8 = json.toUtf8();
+    return AJsonTape::parse(utf8).root().toJson();
 }
 
 AJson AJson::fromBuffer(AByteBufferView buffer) {
-    return aui::deserialize<AJson>(AByteBufferInputStream(buffer));
+    return AJsonTape::parse(buffer).root().toJson();
 }
 
 AJson AJson::mergedWith(const AJson &other) {
@@ -21,6 +21,7 @@
 #include "AUI/IO/IInputStream.h"
 #include "AJson.h"
 #include "AUI/Common/AByteBufferView.h"
+#include "AUI/Common/AUtf8String.h"
 
 #include <AUI/Common/AUuid.h>
 #include <AUI/Common/AMap.h>
@@ -261,10 +262,18 @@ public:
     AJson mergedWith(const AJson& other);
 
     [[nodiscard]] static API_AUI_JSON AString toString(const AJson& json);
+
+    /**
+     * @brief Same as AJson::toString, but returns the utf8 json without transcoding it to AString.
+     */
+    [[nodiscard]] static API_AUI_JSON AUtf8String toUtf8String(const AJson& json);
     [[nodiscard]] static API_AUI_JSON AJson fromString(const AString& json);
     [[nodiscard]] static AJson fromStream(aui::no_escape<IInputStream> stream) {
         return aui::deserialize<AJson>(stream);
     }
+    /**
+     * @brief Parses utf8 json. Use AUtf8String::bytes to parse AUtf8String without copying.
+     */
     [[nodiscard]] static API_AUI_JSON AJson fromBuffer(AByteBufferView buffer);
 };
 
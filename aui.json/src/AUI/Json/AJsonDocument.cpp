@@ -0,0 +1,434 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AJsonDocument.h"
+#include "AJson.h"
+#include "AJsonTape.h"
+#include <AUI/Common/AStringAtom.h>
+#include <AUI/Common/AUtf8.h>
+#include <bit>
+#include <cstring>
+
+using Value = AJsonDocument::Value;
+using Member = AJsonDocument::Member;
+using Type = AJsonDocument::Type;
+
+/**
+ * @brief Bump allocator. Memory is released only when the arena is destroyed.
+ */
+class AJsonDocument::Arena {
+public:
+    explicit Arena(std::size_t firstBlockSize) noexcept: mNextBlockSize(std::max(firstBlockSize, MIN_BLOCK_SIZE)) {}
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        auto offset = (alignment - std::uintptr_t(mCursor) % alignment) % alignment;
+        if (mCursor == nullptr || std::size_t(mEnd - mCursor) < offset + size) {
+            auto blockSize = std::max(size, mNextBlockSize);
+            mBlocks.emplace_back(new char[blockSize]);
+            mCursor = mBlocks.back().get();
+            mEnd = mCursor + blockSize;
+            mAllocated += blockSize;
+            mNextBlockSize = std::min(blockSize * 2, MAX_BLOCK_SIZE);
+            offset = 0; // operator new[] returns memory aligned for any fundamental type
+        }
+        auto result = mCursor + offset;
+        mCursor = result + size;
+        return result;
+    }
+
+    template<typename T>
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    std::string_view copy(std::string_view string) {
+        auto data = allocate<char>(string.size());
+        std::memcpy(data, string.data(), string.size());
+        return { data, string.size() };
+    }
+
+    [[nodiscard]]
+    std::size_t allocated() const noexcept {
+        return mAllocated;
+    }
+
+private:
+    static constexpr std::size_t MIN_BLOCK_SIZE = 4 * 1024;
+    static constexpr std::size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> mBlocks;
+    char* mCursor = nullptr;
+    char* mEnd = nullptr;
+    std::size_t mNextBlockSize;
+    std::size_t mAllocated = 0;
+};
+
+namespace {
+    std::uint32_t hashIndexCapacity(std::uint32_t size) noexcept {
+        return std::bit_ceil(size * 2);
+    }
+
+    std::size_t hashOf(std::string_view key) noexcept {
+        return std::hash<std::string_view>{}(key);
+    }
+}
+
+/**
+ * @brief Fills the values allocated from the arena.
+ */
+class AJsonDocument::Builder {
+public:
+    explicit Builder(Arena& arena) noexcept: mArena(arena) {}
+
+    Value* allocateValue() {
+        return new (mArena.allocate<Value>(1)) Value;
+    }
+
+    void fromTape(const AJsonTape& tape, std::uint32_t index, Value& out) {
+        const auto& entries = tape.entries();
+        const auto& entry = entries[index];
+        AJsonCursor cursor(tape, index);
+        switch (entry.type) {
+            case AJsonTapeType::NULL_VALUE:
+                out.mType = Type::NULL_VALUE;
+                break;
+            case AJsonTapeType::TRUE_VALUE:
+            case AJsonTapeType::FALSE_VALUE:
+                out.mType = Type::BOOL;
+                out.mBool = entry.type == AJsonTapeType::TRUE_VALUE;
+                break;
+            case AJsonTapeType::NUMBER:
+                std::visit(aui::lambda_overloaded {
+                    [&](std::int64_t v) {
+                        out.mType = Type::INT;
+                        out.mInteger = v;
+                    },
+                    [&](double v) {
+                        out.mType = Type::DOUBLE;
+                        out.mDouble = v;
+                    },
+                }, cursor.asIntegerOrDouble());
+                break;
+            case AJsonTapeType::STRING:
+                setString(out, string(cursor));
+                break;
+            case AJsonTapeType::ARRAY: {
+                auto elements = allocateArray(out, entry.length);
+                auto child = index + 1;
+                for (std::uint32_t i = 0; i < entry.length; ++i, child = entries[child].next) {
+                    fromTape(tape, child, elements[i]);
+                }
+                break;
+            }
+            case AJsonTapeType::OBJECT: {
+                auto members = allocateObject(out, entry.length);
+                auto child = index + 1;
+                for (std::uint32_t i = 0; i < entry.length; ++i, child = entries[child + 1].next) {
+                    setKey(members[i], string({ tape, child }));
+                    fromTape(tape, child + 1, members[i].value);
+                }
+                buildHashIndex(out);
+                break;
+            }
+        }
+    }
+
+    void fromJson(const AJson& json, Value& out) {
+        std::visit(aui::lambda_overloaded {
+            [&](std::nullopt_t) {
+                out.mType = Type::NULL_VALUE;
+            },
+            [&](std::nullptr_t) {
+                out.mType = Type::NULL_VALUE;
+            },
+            [&](bool v) {
+                out.mType = Type::BOOL;
+                out.mBool = v;
+            },
+            [&](int v) {
+                out.mType = Type::INT;
+                out.mInteger = v;
+            },
+            [&](std::int64_t v) {
+                out.mType = Type::INT;
+                out.mInteger = v;
+            },
+            [&](double v) {
+                out.mType = Type::DOUBLE;
+                out.mDouble = v;
+            },
+            [&](const AString& v) {
+                setString(out, encode(v));
+            },
+            [&](const aui::impl::JsonArray& v) {
+                auto elements = allocateArray(out, std::uint32_t(v.size()));
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    fromJson(v[i], elements[i]);
+                }
+            },
+            [&](const aui::impl::JsonObject& v) {
+                auto members = allocateObject(out, std::uint32_t(v.size()));
+                for (const auto& [key, value] : v) {
+                    setKey(*members, encode(key));
+                    fromJson(value, members->value);
+                    ++members;
+                }
+                buildHashIndex(out);
+            },
+        }, static_cast<const aui::impl::JsonVariant&>(json));
+    }
+
+private:
+    Arena& mArena;
+
+    std::string_view string(AJsonCursor cursor) {
+        auto raw = cursor.rawString();
+        if (raw.find('\\') == std::string_view::npos) {
+            return raw;
+        }
+        return mArena.copy(cursor.asUtf8String());
+    }
+
+    std::string_view encode(const AString& string) {
+        std::wstring_view wide(string.data(), string.length());
+        auto data = mArena.allocate<char>(aui::utf8::encodedLength(wide));
+        auto end = aui::utf8::encode(wide, data);
+        return { data, std::size_t(end - data) };
+    }
+
+    static void setString(Value& out, std::string_view string) {
+        out.mType = Type::STRING;
+        out.mSize = std::uint32_t(string.size());
+        out.mString = string.data();
+    }
+
+    static void setKey(Member& member, std::string_view key) {
+        member.keyData = key.data();
+        member.keySize = std::uint32_t(key.size());
+    }
+
+    Value* allocateArray(Value& out, std::uint32_t size) {
+        auto elements = mArena.allocate<Value>(size);
+        std::uninitialized_default_construct_n(elements, size);
+        out.mType = Type::ARRAY;
+        out.mSize = size;
+        out.mElements = elements;
+        return elements;
+    }
+
+    Member* allocateObject(Value& out, std::uint32_t size) {
+        // the hash index is placed right after the members
+        auto bytes = sizeof(Member) * size;
+        if (size >= HASH_INDEX_THRESHOLD) {
+            bytes += sizeof(std::uint32_t) * hashIndexCapacity(size);
+        }
+        auto members = static_cast<Member*>(mArena.allocate(bytes, alignof(Member)));
+        std::uninitialized_default_construct_n(members, size);
+        out.mType = Type::OBJECT;
+        out.mSize = size;
+        out.mMembers = members;
+        return members;
+    }
+
+    static void buildHashIndex(const Value& object) {
+        if (object.mSize < HASH_INDEX_THRESHOLD) {
+            return;
+        }
+        auto capacity = hashIndexCapacity(object.mSize);
+        auto slots = const_cast<std::uint32_t*>(reinterpret_cast<const std::uint32_t*>(object.mMembers + object.mSize));
+        std::fill_n(slots, capacity, 0);
+
+        // slots hold member index + 1; 0 is an empty slot
+        for (std::uint32_t i = 0; i < object.mSize; ++i) {
+            auto key = object.mMembers[i].key();
+            for (auto slot = hashOf(key) & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+                if (slots[slot] == 0 || object.mMembers[slots[slot] - 1].key() == key) {
+                    // duplicate keys: the last one wins, like in AJson
+                    slots[slot] = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+};
+
+AJsonDocument::AJsonDocument(std::unique_ptr<Arena> arena, const Value* root) noexcept:
+    mArena(std::move(arena)), mRoot(root) {}
+
+AJsonDocument::AJsonDocument(AJsonDocument&&) noexcept = default;
+AJsonDocument& AJsonDocument::operator=(AJsonDocument&&) noexcept = default;
+AJsonDocument::~AJsonDocument() = default;
+
+AJsonDocument AJsonDocument::parse(AByteBufferView buffer) {
+    return fromTape(AJsonTape::parse(buffer));
+}
+
+AJsonDocument AJsonDocument::fromTape(const AJsonTape& tape) {
+    // a value takes exactly one tape entry and a member takes two (the key and the value), so the document fits into
+    // the first block unless the document has escaped strings or large objects
+    auto arena = std::make_unique<Arena>((tape.entries().size() + 1) * sizeof(Value));
+    Builder builder(*arena);
+    auto root = builder.allocateValue();
+    builder.fromTape(tape, 0, *root);
+    return { std::move(arena), root };
+}
+
+AJsonDocument AJsonDocument::fromJson(const AJson& json) {
+    auto arena = std::make_unique<Arena>(0);
+    Builder builder(*arena);
+    auto root = builder.allocateValue();
+    builder.fromJson(json, *root);
+    return { std::move(arena), root };
+}
+
+AJson AJsonDocument::toJson() const {
+    return mRoot->toJson();
+}
+
+std::size_t AJsonDocument::memoryUsage() const noexcept {
+    return mArena->allocated();
+}
+
+void Value::expect(Type type, const char* what) const {
+    if (mType != type) {
+        throw AJsonTypeMismatchException(what);
+    }
+}
+
+bool Value::asBool() const {
+    expect(Type::BOOL, "not a bool");
+    return mBool;
+}
+
+int Value::asInt() const {
+    if (!isInt()) {
+        throw AJsonTypeMismatchException("not an int");
+    }
+    return int(mInteger);
+}
+
+std::int64_t Value::asLongInt() const {
+    expect(Type::INT, "not a long int");
+    return mInteger;
+}
+
+double Value::asNumber() const {
+    switch (mType) {
+        case Type::INT: return double(mInteger);
+        case Type::DOUBLE: return mDouble;
+        default: throw AJsonTypeMismatchException("not a number");
+    }
+}
+
+std::string_view Value::asStringView() const {
+    expect(Type::STRING, "not a string");
+    return { mString, mSize };
+}
+
+AString Value::asString() const {
+    expect(Type::STRING, "not a string");
+    return AString::fromUtf8(mString, mSize);
+}
+
+AArrayView<Value> Value::asArray() const {
+    expect(Type::ARRAY, "not an array");
+    return { mElements, mSize };
+}
+
+AArrayView<Member> Value::asObject() const {
+    expect(Type::OBJECT, "not an object");
+    return { mMembers, mSize };
+}
+
+std::size_t Value::size() const {
+    if (mType != Type::ARRAY && mType != Type::OBJECT) {
+        throw AJsonTypeMismatchException("not an array or object");
+    }
+    return mSize;
+}
+
+const Value* Value::find(std::string_view key) const {
+    expect(Type::OBJECT, "not an object");
+    if (mSize >= HASH_INDEX_THRESHOLD) {
+        auto capacity = hashIndexCapacity(mSize);
+        auto slots = reinterpret_cast<const std::uint32_t*>(mMembers + mSize);
+        for (auto slot = hashOf(key) & (capacity - 1); slots[slot] != 0; slot = (slot + 1) & (capacity - 1)) {
+            const auto& member = mMembers[slots[slot] - 1];
+            if (member.key() == key) {
+                return &member.value;
+            }
+        }
+        return nullptr;
+    }
+    for (auto i = mSize; i-- > 0;) {
+        if (mMembers[i].key() == key) {
+            return &mMembers[i].value;
+        }
+    }
+    return nullptr;
+}
+
+const Value& Value::operator[](std::string_view key) const {
+    if (auto v = find(key)) {
+        return *v;
+    }
+    throw AJsonException(R"(field "{}" is not present)"_format(key));
+}
+
+const Value& Value::operator[](std::size_t index) const {
+    expect(Type::ARRAY, "not an array");
+    if (index >= mSize) {
+        throw AJsonException("index {} is out of bounds"_format(index));
+    }
+    return mElements[index];
+}
+
+AJson Value::toJson() const {
+    switch (mType) {
+        case Type::NULL_VALUE:
+            return nullptr;
+        case Type::BOOL:
+            return mBool;
+        case Type::INT:
+            if (int(mInteger) == mInteger) {
+                return int(mInteger);
+            }
+            return mInteger;
+        case Type::DOUBLE:
+            return mDouble;
+        case Type::STRING:
+            return AString::fromUtf8(mString, mSize);
+        case Type::ARRAY: {
+            aui::impl::JsonArray result;
+            result.reserve(mSize);
+            for (const auto& element : asArray()) {
+                result << element.toJson();
+            }
+            return result;
+        }
+        case Type::OBJECT: {
+            aui::impl::JsonObject result;
+            for (const auto& member : asObject()) {
+                // known keys (i.e. reflected field names) are decoded once, when they are interned
+                auto atom = AStringAtom::find(member.key());
+                AString key = atom ? atom->str() : AString::fromUtf8(member.keyData, member.keySize);
+                result[std::move(key)] = member.value.toJson();
+            }
+            return result;
+        }
+    }
+    return {};
+}
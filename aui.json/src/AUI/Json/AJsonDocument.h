@@ -0,0 +1,273 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <AUI/Common/AByteBufferView.h>
+#include <AUI/Common/AOptional.h>
+#include <AUI/Common/AString.h>
+#include <AUI/Util/AArrayView.h>
+
+class AJson;
+class AJsonTape;
+
+/**
+ * @brief Compact read-only json document.
+ * @ingroup json
+ * @details
+ * Alternative to AJson for large documents. All values of the document are allocated from the document's arena:
+ * - value is 16 bytes; integers and doubles are stored inline;
+ * - arrays are arrays of values; objects are arrays of key/value pairs in the document order, objects with many fields
+ *   also have a hash index;
+ * - strings are utf8 slices of the input buffer; only strings with escape sequences are copied to the arena.
+ *
+ * Destroying the document frees a few arena blocks instead of every node.
+ *
+ * Strings of a parsed document point to the input buffer, so the buffer must outlive the document.
+ *
+ * @code{cpp}
+ * auto document = AJsonDocument::parse(buffer);
+ * for (const auto& user : document.root()["users"].asArray()) {
+ *     names << user["name"].asString();
+ * }
+ * @endcode
+ */
+class API_AUI_JSON AJsonDocument {
+private:
+    class Arena;
+    class Builder;
+
+public:
+    struct Member;
+
+    enum class Type: std::uint8_t {
+        NULL_VALUE,
+        BOOL,
+        INT,
+        DOUBLE,
+        STRING,
+        ARRAY,
+        OBJECT,
+    };
+
+    /**
+     * @brief Objects with this number of fields or more are indexed by a hash table.
+     */
+    static constexpr std::uint32_t HASH_INDEX_THRESHOLD = 16;
+
+    class API_AUI_JSON Value {
+        friend class AJsonDocument::Builder;
+    public:
+        [[nodiscard]]
+        Type type() const noexcept {
+            return mType;
+        }
+
+        [[nodiscard]]
+        bool isNull() const noexcept {
+            return mType == Type::NULL_VALUE;
+        }
+
+        [[nodiscard]]
+        bool isBool() const noexcept {
+            return mType == Type::BOOL;
+        }
+
+        [[nodiscard]]
+        bool isInt() const noexcept {
+            return mType == Type::INT && int(mInteger) == mInteger;
+        }
+
+        [[nodiscard]]
+        bool isLongInt() const noexcept {
+            return mType == Type::INT;
+        }
+
+        [[nodiscard]]
+        bool isNumber() const noexcept {
+            return mType == Type::INT || mType == Type::DOUBLE;
+        }
+
+        [[nodiscard]]
+        bool isString() const noexcept {
+            return mType == Type::STRING;
+        }
+
+        [[nodiscard]]
+        bool isArray() const noexcept {
+            return mType == Type::ARRAY;
+        }
+
+        [[nodiscard]]
+        bool isObject() const noexcept {
+            return mType == Type::OBJECT;
+        }
+
+        [[nodiscard]]
+        bool asBool() const;
+
+        [[nodiscard]]
+        int asInt() const;
+
+        [[nodiscard]]
+        std::int64_t asLongInt() const;
+
+        [[nodiscard]]
+        double asNumber() const;
+
+        [[nodiscard]]
+        AString asString() const;
+
+        /**
+         * @return utf8 contents of the string without copying.
+         */
+        [[nodiscard]]
+        std::string_view asStringView() const;
+
+        [[nodiscard]]
+        AArrayView<Value> asArray() const;
+
+        [[nodiscard]]
+        AArrayView<Member> asObject() const;
+
+        /**
+         * @return number of elements of an array or number of fields of an object.
+         */
+        [[nodiscard]]
+        std::size_t size() const;
+
+        /**
+         * @brief Looks up the object field. O(1) for objects with a hash index, O(size) otherwise.
+         * @param key utf8 field name
+         * @return value of the field, if present. If the key is duplicated, the last value is returned.
+         */
+        [[nodiscard]]
+        const Value* find(std::string_view key) const;
+
+        [[nodiscard]]
+        bool contains(std::string_view key) const {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Value of the object field.
+         * @throws AJsonException if the field is not present.
+         */
+        [[nodiscard]]
+        const Value& operator[](std::string_view key) const;
+
+        [[nodiscard]]
+        const Value& operator[](const char* key) const {
+            return (*this)[std::string_view(key)];
+        }
+
+        /**
+         * @brief Array element.
+         * @throws AJsonException if the index is out of bounds.
+         */
+        [[nodiscard]]
+        const Value& operator[](std::size_t index) const;
+
+        [[nodiscard]]
+        const Value& operator[](int index) const {
+            return (*this)[std::size_t(index)];
+        }
+
+        /**
+         * @brief Builds AJson of the value and its children.
+         */
+        [[nodiscard]]
+        AJson toJson() const;
+
+    private:
+        Type mType;
+
+        /**
+         * @brief Byte length of a string; element count of an array or an object.
+         */
+        std::uint32_t mSize;
+
+        union {
+            bool mBool;
+            std::int64_t mInteger;
+            double mDouble;
+            const char* mString;
+            const Value* mElements;
+            const Member* mMembers;
+        };
+
+        void expect(Type type, const char* what) const;
+    };
+
+    struct Member {
+        const char* keyData;
+        std::uint32_t keySize;
+        Value value;
+
+        [[nodiscard]]
+        std::string_view key() const noexcept {
+            return { keyData, keySize };
+        }
+    };
+
+    AJsonDocument(AJsonDocument&&) noexcept;
+    AJsonDocument& operator=(AJsonDocument&&) noexcept;
+    ~AJsonDocument();
+
+    /**
+     * @brief Parses utf8 json.
+     * @param buffer input buffer. The buffer must outlive the document.
+     * @throws AJsonParseException if the input is not a valid json.
+     */
+    [[nodiscard]]
+    static AJsonDocument parse(AByteBufferView buffer);
+
+    /**
+     * @brief Builds the document from the parsed tape. The input buffer of the tape must outlive the document.
+     */
+    [[nodiscard]]
+    static AJsonDocument fromTape(const AJsonTape& tape);
+
+    /**
+     * @brief Builds the document from AJson. The document does not refer to the AJson.
+     */
+    [[nodiscard]]
+    static AJsonDocument fromJson(const AJson& json);
+
+    [[nodiscard]]
+    const Value& root() const noexcept {
+        return *mRoot;
+    }
+
+    [[nodiscard]]
+    AJson toJson() const;
+
+    /**
+     * @return number of bytes allocated by the document's arena.
+     */
+    [[nodiscard]]
+    std::size_t memoryUsage() const noexcept;
+
+private:
+    std::unique_ptr<Arena> mArena;
+    const Value* mRoot;
+
+    AJsonDocument(std::unique_ptr<Arena> arena, const Value* root) noexcept;
+};
@@ -0,0 +1,393 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AJsonReader.h"
+#include "AJson.h"
+#include "Scalars.h"
+#include <AUI/Common/AStringAtom.h>
+#include <cstring>
+
+namespace {
+    bool isWhitespace(char c) noexcept {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool isDelimiter(char c) noexcept {
+        switch (c) {
+            case ' ': case '\n': case '\r': case '\t':
+            case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+AJsonReader::AJsonReader(IInputStream& stream, std::size_t bufferSize):
+    mStream(&stream),
+    mStorage(new char[bufferSize]),
+    mData(mStorage.get()),
+    mBufferSize(bufferSize) {}
+
+AJsonReader::AJsonReader(AByteBufferView buffer):
+    mStream(nullptr),
+    mData(buffer.data()),
+    mBufferSize(buffer.size()),
+    mEnd(buffer.size()) {}
+
+AJsonReader::~AJsonReader() = default;
+
+void AJsonReader::fail(const AString& message) const {
+    throw AJsonParseException("{} at offset {}"_format(message, offset()));
+}
+
+void AJsonReader::unexpectedCharacter(char c) const {
+    fail("unexpected character {}"_format(c));
+}
+
+bool AJsonReader::refill() {
+    mBufferOffset += mEnd;
+    mPosition = 0;
+    mEnd = mStream ? mStream->read(mStorage.get(), mBufferSize) : 0;
+    return mEnd != 0;
+}
+
+int AJsonReader::peek() {
+    for (;;) {
+        for (; mPosition < mEnd; ++mPosition) {
+            if (!isWhitespace(mData[mPosition])) {
+                return static_cast<unsigned char>(mData[mPosition]);
+            }
+        }
+        if (!refill()) {
+            return -1;
+        }
+    }
+}
+
+AJsonReader::Event AJsonReader::next() {
+    for (;;) {
+        if (mState == State::TOP) {
+            int c = peek();
+            if (c < 0) {
+                return mEvent = Event::END;
+            }
+            return readValue(char(c));
+        }
+        if (mState == State::AFTER_VALUE && mStack.empty()) {
+            mState = State::TOP;
+            continue;
+        }
+
+        int c = peek();
+        if (c < 0) {
+            fail("unexpected end of json stream");
+        }
+        switch (mState) {
+            case State::VALUE:
+                return readValue(char(c));
+
+            case State::FIRST_ELEMENT:
+                if (c == ']') {
+                    ++mPosition;
+                    return close(false);
+                }
+                return readValue(char(c));
+
+            case State::FIRST_KEY:
+                if (c == '}') {
+                    ++mPosition;
+                    return close(true);
+                }
+                return readKey();
+
+            case State::KEY:
+                return readKey();
+
+            case State::AFTER_KEY:
+                if (c != ':') {
+                    unexpectedCharacter(char(c));
+                }
+                ++mPosition;
+                mState = State::VALUE;
+                break;
+
+            case State::AFTER_VALUE:
+                if (c == ',') {
+                    ++mPosition;
+                    mState = mStack.back() ? State::KEY : State::VALUE;
+                    break;
+                }
+                if (c == (mStack.back() ? '}' : ']')) {
+                    ++mPosition;
+                    return close(mStack.back());
+                }
+                unexpectedCharacter(char(c));
+
+            default:
+                break;
+        }
+    }
+}
+
+AJsonReader::Event AJsonReader::readValue(char c) {
+    switch (c) {
+        case '{':
+            ++mPosition;
+            mStack.push_back(true);
+            mState = State::FIRST_KEY;
+            return mEvent = Event::BEGIN_OBJECT;
+
+        case '[':
+            ++mPosition;
+            mStack.push_back(false);
+            mState = State::FIRST_ELEMENT;
+            return mEvent = Event::BEGIN_ARRAY;
+
+        case '"':
+            ++mPosition;
+            readString();
+            mState = State::AFTER_VALUE;
+            return mEvent = Event::STRING;
+
+        case 't':
+        case 'f':
+        case 'n':
+            readToken();
+            mState = State::AFTER_VALUE;
+            if (mString == "true" || mString == "false") {
+                mBool = mString[0] == 't';
+                return mEvent = Event::BOOL;
+            }
+            if (mString == "null") {
+                return mEvent = Event::NULL_VALUE;
+            }
+            fail("unexpected token {}"_format(mString));
+
+        default:
+            if (c != '-' && (c < '0' || c > '9')) {
+                unexpectedCharacter(c);
+            }
+            readToken();
+            mState = State::AFTER_VALUE;
+            aui::impl::json::Number number;
+            if (!aui::impl::json::parseNumber(mString, number)) {
+                fail("invalid number {}"_format(mString));
+            }
+            mIsInteger = number.isInteger;
+            mInteger = number.integer;
+            mDouble = number.floating;
+            return mEvent = Event::NUMBER;
+    }
+}
+
+AJsonReader::Event AJsonReader::readKey() {
+    if (mData[mPosition] != '"') {
+        unexpectedCharacter(mData[mPosition]);
+    }
+    ++mPosition;
+    readString();
+    mState = State::AFTER_KEY;
+    return mEvent = Event::KEY;
+}
+
+AJsonReader::Event AJsonReader::close(bool object) {
+    mStack.pop_back();
+    mState = State::AFTER_VALUE;
+    return mEvent = object ? Event::END_OBJECT : Event::END_ARRAY;
+}
+
+void AJsonReader::readString() {
+    mRaw.clear();
+    bool spilled = false;
+    bool escaped = false;
+    bool hasEscape = false;
+    std::size_t begin = mPosition;
+    const char* quote = nullptr;
+    bool quoteSearched = false;
+    for (;;) {
+        const char* data = mData;
+        if (escaped) {
+            if (mPosition < mEnd) {
+                // the escaped character can't terminate the string
+                escaped = false;
+                ++mPosition;
+                continue;
+            }
+        } else {
+            const char* p = data + mPosition;
+            const char* end = data + mEnd;
+            if (!quoteSearched || (quote && quote < p)) {
+                // search again if the quote found before turned out to be escaped
+                quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+                quoteSearched = true;
+            }
+            const char* stop = quote ? quote : end;
+            if (auto backslash = static_cast<const char*>(std::memchr(p, '\\', stop - p))) {
+                hasEscape = escaped = true;
+                mPosition = backslash - data + 1;
+                continue;
+            }
+            mPosition = stop - data;
+            if (quote) {
+                break;
+            }
+        }
+
+        // the string continues in the next chunk of the stream
+        mRaw.append(data + begin, mEnd - begin);
+        spilled = true;
+        quoteSearched = false;
+        if (!refill()) {
+            fail("unterminated string");
+        }
+        begin = mPosition;
+    }
+
+    std::string_view raw(mData + begin, mPosition - begin);
+    if (spilled) {
+        mRaw.append(raw);
+        raw = mRaw;
+    }
+    ++mPosition;
+
+    if (!hasEscape) {
+        mString = raw;
+        return;
+    }
+    mUnescaped.clear();
+    if (aui::impl::json::unescape(raw, mUnescaped) != std::string_view::npos) {
+        fail("invalid escape sequence");
+    }
+    mString = mUnescaped;
+}
+
+void AJsonReader::readToken() {
+    mRaw.clear();
+    bool spilled = false;
+    std::size_t begin = mPosition;
+    for (;;) {
+        while (mPosition < mEnd && !isDelimiter(mData[mPosition])) {
+            ++mPosition;
+        }
+        if (mPosition < mEnd) {
+            break;
+        }
+        mRaw.append(mData + begin, mEnd - begin);
+        spilled = true;
+        bool more = refill();
+        begin = mPosition;
+        if (!more) {
+            break;
+        }
+    }
+
+    std::string_view raw(mData + begin, mPosition - begin);
+    if (spilled) {
+        mRaw.append(raw);
+        raw = mRaw;
+    }
+    mString = raw;
+}
+
+AString AJsonReader::asString() const {
+    if (mEvent != Event::STRING && mEvent != Event::KEY) {
+        throw AJsonTypeMismatchException("not a string");
+    }
+    return AString::fromUtf8(mString.data(), mString.size());
+}
+
+bool AJsonReader::asBool() const {
+    if (mEvent != Event::BOOL) {
+        throw AJsonTypeMismatchException("not a bool");
+    }
+    return mBool;
+}
+
+int AJsonReader::asInt() const {
+    if (mEvent != Event::NUMBER || !mIsInteger || int(mInteger) != mInteger) {
+        throw AJsonTypeMismatchException("not an int");
+    }
+    return int(mInteger);
+}
+
+std::int64_t AJsonReader::asLongInt() const {
+    if (mEvent != Event::NUMBER || !mIsInteger) {
+        throw AJsonTypeMismatchException("not a long int");
+    }
+    return mInteger;
+}
+
+double AJsonReader::asNumber() const {
+    if (mEvent != Event::NUMBER) {
+        throw AJsonTypeMismatchException("not a number");
+    }
+    return mIsInteger ? double(mInteger) : mDouble;
+}
+
+void AJsonReader::skip() {
+    if (mEvent == Event::KEY) {
+        next();
+    }
+    if (mEvent == Event::BEGIN_OBJECT || mEvent == Event::BEGIN_ARRAY) {
+        for (auto target = depth() - 1; depth() > target;) {
+            next();
+        }
+    }
+}
+
+AJson AJsonReader::value() {
+    if (mEvent == Event::KEY) {
+        next();
+    }
+    switch (mEvent) {
+        case Event::NULL_VALUE:
+            return nullptr;
+        case Event::BOOL:
+            return mBool;
+        case Event::NUMBER: {
+            if (!mIsInteger) {
+                return mDouble;
+            }
+            int basicInt = int(mInteger);
+            if (basicInt == mInteger) {
+                return basicInt;
+            }
+            return mInteger;
+        }
+        case Event::STRING:
+            return AString::fromUtf8(mString.data(), mString.size());
+        case Event::BEGIN_ARRAY: {
+            aui::impl::JsonArray result;
+            while (next() != Event::END_ARRAY) {
+                result << value();
+            }
+            return result;
+        }
+        case Event::BEGIN_OBJECT: {
+            aui::impl::JsonObject result;
+            while (next() != Event::END_OBJECT) {
+                // known keys (i.e. reflected field names) are decoded once, when they are interned
+                auto atom = AStringAtom::find(mString);
+                AString key = atom ? atom->str() : AString::fromUtf8(mString.data(), mString.size());
+                result[std::move(key)] = value();
+            }
+            return result;
+        }
+        default:
+            throw AJsonException("no json value at the current position");
+    }
+}
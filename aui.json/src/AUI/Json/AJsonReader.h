@@ -0,0 +1,210 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <AUI/Common/AByteBufferView.h>
+#include <AUI/Common/AString.h>
+#include <AUI/IO/IInputStream.h>
+
+class AJson;
+
+/**
+ * @brief Streaming json reader.
+ * @ingroup json
+ * @details
+ * Reads json from IInputStream or from the memory event by event without building a tree. Memory usage does not depend on the size of
+ * the document: the reader keeps a fixed size buffer, the nesting stack and the current token only.
+ *
+ * The stream may contain several whitespace separated json values (i.e. newline delimited json); next() returns
+ * Event::END when the stream is over.
+ *
+ * @code{cpp}
+ * AJsonReader reader(stream);
+ * while (reader.next() != AJsonReader::Event::END) {
+ *     // each line is {"level": "...", "message": "..."}
+ *     while (reader.next() == AJsonReader::Event::KEY) {
+ *         if (reader.string() == "message") {
+ *             reader.next();
+ *             messages << reader.asString();
+ *         } else {
+ *             reader.skip();
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+class API_AUI_JSON AJsonReader: public aui::noncopyable {
+public:
+    enum class Event {
+        BEGIN_OBJECT,
+        END_OBJECT,
+        BEGIN_ARRAY,
+        END_ARRAY,
+        KEY,
+        STRING,
+        NUMBER,
+        BOOL,
+        NULL_VALUE,
+
+        /**
+         * @brief The stream is over.
+         */
+        END,
+    };
+
+    /**
+     * @param stream source stream. The stream must outlive the reader.
+     * @param bufferSize size of the read buffer.
+     */
+    explicit AJsonReader(IInputStream& stream, std::size_t bufferSize = 64 * 1024);
+
+    /**
+     * @brief Reads json from the memory without copying it to the reader's buffer.
+     * @param buffer utf8 json. The buffer must outlive the reader.
+     */
+    explicit AJsonReader(AByteBufferView buffer);
+    ~AJsonReader();
+
+    /**
+     * @brief Reads the next event.
+     * @throws AJsonParseException if the input is not a valid json.
+     */
+    Event next();
+
+    [[nodiscard]]
+    Event event() const noexcept {
+        return mEvent;
+    }
+
+    /**
+     * @return number of arrays and objects the reader is currently in.
+     */
+    [[nodiscard]]
+    std::size_t depth() const noexcept {
+        return mStack.size();
+    }
+
+    /**
+     * @return number of bytes of the stream consumed by the reader.
+     */
+    [[nodiscard]]
+    std::uint64_t offset() const noexcept {
+        return mBufferOffset + mPosition;
+    }
+
+    /**
+     * @return utf8 contents of KEY and STRING, text of NUMBER. Valid until the next call to the reader.
+     */
+    [[nodiscard]]
+    std::string_view string() const noexcept {
+        return mString;
+    }
+
+    /**
+     * @return contents of KEY or STRING.
+     */
+    [[nodiscard]]
+    AString asString() const;
+
+    [[nodiscard]]
+    bool asBool() const;
+
+    [[nodiscard]]
+    int asInt() const;
+
+    [[nodiscard]]
+    std::int64_t asLongInt() const;
+
+    [[nodiscard]]
+    double asNumber() const;
+
+    /**
+     * @brief Skips the current value.
+     * @details
+     * If the current event is BEGIN_OBJECT or BEGIN_ARRAY, reads up to the matching end. If the current event is KEY,
+     * skips the value of the field.
+     */
+    void skip();
+
+    /**
+     * @brief Reads the current value to AJson.
+     * @details
+     * If the current event is BEGIN_OBJECT or BEGIN_ARRAY, reads up to the matching end. If the current event is KEY,
+     * reads the value of the field.
+     * @throws AJsonException if there is no value at the current position.
+     */
+    [[nodiscard]]
+    AJson value();
+
+private:
+    enum class State {
+        TOP,
+        VALUE,
+        FIRST_KEY,
+        KEY,
+        AFTER_KEY,
+        FIRST_ELEMENT,
+        AFTER_VALUE,
+    };
+
+    IInputStream* mStream;
+    std::unique_ptr<char[]> mStorage;
+    const char* mData;
+    std::size_t mBufferSize;
+    std::size_t mEnd = 0;
+    std::size_t mPosition = 0;
+    std::uint64_t mBufferOffset = 0;
+
+    /**
+     * @brief Open arrays and objects; true for objects.
+     */
+    std::vector<bool> mStack;
+    State mState = State::TOP;
+    Event mEvent = Event::END;
+
+    std::string_view mString;
+
+    /**
+     * @brief Raw token text when the token does not fit into the buffer.
+     */
+    std::string mRaw;
+
+    /**
+     * @brief Unescaped string.
+     */
+    std::string mUnescaped;
+
+    bool mBool = false;
+    bool mIsInteger = false;
+    std::int64_t mInteger = 0;
+    double mDouble = 0;
+
+    bool refill();
+    int peek();
+    Event readValue(char c);
+    Event readKey();
+    Event close(bool object);
+    void readString();
+    void readToken();
+    [[noreturn]] void fail(const AString& message) const;
+    [[noreturn]] void unexpectedCharacter(char c) const;
+};
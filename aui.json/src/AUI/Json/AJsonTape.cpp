@@ -0,0 +1,664 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AJsonTape.h"
+#include "AJson.h"
+#include "Scalars.h"
+#include <AUI/Common/AStringAtom.h>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AUI_JSON_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUI_JSON_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define AUI_JSON_NEON 1
+#endif
+
+#if defined(__PCLMUL__) && defined(__x86_64__)
+#include <wmmintrin.h>
+#define AUI_JSON_PCLMUL 1
+#endif
+
+using Entry = AJsonTape::Entry;
+
+namespace {
+    constexpr std::size_t BLOCK_SIZE = 64;
+
+    enum CharacterClass: std::uint8_t {
+        OPERATOR = 0b0001,
+        WHITESPACE = 0b0010,
+        QUOTE = 0b0100,
+        BACKSLASH = 0b1000,
+    };
+
+    constexpr std::array<std::uint8_t, 256> CHARACTER_CLASSES = [] {
+        std::array<std::uint8_t, 256> result{};
+        for (unsigned char c : std::string_view("{}[]:,")) result[c] = OPERATOR;
+        for (unsigned char c : std::string_view(" \t\n\r")) result[c] = WHITESPACE;
+        result['"'] = QUOTE;
+        result['\\'] = BACKSLASH;
+        return result;
+    }();
+
+    std::uint8_t characterClass(char c) noexcept {
+        return CHARACTER_CLASSES[static_cast<unsigned char>(c)];
+    }
+
+    [[noreturn]]
+    void throwAt(AByteBufferView input, std::size_t offset, const AString& message) {
+        std::size_t row = 1;
+        std::size_t lineBegin = 0;
+        for (std::size_t i = 0; i < offset && i < input.size(); ++i) {
+            if (input.data()[i] == '\n') {
+                ++row;
+                lineBegin = i + 1;
+            }
+        }
+        throw AJsonParseException("{} at {}:{}"_format(message, row, offset - lineBegin + 1));
+    }
+
+    [[noreturn]]
+    void throwUnexpectedCharacter(AByteBufferView input, std::size_t offset) {
+        throwAt(input, offset, "unexpected character {}"_format(input.data()[offset]));
+    }
+
+    /**
+     * @brief Bit masks of the 64-byte block; bit N corresponds to the byte N.
+     */
+    struct BlockMasks {
+        std::uint64_t op = 0;
+        std::uint64_t whitespace = 0;
+        std::uint64_t quote = 0;
+        std::uint64_t backslash = 0;
+    };
+
+#if AUI_JSON_AVX2
+    BlockMasks classify(const char* block) noexcept {
+        BlockMasks result;
+        for (unsigned offset = 0; offset < BLOCK_SIZE; offset += 32) {
+            auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+            auto eq = [&](char c) { return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c)); };
+            auto mask = [](__m256i v) { return std::uint64_t(std::uint32_t(_mm256_movemask_epi8(v))); };
+
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            auto lowered = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+            auto op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('{')),
+                                _mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(eq(':'), eq(',')));
+            auto whitespace = _mm256_or_si256(_mm256_or_si256(eq(' '), eq('\t')), _mm256_or_si256(eq('\n'), eq('\r')));
+
+            result.op |= mask(op) << offset;
+            result.whitespace |= mask(whitespace) << offset;
+            result.quote |= mask(eq('"')) << offset;
+            result.backslash |= mask(eq('\\')) << offset;
+        }
+        return result;
+    }
+#elif AUI_JSON_SSE2
+    BlockMasks classify(const char* block) noexcept {
+        BlockMasks result;
+        for (unsigned offset = 0; offset < BLOCK_SIZE; offset += 16) {
+            auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+            auto eq = [&](char c) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)); };
+            auto mask = [](__m128i v) { return std::uint64_t(_mm_movemask_epi8(v)); };
+
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            auto lowered = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+            auto op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(lowered, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lowered, _mm_set1_epi8('}'))),
+                _mm_or_si128(eq(':'), eq(',')));
+            auto whitespace = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+
+            result.op |= mask(op) << offset;
+            result.whitespace |= mask(whitespace) << offset;
+            result.quote |= mask(eq('"')) << offset;
+            result.backslash |= mask(eq('\\')) << offset;
+        }
+        return result;
+    }
+#elif AUI_JSON_NEON
+    std::uint64_t toBitmask(const uint8x16_t (&v)[4]) noexcept {
+        static constexpr std::uint8_t BITS[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        const auto bits = vld1q_u8(BITS);
+        auto sum0 = vpaddq_u8(vandq_u8(v[0], bits), vandq_u8(v[1], bits));
+        auto sum1 = vpaddq_u8(vandq_u8(v[2], bits), vandq_u8(v[3], bits));
+        sum0 = vpaddq_u8(sum0, sum1);
+        sum0 = vpaddq_u8(sum0, sum0);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+    }
+
+    BlockMasks classify(const char* block) noexcept {
+        uint8x16_t op[4], whitespace[4], quote[4], backslash[4];
+        for (unsigned i = 0; i < 4; ++i) {
+            auto bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block) + i * 16);
+            auto eq = [&](char c) { return vceqq_u8(bytes, vdupq_n_u8(std::uint8_t(c))); };
+
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            auto lowered = vorrq_u8(bytes, vdupq_n_u8(0x20));
+            op[i] = vorrq_u8(vorrq_u8(vceqq_u8(lowered, vdupq_n_u8('{')), vceqq_u8(lowered, vdupq_n_u8('}'))),
+                             vorrq_u8(eq(':'), eq(',')));
+            whitespace[i] = vorrq_u8(vorrq_u8(eq(' '), eq('\t')), vorrq_u8(eq('\n'), eq('\r')));
+            quote[i] = eq('"');
+            backslash[i] = eq('\\');
+        }
+        return { toBitmask(op), toBitmask(whitespace), toBitmask(quote), toBitmask(backslash) };
+    }
+#else
+    BlockMasks classify(const char* block) noexcept {
+        BlockMasks result;
+        for (unsigned i = 0; i < BLOCK_SIZE; ++i) {
+            auto c = characterClass(block[i]);
+            result.op |= std::uint64_t(c & OPERATOR ? 1 : 0) << i;
+            result.whitespace |= std::uint64_t(c & WHITESPACE ? 1 : 0) << i;
+            result.quote |= std::uint64_t(c & QUOTE ? 1 : 0) << i;
+            result.backslash |= std::uint64_t(c & BACKSLASH ? 1 : 0) << i;
+        }
+        return result;
+    }
+#endif
+
+    /**
+     * @return mask of the characters preceded by an unescaped backslash.
+     * @param carry in: whether the first character of the block is escaped by the previous block; out: whether the
+     *        first character of the next block is escaped.
+     */
+    std::uint64_t findEscaped(std::uint64_t backslash, std::uint64_t& carry) noexcept {
+        std::uint64_t escaped = carry;
+        carry = 0;
+        // backslashes are rare enough to handle them one by one
+        while (backslash != 0) {
+            auto bit = backslash & (~backslash + 1);
+            backslash ^= bit;
+            if (escaped & bit) {
+                continue;
+            }
+            if (bit == std::uint64_t(1) << 63) {
+                carry = 1;
+            } else {
+                escaped |= bit << 1;
+            }
+        }
+        return escaped;
+    }
+
+    /**
+     * @return mask where each bit is xor of all the bits at and below that position, i.e. the mask of the characters
+     *         between the opening quote (inclusive) and the closing quote (exclusive).
+     */
+    std::uint64_t prefixXor(std::uint64_t bits) noexcept {
+#if AUI_JSON_PCLMUL
+        auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, std::int64_t(bits)), _mm_set1_epi8(-1), 0);
+        return std::uint64_t(_mm_cvtsi128_si64(product));
+#else
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+#endif
+    }
+
+    /**
+     * @brief Stage 1: finds positions of the operators, the quotes and the first characters of literals.
+     */
+    std::vector<std::uint32_t> findStructurals(AByteBufferView input) {
+        std::vector<std::uint32_t> positions;
+        positions.reserve(input.size() / 8 + 16);
+
+        std::uint64_t escapedCarry = 0;
+        std::uint64_t inStringCarry = 0;
+        std::uint64_t literalCarry = 0;
+
+        auto processBlock = [&](const char* block, std::uint32_t base) {
+            auto masks = classify(block);
+            auto quote = masks.quote & ~findEscaped(masks.backslash, escapedCarry);
+            auto inString = prefixXor(quote) ^ inStringCarry;
+            inStringCarry = std::uint64_t(std::int64_t(inString) >> 63);
+
+            auto literal = ~(masks.op | masks.whitespace | quote | inString);
+            auto literalStart = literal & ~((literal << 1) | literalCarry);
+            literalCarry = literal >> 63;
+
+            auto structural = (masks.op & ~inString) | quote | literalStart;
+            if (structural == 0) {
+                return;
+            }
+            auto size = positions.size();
+            positions.resize(size + std::popcount(structural));
+            auto out = positions.data() + size;
+            do {
+                *out++ = base + std::uint32_t(std::countr_zero(structural));
+                structural &= structural - 1;
+            } while (structural != 0);
+        };
+
+        std::size_t offset = 0;
+        for (; offset + BLOCK_SIZE <= input.size(); offset += BLOCK_SIZE) {
+            processBlock(input.data() + offset, std::uint32_t(offset));
+        }
+        if (offset < input.size()) {
+            char tail[BLOCK_SIZE];
+            std::memset(tail, ' ', BLOCK_SIZE);
+            std::memcpy(tail, input.data() + offset, input.size() - offset);
+            processBlock(tail, std::uint32_t(offset));
+        }
+        if (inStringCarry) {
+            throwAt(input, input.size(), "unterminated string");
+        }
+        return positions;
+    }
+
+    /**
+     * @return length of the literal (number, true, false, null) starting at the offset.
+     */
+    std::uint32_t literalLength(AByteBufferView input, std::uint32_t offset) noexcept {
+        auto i = offset;
+        for (; i < input.size() && characterClass(input.data()[i]) == 0; ++i);
+        return i - offset;
+    }
+
+    /**
+     * @brief Stage 2: validates the structure and builds the tape.
+     */
+    std::vector<Entry> buildTape(AByteBufferView input, const std::vector<std::uint32_t>& structurals) {
+        std::vector<Entry> tape;
+        tape.reserve(structurals.size() / 2 + 1);
+
+        // indices of the open arrays and objects in the tape
+        std::vector<std::uint32_t> stack;
+
+        std::size_t i = 0;
+        auto next = [&]() -> std::uint32_t {
+            if (i >= structurals.size()) {
+                throw AJsonParseException("unexpected end of json stream");
+            }
+            return structurals[i++];
+        };
+        auto peek = [&]() -> char {
+            if (i >= structurals.size()) {
+                throw AJsonParseException("unexpected end of json stream");
+            }
+            return input.data()[structurals[i]];
+        };
+        auto string = [&](std::uint32_t position) {
+            auto closing = next();
+            tape.push_back({ position + 1, closing - position - 1, std::uint32_t(tape.size() + 1), AJsonTapeType::STRING });
+        };
+        auto literal = [&](std::uint32_t position) {
+            auto length = literalLength(input, position);
+            std::string_view token(input.data() + position, length);
+            AJsonTapeType type;
+            if (token == "true") {
+                type = AJsonTapeType::TRUE_VALUE;
+            } else if (token == "false") {
+                type = AJsonTapeType::FALSE_VALUE;
+            } else if (token == "null") {
+                type = AJsonTapeType::NULL_VALUE;
+            } else if (token[0] == '-' || (token[0] >= '0' && token[0] <= '9')) {
+                // validated when accessed
+                type = AJsonTapeType::NUMBER;
+            } else {
+                throwUnexpectedCharacter(input, position);
+            }
+            tape.push_back({ position, length, std::uint32_t(tape.size() + 1), type });
+        };
+        auto close = [&]() {
+            auto& container = tape[stack.back()];
+            container.next = std::uint32_t(tape.size());
+            stack.pop_back();
+        };
+
+        enum class State {
+            VALUE,
+            FIRST_KEY,
+            KEY,
+            FIRST_ELEMENT,
+            AFTER_VALUE,
+        } state = State::VALUE;
+
+        for (;;) {
+            switch (state) {
+                case State::VALUE: {
+                    auto position = next();
+                    switch (input.data()[position]) {
+                        case '{':
+                            stack.push_back(std::uint32_t(tape.size()));
+                            tape.push_back({ position, 0, 0, AJsonTapeType::OBJECT });
+                            state = State::FIRST_KEY;
+                            continue;
+                        case '[':
+                            stack.push_back(std::uint32_t(tape.size()));
+                            tape.push_back({ position, 0, 0, AJsonTapeType::ARRAY });
+                            state = State::FIRST_ELEMENT;
+                            continue;
+                        case '"':
+                            string(position);
+                            break;
+                        case '}': case ']': case ':': case ',':
+                            throwUnexpectedCharacter(input, position);
+                        default:
+                            literal(position);
+                    }
+                    state = State::AFTER_VALUE;
+                    break;
+                }
+
+                case State::FIRST_KEY:
+                    if (peek() == '}') {
+                        ++i;
+                        close();
+                        state = State::AFTER_VALUE;
+                        break;
+                    }
+                    [[fallthrough]];
+
+                case State::KEY: {
+                    auto position = next();
+                    if (input.data()[position] != '"') {
+                        throwUnexpectedCharacter(input, position);
+                    }
+                    string(position);
+                    position = next();
+                    if (input.data()[position] != ':') {
+                        throwUnexpectedCharacter(input, position);
+                    }
+                    tape[stack.back()].length += 1;
+                    state = State::VALUE;
+                    break;
+                }
+
+                case State::FIRST_ELEMENT:
+                    if (peek() == ']') {
+                        ++i;
+                        close();
+                        state = State::AFTER_VALUE;
+                        break;
+                    }
+                    tape[stack.back()].length += 1;
+                    state = State::VALUE;
+                    break;
+
+                case State::AFTER_VALUE: {
+                    if (stack.empty()) {
+                        if (i != structurals.size()) {
+                            throwUnexpectedCharacter(input, structurals[i]);
+                        }
+                        return tape;
+                    }
+                    auto position = next();
+                    auto& container = tape[stack.back()];
+                    bool isObject = container.type == AJsonTapeType::OBJECT;
+                    switch (input.data()[position]) {
+                        case ',':
+                            if (isObject) {
+                                state = State::KEY;
+                            } else {
+                                container.length += 1;
+                                state = State::VALUE;
+                            }
+                            break;
+                        case '}':
+                            if (!isObject) throwUnexpectedCharacter(input, position);
+                            close();
+                            break;
+                        case ']':
+                            if (isObject) throwUnexpectedCharacter(input, position);
+                            close();
+                            break;
+                        default:
+                            throwUnexpectedCharacter(input, position);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @return utf8 contents of the string; points either to the input buffer or to the buffer.
+     */
+    std::string_view stringContents(AByteBufferView input, const Entry& entry, std::string& buffer) {
+        std::string_view raw(input.data() + entry.offset, entry.length);
+        if (raw.find('\\') == std::string_view::npos) {
+            return raw;
+        }
+        buffer.clear();
+        if (auto error = aui::impl::json::unescape(raw, buffer); error != std::string_view::npos) {
+            throwAt(input, entry.offset + error, "invalid escape sequence");
+        }
+        return buffer;
+    }
+
+    aui::impl::json::Number parseNumber(AByteBufferView input, const Entry& entry) {
+        aui::impl::json::Number result;
+        std::string_view text(input.data() + entry.offset, entry.length);
+        if (!aui::impl::json::parseNumber(text, result)) {
+            throwAt(input, entry.offset, "invalid number {}"_format(text));
+        }
+        return result;
+    }
+
+    bool keyEquals(AByteBufferView input, const Entry& entry, std::string_view key) {
+        std::string_view raw(input.data() + entry.offset, entry.length);
+        if (raw.find('\\') == std::string_view::npos) {
+            return raw == key;
+        }
+        if (raw.size() < key.size()) {
+            return false;
+        }
+        std::string buffer;
+        return stringContents(input, entry, buffer) == key;
+    }
+
+    AJson toJson(const AJsonTape& tape, std::uint32_t index, std::string& buffer) {
+        const auto& entries = tape.entries();
+        const auto& entry = entries[index];
+        switch (entry.type) {
+            case AJsonTapeType::NULL_VALUE:
+                return nullptr;
+            case AJsonTapeType::TRUE_VALUE:
+                return true;
+            case AJsonTapeType::FALSE_VALUE:
+                return false;
+            case AJsonTapeType::NUMBER: {
+                auto number = parseNumber(tape.input(), entry);
+                if (!number.isInteger) {
+                    return number.floating;
+                }
+                int basicInt = int(number.integer);
+                if (basicInt == number.integer) {
+                    return basicInt;
+                }
+                return number.integer;
+            }
+            case AJsonTapeType::STRING: {
+                auto contents = stringContents(tape.input(), entry, buffer);
+                return AString::fromUtf8(contents.data(), contents.size());
+            }
+            case AJsonTapeType::ARRAY: {
+                aui::impl::JsonArray result;
+                result.reserve(entry.length);
+                for (auto i = index + 1; i != entry.next; i = entries[i].next) {
+                    result << toJson(tape, i, buffer);
+                }
+                return result;
+            }
+            case AJsonTapeType::OBJECT: {
+                aui::impl::JsonObject result;
+                for (auto i = index + 1; i != entry.next; i = entries[i + 1].next) {
+                    auto rawKey = stringContents(tape.input(), entries[i], buffer);
+                    // known keys (i.e. reflected field names) are decoded once, when they are interned
+                    auto atom = AStringAtom::find(rawKey);
+                    AString key = atom ? atom->str() : AString::fromUtf8(rawKey.data(), rawKey.size());
+                    result[std::move(key)] = toJson(tape, i + 1, buffer);
+                }
+                return result;
+            }
+        }
+        return {};
+    }
+}
+
+AJsonTape AJsonTape::parse(AByteBufferView buffer) {
+    if (buffer.size() >= std::numeric_limits<std::uint32_t>::max()) {
+        throw AJsonParseException("json documents larger than 4 GiB are not supported");
+    }
+    AJsonTape result(buffer);
+    result.mEntries = buildTape(buffer, findStructurals(buffer));
+    return result;
+}
+
+AJsonTapeType AJsonCursor::type() const noexcept {
+    return mTape->entry(mIndex).type;
+}
+
+std::uint32_t AJsonCursor::next() const noexcept {
+    return mTape->entry(mIndex).next;
+}
+
+void AJsonCursor::expect(AJsonTapeType type, const char* what) const {
+    if (this->type() != type) {
+        throw AJsonTypeMismatchException(what);
+    }
+}
+
+bool AJsonCursor::asBool() const {
+    switch (type()) {
+        case AJsonTapeType::TRUE_VALUE: return true;
+        case AJsonTapeType::FALSE_VALUE: return false;
+        default: throw AJsonTypeMismatchException("not a bool");
+    }
+}
+
+int AJsonCursor::asInt() const {
+    expect(AJsonTapeType::NUMBER, "not an int");
+    auto number = parseNumber(mTape->input(), mTape->entry(mIndex));
+    if (!number.isInteger || int(number.integer) != number.integer) {
+        throw AJsonTypeMismatchException("not an int");
+    }
+    return int(number.integer);
+}
+
+std::int64_t AJsonCursor::asLongInt() const {
+    expect(AJsonTapeType::NUMBER, "not a long int");
+    auto number = parseNumber(mTape->input(), mTape->entry(mIndex));
+    if (!number.isInteger) {
+        throw AJsonTypeMismatchException("not a long int");
+    }
+    return number.integer;
+}
+
+double AJsonCursor::asNumber() const {
+    expect(AJsonTapeType::NUMBER, "not a number");
+    auto number = parseNumber(mTape->input(), mTape->entry(mIndex));
+    return number.isInteger ? double(number.integer) : number.floating;
+}
+
+std::variant<std::int64_t, double> AJsonCursor::asIntegerOrDouble() const {
+    expect(AJsonTapeType::NUMBER, "not a number");
+    auto number = parseNumber(mTape->input(), mTape->entry(mIndex));
+    if (number.isInteger) {
+        return number.integer;
+    }
+    return number.floating;
+}
+
+std::string_view AJsonCursor::rawString() const {
+    expect(AJsonTapeType::STRING, "not a string");
+    return mTape->view(mTape->entry(mIndex));
+}
+
+AString AJsonCursor::asString() const {
+    expect(AJsonTapeType::STRING, "not a string");
+    std::string buffer;
+    auto contents = stringContents(mTape->input(), mTape->entry(mIndex), buffer);
+    return AString::fromUtf8(contents.data(), contents.size());
+}
+
+AUtf8String AJsonCursor::asUtf8String() const {
+    expect(AJsonTapeType::STRING, "not a string");
+    std::string buffer;
+    auto contents = stringContents(mTape->input(), mTape->entry(mIndex), buffer);
+    if (contents.data() == buffer.data()) {
+        return std::move(buffer);
+    }
+    return contents;
+}
+
+std::size_t AJsonCursor::size() const {
+    if (!isArray() && !isObject()) {
+        throw AJsonTypeMismatchException("not an array or object");
+    }
+    return mTape->entry(mIndex).length;
+}
+
+AOptional<AJsonCursor> AJsonCursor::find(std::string_view key) const {
+    for (auto [k, v] : fields()) {
+        if (keyEquals(mTape->input(), mTape->entry(k.mIndex), key)) {
+            return v;
+        }
+    }
+    return std::nullopt;
+}
+
+AJsonCursor AJsonCursor::operator[](std::string_view key) const {
+    if (auto v = find(key)) {
+        return *v;
+    }
+    throw AJsonException(R"(field "{}" is not present)"_format(key));
+}
+
+AJsonCursor AJsonCursor::operator[](std::size_t index) const {
+    expect(AJsonTapeType::ARRAY, "not an array");
+    if (index >= mTape->entry(mIndex).length) {
+        throw AJsonException("index {} is out of bounds"_format(index));
+    }
+    auto it = begin();
+    for (; index > 0; --index) {
+        ++it;
+    }
+    return *it;
+}
+
+AJsonCursor::Iterator AJsonCursor::begin() const {
+    expect(AJsonTapeType::ARRAY, "not an array");
+    return { *mTape, mIndex + 1 };
+}
+
+AJsonCursor::Iterator AJsonCursor::end() const {
+    expect(AJsonTapeType::ARRAY, "not an array");
+    return { *mTape, next() };
+}
+
+AJsonCursor::FieldRange AJsonCursor::fields() const {
+    expect(AJsonTapeType::OBJECT, "not an object");
+    return { { *mTape, mIndex + 1 }, { *mTape, next() } };
+}
+
+AJson AJsonCursor::toJson() const {
+    std::string buffer;
+    return ::toJson(*mTape, mIndex, buffer);
+}
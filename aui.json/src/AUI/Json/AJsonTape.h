@@ -0,0 +1,377 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include <AUI/Common/AByteBufferView.h>
+#include <AUI/Common/AOptional.h>
+#include <AUI/Common/AString.h>
+#include <AUI/Common/AUtf8String.h>
+
+class AJson;
+class AJsonTape;
+
+/**
+ * @brief Type of a json value in AJsonTape.
+ * @ingroup json
+ */
+enum class AJsonTapeType: std::uint8_t {
+    NULL_VALUE,
+    TRUE_VALUE,
+    FALSE_VALUE,
+    NUMBER,
+    STRING,
+    ARRAY,
+    OBJECT,
+};
+
+/**
+ * @brief Read-only cursor to a value of AJsonTape.
+ * @ingroup json
+ * @details
+ * Strings and numbers are decoded on access, so the values the application does not read are never decoded; skipping
+ * of an array or an object is O(1). Cursor is a pair of pointers and is meant to be passed by value. It is valid as
+ * long as the AJsonTape it belongs to and the tape's input buffer are alive.
+ *
+ * @code{cpp}
+ * auto tape = AJsonTape::parse(buffer);
+ * for (auto user : tape.root()["users"]) {
+ *     if (user["active"].asBool()) {
+ *         names << user["name"].asString();
+ *     }
+ * }
+ * @endcode
+ */
+class API_AUI_JSON AJsonCursor {
+public:
+    class Iterator;
+    struct Field;
+    class FieldIterator;
+    struct FieldRange;
+
+    AJsonCursor(const AJsonTape& tape, std::uint32_t index) noexcept: mTape(&tape), mIndex(index) {}
+
+    [[nodiscard]]
+    AJsonTapeType type() const noexcept;
+
+    [[nodiscard]]
+    bool isNull() const noexcept {
+        return type() == AJsonTapeType::NULL_VALUE;
+    }
+
+    [[nodiscard]]
+    bool isBool() const noexcept {
+        return type() == AJsonTapeType::TRUE_VALUE || type() == AJsonTapeType::FALSE_VALUE;
+    }
+
+    [[nodiscard]]
+    bool isNumber() const noexcept {
+        return type() == AJsonTapeType::NUMBER;
+    }
+
+    [[nodiscard]]
+    bool isString() const noexcept {
+        return type() == AJsonTapeType::STRING;
+    }
+
+    [[nodiscard]]
+    bool isArray() const noexcept {
+        return type() == AJsonTapeType::ARRAY;
+    }
+
+    [[nodiscard]]
+    bool isObject() const noexcept {
+        return type() == AJsonTapeType::OBJECT;
+    }
+
+    [[nodiscard]]
+    bool asBool() const;
+
+    /**
+     * @throws AJsonTypeMismatchException if the value is not an integer or does not fit into int.
+     */
+    [[nodiscard]]
+    int asInt() const;
+
+    /**
+     * @throws AJsonTypeMismatchException if the value is not an integer or does not fit into int64_t.
+     */
+    [[nodiscard]]
+    std::int64_t asLongInt() const;
+
+    [[nodiscard]]
+    double asNumber() const;
+
+    /**
+     * @return the number as int64_t if it is an integer which fits into int64_t; as double otherwise.
+     */
+    [[nodiscard]]
+    std::variant<std::int64_t, double> asIntegerOrDouble() const;
+
+    [[nodiscard]]
+    AString asString() const;
+
+    [[nodiscard]]
+    AUtf8String asUtf8String() const;
+
+    /**
+     * @return string contents as they are written in the input buffer, i.e. with escape sequences not decoded.
+     */
+    [[nodiscard]]
+    std::string_view rawString() const;
+
+    /**
+     * @return number of elements of an array or number of fields of an object.
+     */
+    [[nodiscard]]
+    std::size_t size() const;
+
+    /**
+     * @brief Looks up the object field.
+     * @param key utf8 field name
+     * @return value of the field, if present.
+     */
+    [[nodiscard]]
+    AOptional<AJsonCursor> find(std::string_view key) const;
+
+    [[nodiscard]]
+    bool contains(std::string_view key) const {
+        return find(key).hasValue();
+    }
+
+    /**
+     * @brief Value of the object field.
+     * @throws AJsonException if the field is not present.
+     */
+    [[nodiscard]]
+    AJsonCursor operator[](std::string_view key) const;
+
+    /**
+     * @brief Value of the object field.
+     * @throws AJsonException if the field is not present.
+     */
+    [[nodiscard]]
+    AJsonCursor operator[](const char* key) const {
+        return (*this)[std::string_view(key)];
+    }
+
+    /**
+     * @brief Array element. O(index).
+     * @throws AJsonException if the index is out of bounds.
+     */
+    [[nodiscard]]
+    AJsonCursor operator[](std::size_t index) const;
+
+    [[nodiscard]]
+    AJsonCursor operator[](int index) const {
+        return (*this)[std::size_t(index)];
+    }
+
+    /**
+     * @brief Iterates array elements.
+     */
+    [[nodiscard]]
+    Iterator begin() const;
+
+    [[nodiscard]]
+    Iterator end() const;
+
+    /**
+     * @brief Object fields range.
+     * @code{cpp}
+     * for (auto [key, value] : cursor.fields()) { ... }
+     * @endcode
+     */
+    [[nodiscard]]
+    FieldRange fields() const;
+
+    /**
+     * @brief Builds AJson of the value and its children.
+     */
+    [[nodiscard]]
+    AJson toJson() const;
+
+    [[nodiscard]]
+    const AJsonTape& tape() const noexcept {
+        return *mTape;
+    }
+
+    [[nodiscard]]
+    std::uint32_t index() const noexcept {
+        return mIndex;
+    }
+
+    [[nodiscard]]
+    bool operator==(const AJsonCursor& other) const noexcept {
+        return mTape == other.mTape && mIndex == other.mIndex;
+    }
+
+private:
+    const AJsonTape* mTape;
+    std::uint32_t mIndex;
+
+    void expect(AJsonTapeType type, const char* what) const;
+    [[nodiscard]] std::uint32_t next() const noexcept;
+};
+
+/**
+ * @brief Parsed json document.
+ * @ingroup json
+ * @details
+ * Parsing is done in two stages. The first stage finds the structural characters (braces, brackets, colons, commas,
+ * quotes and the beginnings of literals) of 64-byte blocks at once using bit masks, which are computed with AVX2/SSE2
+ * on x86 and NEON on AArch64. The second stage validates the structure and builds the tape: a flat array of values in
+ * document order, where each array and object knows the position of its end.
+ *
+ * Strings and numbers are not decoded during the parsing; AJsonCursor decodes the values the application actually
+ * reads. AJsonCursor::toJson builds the usual AJson tree.
+ *
+ * The tape refers to the input buffer, so the buffer must outlive the tape. Documents up to 4 GiB are supported.
+ */
+class API_AUI_JSON AJsonTape {
+    friend class AJsonCursor;
+public:
+    struct Entry {
+        /**
+         * @brief Offset of the value in the input buffer. For strings, offset of the first character after the quote.
+         */
+        std::uint32_t offset;
+
+        /**
+         * @brief Byte length of strings and numbers; element count of arrays and objects.
+         */
+        std::uint32_t length;
+
+        /**
+         * @brief Index of the entry following this value and its children.
+         */
+        std::uint32_t next;
+
+        AJsonTapeType type;
+    };
+
+    AJsonTape(AJsonTape&&) noexcept = default;
+    AJsonTape& operator=(AJsonTape&&) noexcept = default;
+
+    /**
+     * @brief Parses utf8 json.
+     * @param buffer input buffer. The buffer must outlive the tape.
+     * @throws AJsonParseException if the input is not a valid json.
+     */
+    [[nodiscard]]
+    static AJsonTape parse(AByteBufferView buffer);
+
+    [[nodiscard]]
+    AJsonCursor root() const noexcept {
+        return { *this, 0 };
+    }
+
+    [[nodiscard]]
+    AByteBufferView input() const noexcept {
+        return mInput;
+    }
+
+    [[nodiscard]]
+    const std::vector<Entry>& entries() const noexcept {
+        return mEntries;
+    }
+
+private:
+    AByteBufferView mInput;
+    std::vector<Entry> mEntries;
+
+    explicit AJsonTape(AByteBufferView input) noexcept: mInput(input) {}
+
+    [[nodiscard]]
+    const Entry& entry(std::uint32_t index) const noexcept {
+        return mEntries[index];
+    }
+
+    [[nodiscard]]
+    std::string_view view(const Entry& entry) const noexcept {
+        return { mInput.data() + entry.offset, entry.length };
+    }
+};
+
+class AJsonCursor::Iterator {
+public:
+    Iterator(const AJsonTape& tape, std::uint32_t index) noexcept: mTape(&tape), mIndex(index) {}
+
+    AJsonCursor operator*() const noexcept {
+        return { *mTape, mIndex };
+    }
+
+    Iterator& operator++() noexcept {
+        mIndex = mTape->entries()[mIndex].next;
+        return *this;
+    }
+
+    bool operator==(const Iterator& other) const noexcept {
+        return mIndex == other.mIndex;
+    }
+
+    bool operator!=(const Iterator& other) const noexcept {
+        return mIndex != other.mIndex;
+    }
+
+private:
+    const AJsonTape* mTape;
+    std::uint32_t mIndex;
+};
+
+struct AJsonCursor::Field {
+    AJsonCursor key;
+    AJsonCursor value;
+};
+
+class AJsonCursor::FieldIterator {
+public:
+    FieldIterator(const AJsonTape& tape, std::uint32_t index) noexcept: mTape(&tape), mIndex(index) {}
+
+    Field operator*() const noexcept {
+        return { { *mTape, mIndex }, { *mTape, mIndex + 1 } };
+    }
+
+    FieldIterator& operator++() noexcept {
+        // keys are always followed by their values
+        mIndex = mTape->entries()[mIndex + 1].next;
+        return *this;
+    }
+
+    bool operator==(const FieldIterator& other) const noexcept {
+        return mIndex == other.mIndex;
+    }
+
+    bool operator!=(const FieldIterator& other) const noexcept {
+        return mIndex != other.mIndex;
+    }
+
+private:
+    const AJsonTape* mTape;
+    std::uint32_t mIndex;
+};
+
+struct AJsonCursor::FieldRange {
+    FieldIterator first;
+    FieldIterator last;
+
+    [[nodiscard]] FieldIterator begin() const noexcept { return first; }
+    [[nodiscard]] FieldIterator end() const noexcept { return last; }
+};
@@ -0,0 +1,210 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AJsonWriter.h"
+#include "AJson.h"
+#include "Scalars.h"
+#include <AUI/Common/AUtf8.h>
+#include <AUI/Logging/ALogger.h>
+#include <AUI/Traits/callables.h>
+
+static constexpr auto LOG_TAG = "AJsonWriter";
+
+AJsonWriter::AJsonWriter(IOutputStream& stream, std::size_t bufferSize):
+    mStream(stream),
+    mBufferSize(bufferSize) {
+    mBuffer.reserve(bufferSize + aui::impl::json::MAX_NUMBER_LENGTH);
+}
+
+AJsonWriter::~AJsonWriter() {
+    try {
+        flush();
+    } catch (const AException& e) {
+        ALogger::err(LOG_TAG) << "Could not flush json: " << e;
+    } catch (const std::exception& e) {
+        ALogger::err(LOG_TAG) << "Could not flush json: " << e.what();
+    }
+}
+
+void AJsonWriter::flush() {
+    if (mBuffer.empty()) {
+        return;
+    }
+    mStream.write(mBuffer.data(), mBuffer.size());
+    mBuffer.clear();
+}
+
+void AJsonWriter::beforeValue() {
+    if (mStack.empty()) {
+        if (mTopLevelWritten) {
+            mBuffer += '\n';
+        }
+        mTopLevelWritten = true;
+        return;
+    }
+    auto& frame = mStack.back();
+    if (frame.object) {
+        if (!mAfterKey) {
+            throw AJsonException("json object field must have a key");
+        }
+        mAfterKey = false;
+        return;
+    }
+    if (!frame.empty) {
+        mBuffer += ',';
+    }
+    frame.empty = false;
+}
+
+void AJsonWriter::afterValue() {
+    if (mBuffer.size() >= mBufferSize) {
+        flush();
+    }
+}
+
+AJsonWriter& AJsonWriter::raw(std::string_view text) {
+    beforeValue();
+    mBuffer += text;
+    afterValue();
+    return *this;
+}
+
+std::string_view AJsonWriter::encode(const AString& string) {
+    std::wstring_view wide(string.data(), string.length());
+    mEncoded.resize(aui::utf8::encodedLength(wide));
+    auto end = aui::utf8::encode(wide, mEncoded.data());
+    return { mEncoded.data(), std::size_t(end - mEncoded.data()) };
+}
+
+AJsonWriter& AJsonWriter::beginObject() {
+    beforeValue();
+    mBuffer += '{';
+    mStack.push_back({ true, true });
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::endObject() {
+    if (mStack.empty() || !mStack.back().object || mAfterKey) {
+        throw AJsonException("endObject does not match beginObject");
+    }
+    mStack.pop_back();
+    mBuffer += '}';
+    afterValue();
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::beginArray() {
+    beforeValue();
+    mBuffer += '[';
+    mStack.push_back({ false, true });
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::endArray() {
+    if (mStack.empty() || mStack.back().object) {
+        throw AJsonException("endArray does not match beginArray");
+    }
+    mStack.pop_back();
+    mBuffer += ']';
+    afterValue();
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::key(std::string_view utf8) {
+    if (mStack.empty() || !mStack.back().object || mAfterKey) {
+        throw AJsonException("json key must be written inside of an object");
+    }
+    auto& frame = mStack.back();
+    if (!frame.empty) {
+        mBuffer += ',';
+    }
+    frame.empty = false;
+    aui::impl::json::appendEscaped(mBuffer, utf8);
+    mBuffer += ':';
+    mAfterKey = true;
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::key(const AString& name) {
+    return key(encode(name));
+}
+
+AJsonWriter& AJsonWriter::value(std::nullptr_t) {
+    return raw("null");
+}
+
+AJsonWriter& AJsonWriter::value(bool value) {
+    return raw(value ? "true" : "false");
+}
+
+AJsonWriter& AJsonWriter::value(double value) {
+    char buffer[aui::impl::json::MAX_NUMBER_LENGTH];
+    auto end = aui::impl::json::formatNumber(buffer, value);
+    return raw(std::string_view(buffer, end - buffer));
+}
+
+AJsonWriter& AJsonWriter::value(std::string_view utf8) {
+    beforeValue();
+    aui::impl::json::appendEscaped(mBuffer, utf8);
+    afterValue();
+    return *this;
+}
+
+AJsonWriter& AJsonWriter::value(const AString& value) {
+    return this->value(encode(value));
+}
+
+AJsonWriter& AJsonWriter::value(const AJson& value) {
+    std::visit(aui::lambda_overloaded {
+        [&](std::nullopt_t) {
+            // empty value
+        },
+        [&](std::nullptr_t v) {
+            this->value(v);
+        },
+        [&](int v) {
+            this->value(v);
+        },
+        [&](int64_t v) {
+            this->value(v);
+        },
+        [&](double v) {
+            this->value(v);
+        },
+        [&](bool v) {
+            this->value(v);
+        },
+        [&](const AString& v) {
+            this->value(v);
+        },
+        [&](const aui::impl::JsonArray& v) {
+            beginArray();
+            for (const auto& element : v) {
+                this->value(element);
+            }
+            endArray();
+        },
+        [&](const aui::impl::JsonObject& v) {
+            beginObject();
+            for (const auto& [name, element] : v) {
+                key(name);
+                this->value(element);
+            }
+            endObject();
+        },
+    }, static_cast<const aui::impl::JsonVariant&>(value));
+    return *this;
+}
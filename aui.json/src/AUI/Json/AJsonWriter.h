@@ -0,0 +1,139 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <AUI/Common/AString.h>
+#include <AUI/IO/IOutputStream.h>
+
+class AJson;
+
+/**
+ * @brief Incremental json writer.
+ * @ingroup json
+ * @details
+ * Writes json to IOutputStream without building a tree. The output is collected to a buffer of a fixed size which is
+ * written to the stream when it is full, on flush() and on destruction. Numbers are formatted directly to the buffer;
+ * doubles are written with the shortest representation which parses back to the same value.
+ *
+ * Several values written at the top level are separated by newlines (i.e. newline delimited json).
+ *
+ * @code{cpp}
+ * AJsonWriter writer(stream);
+ * writer.beginArray();
+ * for (const auto& user : users) {
+ *     writer.beginObject()
+ *           .key("name").value(user.name)
+ *           .key("age").value(user.age)
+ *           .endObject();
+ * }
+ * writer.endArray();
+ * @endcode
+ */
+class API_AUI_JSON AJsonWriter: public aui::noncopyable {
+public:
+    /**
+     * @param stream destination stream. The stream must outlive the writer.
+     * @param bufferSize size of the buffer.
+     */
+    explicit AJsonWriter(IOutputStream& stream, std::size_t bufferSize = 16 * 1024);
+
+    /**
+     * @brief Flushes the buffer. Errors are logged; call flush() explicitly to handle them.
+     */
+    ~AJsonWriter();
+
+    AJsonWriter& beginObject();
+    AJsonWriter& endObject();
+    AJsonWriter& beginArray();
+    AJsonWriter& endArray();
+
+    /**
+     * @brief Writes the field name. Should be followed by the field value.
+     * @param utf8 field name
+     */
+    AJsonWriter& key(std::string_view utf8);
+
+    AJsonWriter& key(const char* utf8) {
+        return key(std::string_view(utf8));
+    }
+
+    AJsonWriter& key(const AString& name);
+
+    AJsonWriter& value(std::nullptr_t);
+    AJsonWriter& value(bool value);
+
+    template<std::integral T>
+    AJsonWriter& value(T value) {
+        char buffer[24];
+        return raw(std::string_view(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer));
+    }
+
+    /**
+     * @brief Writes the number. NaN and infinities are written as null.
+     */
+    AJsonWriter& value(double value);
+
+    /**
+     * @param utf8 string contents
+     */
+    AJsonWriter& value(std::string_view utf8);
+
+    AJsonWriter& value(const char* utf8) {
+        return value(std::string_view(utf8));
+    }
+
+    AJsonWriter& value(const AString& value);
+
+    /**
+     * @brief Writes AJson value and its children.
+     */
+    AJsonWriter& value(const AJson& value);
+
+    /**
+     * @brief Writes the buffer to the stream.
+     */
+    void flush();
+
+private:
+    struct Frame {
+        bool object;
+        bool empty;
+    };
+
+    IOutputStream& mStream;
+    std::size_t mBufferSize;
+    std::string mBuffer;
+    std::vector<Frame> mStack;
+    bool mAfterKey = false;
+    bool mTopLevelWritten = false;
+
+    /**
+     * @brief Utf8 encoding of AString.
+     */
+    std::string mEncoded;
+
+    void beforeValue();
+    void afterValue();
+    AJsonWriter& raw(std::string_view text);
+    std::string_view encode(const AString& string);
+};
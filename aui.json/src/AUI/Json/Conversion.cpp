@@ -0,0 +1,76 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Conversion.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+aui::impl::json::FieldIndex::FieldIndex(const std::vector<std::string_view>& names) {
+    auto bucketCount = std::bit_ceil(std::max(names.size(), std::size_t(1)));
+    mBucketMask = bucketCount - 1;
+    mSeeds.resize(bucketCount);
+
+    // load factor <= 0.5 lets a suitable seed of a bucket be found in a few attempts
+    mSlots.resize(bucketCount * 2);
+
+    std::vector<std::vector<std::size_t>> buckets(bucketCount);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto& bucket = buckets[hashOf(names[i]) & mBucketMask];
+        if (std::none_of(bucket.begin(), bucket.end(), [&](std::size_t other) { return names[other] == names[i]; })) {
+            bucket.push_back(i);
+        }
+    }
+
+    // place the largest buckets first while most of the slots are free
+    std::vector<std::size_t> order(bucketCount);
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t l, std::size_t r) {
+        return buckets[l].size() > buckets[r].size();
+    });
+
+    std::vector<std::size_t> slots;
+    for (auto bucketIndex : order) {
+        const auto& bucket = buckets[bucketIndex];
+        if (bucket.empty()) {
+            break;
+        }
+        for (std::uint32_t seed = 0;; ++seed) {
+            if (seed == std::numeric_limits<std::uint32_t>::max()) {
+                // distinct names with the same 64-bit hash
+                throw AJsonException("could not build the json field index");
+            }
+            slots.clear();
+            bool fits = std::all_of(bucket.begin(), bucket.end(), [&](std::size_t i) {
+                auto slot = slotOf(hashOf(names[i]), seed);
+                if (mSlots[slot].index != NOT_FOUND || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    return false;
+                }
+                slots.push_back(slot);
+                return true;
+            });
+            if (fits) {
+                mSeeds[bucketIndex] = seed;
+                for (std::size_t j = 0; j < bucket.size(); ++j) {
+                    mSlots[slots[j]] = { names[bucket[j]], bucket[j] };
+                }
+                break;
+            }
+        }
+    }
+}
@@ -17,12 +17,19 @@
 #pragma once
 
 #include <AUI/Json/AJson.h>
+#include <AUI/Json/AJsonReader.h>
+#include <AUI/Json/AJsonTape.h>
+#include <AUI/Json/AJsonWriter.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/Common/AUtf8String.h>
+#include <AUI/Common/AStringAtom.h>
 #include <AUI/IO/APath.h>
 #include "AUI/Traits/parameter_pack.h"
 #include "AUI/Traits/members.h"
 #include <AUI/Util/EnumUtil.h>
 #include <AUI/Reflect/AEnumerate.h>
 #include <AUI/Traits/strings.h>
+#include <bitset>
 
 /**
  * <p>Json conversion trait.</p>
@@ -33,6 +40,17 @@
  * <p><code>static AJson to_json(const T&)</code> converts the type to <a href="AJson">AJson</a></p>
  * <p><code>static T from_json(const AJson&)</code> converts <a href="AJson">AJson</a> to the type</p>
  * <p>
+ *     Optional <code>static void fromJson(AJsonCursor, T&)</code> reads the type directly from the parsed document
+ *     (see <a href="AJsonTape">AJsonTape</a>) without building AJson; otherwise, aui::from_json builds AJson of the
+ *     cursor and uses the AJson overload.
+ * </p>
+ * <p>
+ *     Optional <code>static void write(AJsonWriter&, const T&)</code> and
+ *     <code>static void read(AJsonReader&, T&)</code> write and read json text directly, without building AJson
+ *     (see <a href="aui::to_json_string">aui::to_json_string</a>/<a href="aui::from_json_buffer">aui::from_json_buffer</a>);
+ *     otherwise, AJson is built and written or read.
+ * </p>
+ * <p>
  * <code>
  * template<> <br />
  * struct AJsonConv<YOURTYPE> { <br />
@@ -69,6 +87,98 @@ namespace aui {
         static_assert(aui::has_json_converter<T>, "this type does not implement AJsonConv<T> trait");
         AJsonConv<T>::fromJson(v, dst);
     }
+
+    template<typename T>
+    constexpr bool has_json_cursor_converter = requires(AJsonCursor cursor, T& dst) {
+        AJsonConv<T>::fromJson(cursor, dst);
+    };
+
+    template<typename T>
+    inline void from_json(AJsonCursor v, T& dst) {
+        static_assert(aui::has_json_converter<T>, "this type does not implement AJsonConv<T> trait");
+        if constexpr (aui::has_json_cursor_converter<T>) {
+            AJsonConv<T>::fromJson(v, dst);
+        } else {
+            AJsonConv<T>::fromJson(v.toJson(), dst);
+        }
+    }
+
+    template<typename T>
+    inline T from_json(AJsonCursor v) {
+        T dst;
+        aui::from_json(v, dst);
+        return dst;
+    }
+
+    template<typename T>
+    constexpr bool has_json_writer = requires(AJsonWriter& writer, const T& value) {
+        AJsonConv<T>::write(writer, value);
+    };
+
+    template<typename T>
+    constexpr bool has_json_reader = requires(AJsonReader& reader, T& dst) {
+        AJsonConv<T>::read(reader, dst);
+    };
+
+    /**
+     * @brief Writes the value with the writer.
+     */
+    template<typename T>
+    inline void write_json(AJsonWriter& writer, const T& value) {
+        static_assert(aui::has_json_converter<T>, "this type does not implement AJsonConv<T> trait");
+        if constexpr (aui::has_json_writer<T>) {
+            AJsonConv<T>::write(writer, value);
+        } else {
+            writer.value(AJsonConv<T>::toJson(value));
+        }
+    }
+
+    /**
+     * @brief Reads the value the reader is positioned at, i.e. the reader's current event is the first event of the
+     * value.
+     */
+    template<typename T>
+    inline void read_json(AJsonReader& reader, T& dst) {
+        static_assert(aui::has_json_converter<T>, "this type does not implement AJsonConv<T> trait");
+        if constexpr (aui::has_json_reader<T>) {
+            AJsonConv<T>::read(reader, dst);
+        } else {
+            AJsonConv<T>::fromJson(reader.value(), dst);
+        }
+    }
+
+    /**
+     * @brief Converts the value to utf8 json text without building AJson.
+     */
+    template<typename T>
+    inline AUtf8String to_json_string(const T& value) {
+        AByteBuffer buffer;
+        {
+            AJsonWriter writer(buffer);
+            aui::write_json(writer, value);
+            writer.flush();
+        }
+        return AUtf8String(buffer);
+    }
+
+    /**
+     * @brief Parses utf8 json text to the value without building AJson.
+     */
+    template<typename T>
+    inline void from_json_buffer(AByteBufferView buffer, T& dst) {
+        AJsonReader reader(buffer);
+        if (reader.next() == AJsonReader::Event::END) {
+            throw AJsonParseException("unexpected end of json stream");
+        }
+        aui::read_json(reader, dst);
+    }
+
+    template<typename T>
+    inline T from_json_buffer(AByteBufferView buffer) {
+        T dst;
+        aui::from_json_buffer(buffer, dst);
+        return dst;
+    }
 }
 
 // win fix
@@ -88,16 +198,98 @@ AUI_ENUM_FLAG(AJsonFieldFlags) {
 
 namespace aui::impl::json {
 
+    /**
+     * @brief Perfect hash table of the field names of a type.
+     * @details
+     * Built once per type (see fieldIndex). Keys are hashed once; the hash selects a bucket which stores the seed
+     * that maps the keys of the bucket to distinct slots, so the lookup is a single comparison of the key with the
+     * only field name it can match.
+     */
+    class API_AUI_JSON FieldIndex {
+    public:
+        static constexpr std::size_t NOT_FOUND = std::size_t(-1);
+
+        /**
+         * @param names utf8 field names. The strings must outlive the index.
+         */
+        explicit FieldIndex(const std::vector<std::string_view>& names);
+
+        /**
+         * @return index of the field name in the names passed to the constructor or NOT_FOUND.
+         */
+        [[nodiscard]]
+        std::size_t find(std::string_view key) const noexcept {
+            auto hash = hashOf(key);
+            const auto& slot = mSlots[slotOf(hash, mSeeds[hash & mBucketMask])];
+            return slot.name == key ? slot.index : NOT_FOUND;
+        }
+
+    private:
+        struct Slot {
+            std::string_view name;
+            std::size_t index = NOT_FOUND;
+        };
+        std::vector<std::uint32_t> mSeeds;
+        std::vector<Slot> mSlots;
+        std::size_t mBucketMask;
+
+        static std::uint64_t hashOf(std::string_view key) noexcept {
+            // FNV-1a
+            std::uint64_t hash = 0xcbf29ce484222325;
+            for (unsigned char c : key) {
+                hash = (hash ^ c) * 0x100000001b3;
+            }
+            return hash;
+        }
+
+        [[nodiscard]]
+        std::size_t slotOf(std::uint64_t hash, std::uint32_t seed) const noexcept {
+            hash ^= (hash >> 29) + seed * 0x9e3779b97f4a7c15;
+            hash *= 0xbf58476d1ce4e5b9;
+            return (hash ^ (hash >> 32)) & (mSlots.size() - 1);
+        }
+    };
+
+    /**
+     * @brief FieldIndex of the type T which is described by the fields tuple.
+     */
+    template<typename T, typename Fields>
+    const FieldIndex& fieldIndex(const Fields& fields) {
+        static const FieldIndex index = std::apply([](const auto&... field) {
+            return FieldIndex({ field.name.view()... });
+        }, fields);
+        return index;
+    }
+
+    /**
+     * @brief Calls the callback with the field of the tuple at the runtime index.
+     */
+    template<typename Fields, typename Callback>
+    void visitField(Fields& fields, std::size_t index, Callback&& callback) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            using Function = void(*)(Fields&, Callback&);
+            static constexpr Function FUNCTIONS[] = {
+                [](Fields& fields, Callback& callback) { callback(std::get<I>(fields)); }...
+            };
+            FUNCTIONS[index](fields, callback);
+        }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    }
+
     template<typename T>
     struct Field {
         T& value;
-        const char* name;
+
+        /**
+         * @brief Interned, so the parser does not decode the keys with this name again (see AStringAtom::find), and
+         * the lookups do not allocate a temporary key.
+         */
+        AStringAtom name;
         AJsonFieldFlags flags;
 
         Field(T& value, const char* name, AJsonFieldFlags flags) : value(value), name(name), flags(flags) {}
 
         void operator()(const AJson::Object& object) {
-            if (auto c = object.contains(name)) {
+            if (auto c = object.contains(name.str())) {
                 value = aui::from_json<T>(c->second);
             } else {
                 if (!(flags & AJsonFieldFlags::OPTIONAL)) {
@@ -106,7 +298,7 @@ namespace aui::impl::json {
             }
         }
         void operator()(AJson::Object& object) {
-            object[name] = aui::to_json<T>(value);
+            object[name.str()] = aui::to_json<T>(value);
         }
     };
 
@@ -217,6 +409,77 @@ struct AJsonConv<T, std::enable_if_t<aui::is_complete<AJsonConvFieldDescriptor<T
             }, fields...);
         }, ((AJsonConvFieldDescriptor<T>&)dst)().stdTuple());
     }
+
+    static void fromJson(AJsonCursor json, T& dst) {
+        if (!json.isObject()) {
+            throw AJsonTypeMismatchException("not an object");
+        }
+        auto fields = ((AJsonConvFieldDescriptor<T>&)dst)().stdTuple();
+        const auto& index = aui::impl::json::fieldIndex<T>(fields);
+        std::bitset<std::tuple_size_v<decltype(fields)>> present;
+        for (auto [key, value] : json.fields()) {
+            auto name = key.rawString();
+            auto i = name.find('\\') == std::string_view::npos ? index.find(name)
+                                                                : index.find(key.asUtf8String().view());
+            if (i == aui::impl::json::FieldIndex::NOT_FOUND) {
+                continue;
+            }
+            aui::impl::json::visitField(fields, i, [&](auto& field) {
+                aui::from_json(value, field.value);
+            });
+            present.set(i);
+        }
+        checkPresent(fields, present);
+    }
+
+    /**
+     * @brief Writes the fields in the order of declaration.
+     */
+    static void write(AJsonWriter& writer, const T& value) {
+        writer.beginObject();
+        std::apply([&](auto&&... fields) {
+            aui::parameter_pack::for_each([&](auto&& field) {
+                writer.key(field.name.view());
+                aui::write_json(writer, field.value);
+            }, fields...);
+        }, ((AJsonConvFieldDescriptor<T>&)value)().stdTuple());
+        writer.endObject();
+    }
+
+    static void read(AJsonReader& reader, T& dst) {
+        if (reader.event() != AJsonReader::Event::BEGIN_OBJECT) {
+            throw AJsonTypeMismatchException("not an object");
+        }
+        auto fields = ((AJsonConvFieldDescriptor<T>&)dst)().stdTuple();
+        const auto& index = aui::impl::json::fieldIndex<T>(fields);
+        std::bitset<std::tuple_size_v<decltype(fields)>> present;
+        while (reader.next() == AJsonReader::Event::KEY) {
+            auto i = index.find(reader.string());
+            if (i == aui::impl::json::FieldIndex::NOT_FOUND) {
+                reader.skip();
+                continue;
+            }
+            reader.next();
+            aui::impl::json::visitField(fields, i, [&](auto& field) {
+                aui::read_json(reader, field.value);
+            });
+            present.set(i);
+        }
+        checkPresent(fields, present);
+    }
+
+private:
+    template<typename Fields, typename Present>
+    static void checkPresent(const Fields& fields, const Present& present) {
+        std::apply([&](auto&&... fields) {
+            std::size_t i = 0;
+            aui::parameter_pack::for_each([&](auto&& field) {
+                if (!present[i++] && !(field.flags & AJsonFieldFlags::OPTIONAL)) {
+                    throw AJsonException(R"(field "{}" is not present)"_format(field.name));
+                }
+            }, fields...);
+        }, fields);
+    }
 };
 
 
@@ -228,6 +491,15 @@ struct AJsonConv<int> {
     static void fromJson(const AJson& json, int& dst) {
         dst = json.asInt();
     }
+    static void fromJson(AJsonCursor json, int& dst) {
+        dst = json.asInt();
+    }
+    static void write(AJsonWriter& writer, int v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, int& dst) {
+        dst = reader.asInt();
+    }
 };
 template<>
 struct AJsonConv<short> {
@@ -247,6 +519,15 @@ struct AJsonConv<float> {
     static void fromJson(const AJson& json, float& dst) {
         dst = json.asNumber();
     }
+    static void fromJson(AJsonCursor json, float& dst) {
+        dst = json.asNumber();
+    }
+    static void write(AJsonWriter& writer, float v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, float& dst) {
+        dst = reader.asNumber();
+    }
 };
 
 template<>
@@ -257,6 +538,15 @@ struct AJsonConv<double> {
     static void fromJson(const AJson& json, double& dst) {
         dst = json.asNumber();
     }
+    static void fromJson(AJsonCursor json, double& dst) {
+        dst = json.asNumber();
+    }
+    static void write(AJsonWriter& writer, double v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, double& dst) {
+        dst = reader.asNumber();
+    }
 };
 
 template<>
@@ -267,6 +557,15 @@ struct AJsonConv<bool> {
     static void fromJson(const AJson& json, bool& dst) {
         dst = json.asBool();
     }
+    static void fromJson(AJsonCursor json, bool& dst) {
+        dst = json.asBool();
+    }
+    static void write(AJsonWriter& writer, bool v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, bool& dst) {
+        dst = reader.asBool();
+    }
 };
 
 template<>
@@ -277,6 +576,15 @@ struct AJsonConv<AString> {
     static void fromJson(const AJson& json, AString& dst) {
         dst = json.asString();
     }
+    static void fromJson(AJsonCursor json, AString& dst) {
+        dst = json.asString();
+    }
+    static void write(AJsonWriter& writer, const AString& v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, AString& dst) {
+        dst = reader.asString();
+    }
 };
 template<>
 struct AJsonConv<APath> {
@@ -286,6 +594,15 @@ struct AJsonConv<APath> {
     static void fromJson(const AJson& json, APath& dst) {
         dst = json.asString();
     }
+    static void fromJson(AJsonCursor json, APath& dst) {
+        dst = json.asString();
+    }
+    static void write(AJsonWriter& writer, const APath& v) {
+        writer.value(v);
+    }
+    static void read(AJsonReader& reader, APath& dst) {
+        dst = reader.asString();
+    }
 };
 
 template<typename T1, typename T2>
@@ -297,6 +614,27 @@ struct AJsonConv<std::pair<T1, T2>> {
         const auto& array = json.asArray();
         dst = { aui::from_json<T1>(array.at(0)), aui::from_json<T2>(array.at(1)) };
     }
+    static void fromJson(AJsonCursor json, std::pair<T1, T2>& dst) {
+        dst = { aui::from_json<T1>(json[0]), aui::from_json<T2>(json[1]) };
+    }
+    static void write(AJsonWriter& writer, const std::pair<T1, T2>& v) {
+        writer.beginArray();
+        aui::write_json(writer, v.first);
+        aui::write_json(writer, v.second);
+        writer.endArray();
+    }
+    static void read(AJsonReader& reader, std::pair<T1, T2>& dst) {
+        if (reader.event() != AJsonReader::Event::BEGIN_ARRAY) {
+            throw AJsonTypeMismatchException("not an array");
+        }
+        reader.next();
+        aui::read_json(reader, dst.first);
+        reader.next();
+        aui::read_json(reader, dst.second);
+        if (reader.next() != AJsonReader::Event::END_ARRAY) {
+            throw AJsonException("pair should have exactly 2 elements");
+        }
+    }
 };
 
 template<>
@@ -336,6 +674,27 @@ struct AJsonConv<AVector<T>, typename std::enable_if_t<aui::has_json_converter<T
             dst << aui::from_json<T>(elem);
         }
     }
+    static void fromJson(AJsonCursor json, AVector<T>& dst) {
+        dst.reserve(json.size());
+        for (auto elem : json) {
+            dst << aui::from_json<T>(elem);
+        }
+    }
+    static void write(AJsonWriter& writer, const AVector<T>& v) {
+        writer.beginArray();
+        for (const auto& elem : v) {
+            aui::write_json(writer, elem);
+        }
+        writer.endArray();
+    }
+    static void read(AJsonReader& reader, AVector<T>& dst) {
+        if (reader.event() != AJsonReader::Event::BEGIN_ARRAY) {
+            throw AJsonTypeMismatchException("not an array");
+        }
+        while (reader.next() != AJsonReader::Event::END_ARRAY) {
+            aui::read_json(reader, dst.emplace_back());
+        }
+    }
 };
 
 
@@ -347,5 +706,14 @@ struct AJsonConv<T, typename std::enable_if_t<std::is_enum_v<T>>> {
     static void fromJson(const AJson& json, T& dst) {
         dst = AEnumerate<T>::byName(json.asString());
     }
+    static void fromJson(AJsonCursor json, T& dst) {
+        dst = AEnumerate<T>::byName(json.asString());
+    }
+    static void write(AJsonWriter& writer, const T& v) {
+        writer.value(AEnumerate<T>::names()[v]);
+    }
+    static void read(AJsonReader& reader, T& dst) {
+        dst = AEnumerate<T>::byName(reader.asString());
+    }
 };
 
@@ -0,0 +1,251 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Scalars.h"
+#include <AUI/Common/AUtf8.h>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace {
+    void appendUtf8(std::string& out, char32_t c) {
+        if (c < 0x80) {
+            out += char(c);
+        } else if (c < 0x800) {
+            out += char(0xc0 | (c >> 6));
+            out += char(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            out += char(0xe0 | (c >> 12));
+            out += char(0x80 | ((c >> 6) & 0x3f));
+            out += char(0x80 | (c & 0x3f));
+        } else {
+            out += char(0xf0 | (c >> 18));
+            out += char(0x80 | ((c >> 12) & 0x3f));
+            out += char(0x80 | ((c >> 6) & 0x3f));
+            out += char(0x80 | (c & 0x3f));
+        }
+    }
+
+    bool isDigit(char c) noexcept {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief Escape sequence of the character in a json string; 0 if the character is written as is.
+     */
+    constexpr std::array<char, 256> ESCAPES = [] {
+        std::array<char, 256> result{};
+        for (int c = 0; c < 0x20; ++c) result[c] = 'u';
+        result['"'] = '"';
+        result['\\'] = '\\';
+        result['\b'] = 'b';
+        result['\f'] = 'f';
+        result['\n'] = 'n';
+        result['\r'] = 'r';
+        result['\t'] = 't';
+        return result;
+    }();
+}
+
+bool aui::impl::json::parseNumber(std::string_view text, Number& out) noexcept {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* p = begin;
+
+    bool negative = p != end && *p == '-';
+    if (negative) ++p;
+    if (p == end || !isDigit(*p)) return false;
+
+    std::uint64_t mantissa = 0;
+    const char* digitsBegin = p;
+    if (*p == '0') {
+        ++p;
+    } else {
+        for (; p != end && isDigit(*p); ++p) {
+            mantissa = mantissa * 10 + std::uint64_t(*p - '0');
+        }
+    }
+    std::size_t digits = p - digitsBegin;
+    std::int64_t exponent = 0;
+    bool isInteger = true;
+
+    if (p != end && *p == '.') {
+        isInteger = false;
+        const char* fractionBegin = ++p;
+        for (; p != end && isDigit(*p); ++p) {
+            mantissa = mantissa * 10 + std::uint64_t(*p - '0');
+        }
+        if (p == fractionBegin) return false;
+        digits += p - fractionBegin;
+        exponent -= p - fractionBegin;
+    }
+    if (p != end && (*p | 0x20) == 'e') {
+        isInteger = false;
+        ++p;
+        bool negativeExponent = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+')) ++p;
+        if (p == end || !isDigit(*p)) return false;
+        std::int64_t value = 0;
+        for (; p != end && isDigit(*p); ++p) {
+            if (value < 100000) value = value * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end) return false;
+
+    if (isInteger) {
+        if (digits <= 18) {
+            auto value = std::int64_t(mantissa);
+            out = { true, negative ? -value : value, 0 };
+            return true;
+        }
+        std::int64_t value;
+        if (std::from_chars(begin, end, value).ec == std::errc{}) {
+            out = { true, value, 0 };
+            return true;
+        }
+        // does not fit into int64; fall back to double
+    }
+
+    // exact when both the mantissa and the power of 10 are representable in double (Clinger's fast path)
+    static constexpr double POWERS_OF_10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    if (digits <= 19 && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double value = double(mantissa);
+        value = exponent < 0 ? value / POWERS_OF_10[-exponent] : value * POWERS_OF_10[exponent];
+        out = { false, 0, negative ? -value : value };
+        return true;
+    }
+
+    double value;
+#if defined(__cpp_lib_to_chars)
+    auto ec = std::from_chars(begin, end, value).ec;
+    if (ec == std::errc::result_out_of_range) {
+        // the value is left untouched; the decimal exponent tells whether the number overflows or underflows
+        value = exponent + std::int64_t(digits) > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+        if (negative) value = -value;
+    } else if (ec != std::errc{}) {
+        return false;
+    }
+#else
+    value = std::strtod(std::string(begin, end).c_str(), nullptr);
+#endif
+    out = { false, 0, value };
+    return true;
+}
+
+std::size_t aui::impl::json::unescape(std::string_view raw, std::string& out) {
+    out.reserve(out.size() + raw.size());
+    auto readHex = [&](std::size_t position, char32_t& result) {
+        if (position + 4 > raw.size()) return false;
+        result = 0;
+        for (auto c : raw.substr(position, 4)) {
+            result <<= 4;
+            if (c >= '0' && c <= '9') result |= c - '0';
+            else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') result |= (c | 0x20) - 'a' + 10;
+            else return false;
+        }
+        return true;
+    };
+
+    for (std::size_t i = 0;;) {
+        auto backslash = raw.find('\\', i);
+        out.append(raw.substr(i, backslash - i));
+        if (backslash == std::string_view::npos) {
+            return std::string_view::npos;
+        }
+        if (backslash + 1 >= raw.size()) return backslash;
+        i = backslash + 2;
+        switch (raw[backslash + 1]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                char32_t c;
+                if (!readHex(i, c)) return backslash;
+                i += 4;
+                if (c >= 0xd800 && c < 0xdc00) {
+                    char32_t low;
+                    if (i + 6 <= raw.size() && raw[i] == '\\' && raw[i + 1] == 'u' && readHex(i + 2, low) &&
+                        low >= 0xdc00 && low < 0xe000) {
+                        c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+                        i += 6;
+                    } else {
+                        c = aui::utf8::REPLACEMENT_CHARACTER;
+                    }
+                } else if (c >= 0xdc00 && c < 0xe000) {
+                    c = aui::utf8::REPLACEMENT_CHARACTER;
+                }
+                appendUtf8(out, c);
+                break;
+            }
+            default:
+                return backslash;
+        }
+    }
+}
+
+void aui::impl::json::appendEscaped(std::string& out, std::string_view utf8) {
+    out.reserve(out.size() + utf8.size() + 2);
+    out += '"';
+    std::size_t runBegin = 0;
+    for (std::size_t i = 0; i < utf8.size(); ++i) {
+        char escape = ESCAPES[static_cast<unsigned char>(utf8[i])];
+        if (escape == 0) [[likely]] {
+            continue;
+        }
+        out.append(utf8.data() + runBegin, i - runBegin);
+        runBegin = i + 1;
+        out += '\\';
+        out += escape;
+        if (escape == 'u') {
+            static constexpr char HEX[] = "0123456789abcdef";
+            auto c = static_cast<unsigned char>(utf8[i]);
+            out += "00";
+            out += HEX[c >> 4];
+            out += HEX[c & 0xf];
+        }
+    }
+    out.append(utf8.data() + runBegin, utf8.size() - runBegin);
+    out += '"';
+}
+
+char* aui::impl::json::formatNumber(char* out, double value) noexcept {
+    if (!std::isfinite(value)) {
+        std::memcpy(out, "null", 4);
+        return out + 4;
+    }
+#if defined(__cpp_lib_to_chars)
+    return std::to_chars(out, out + MAX_NUMBER_LENGTH, value).ptr;
+#else
+    return out + std::snprintf(out, MAX_NUMBER_LENGTH, "%.17g", value);
+#endif
+}
+
+char* aui::impl::json::formatNumber(char* out, std::int64_t value) noexcept {
+    return std::to_chars(out, out + MAX_NUMBER_LENGTH, value).ptr;
+}
@@ -0,0 +1,68 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Decoding and encoding of json strings and numbers shared by the parsers and AJsonWriter.
+ */
+namespace aui::impl::json {
+    struct Number {
+        bool isInteger;
+        std::int64_t integer;
+        double floating;
+    };
+
+    /**
+     * @brief Parses the json number.
+     * @return false if the text is not a valid json number.
+     */
+    bool parseNumber(std::string_view text, Number& out) noexcept;
+
+    /**
+     * @brief Decodes escape sequences of the json string contents and appends the utf8 result to out.
+     * @return offset of the invalid escape sequence in raw or std::string_view::npos on success.
+     */
+    std::size_t unescape(std::string_view raw, std::string& out);
+
+    /**
+     * @brief Appends the utf8 string as a json string literal, including quotes.
+     */
+    void appendEscaped(std::string& out, std::string_view utf8);
+
+    /**
+     * @brief Maximum length of the number formatted by formatNumber.
+     */
+    constexpr std::size_t MAX_NUMBER_LENGTH = 32;
+
+    /**
+     * @brief Formats the double with the shortest representation which parses back to the same value.
+     * @param out buffer of at least MAX_NUMBER_LENGTH bytes
+     * @return end of the written characters. NaN and infinities are written as null.
+     */
+    char* formatNumber(char* out, double value) noexcept;
+
+    /**
+     * @brief Formats the integer.
+     * @param out buffer of at least MAX_NUMBER_LENGTH bytes
+     * @return end of the written characters.
+     */
+    char* formatNumber(char* out, std::int64_t value) noexcept;
+}
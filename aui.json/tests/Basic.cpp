@@ -112,6 +112,14 @@ TEST(Json, SerializationDeserialization)
     ASSERT_EQ(AJson::toString(AJson::fromString(str)), str);
 }
 
+TEST(Json, Utf8String)
+{
+    AUtf8String str = "{\"list\":[1,2],\"name\":\"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82\"}";
+    auto json = AJson::fromBuffer(str.bytes());
+    EXPECT_EQ(json["name"].asString(), AString(L"\u041f\u0440\u0438\u0432\u0435\u0442"));
+    EXPECT_EQ(AJson::toUtf8String(json), str);
+}
+
 
 TEST(Json, NegativeNumber)
 {
@@ -0,0 +1,81 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Json/AJson.h>
+#include <AUI/Json/AJsonDocument.h>
+
+TEST(JsonDocument, Access) {
+    std::string_view json = R"({"name": "Alex", "escaped": "a\"bé", "year": 2020, "big": 1499040000000,
+                               "ratio": 0.5, "flag": true, "nothing": null, "list": [1, "two", [3]]})";
+    auto document = AJsonDocument::parse(AByteBufferView(json));
+    const auto& root = document.root();
+    ASSERT_TRUE(root.isObject());
+    EXPECT_EQ(root.size(), 8);
+
+    // unescaped strings point to the input buffer
+    EXPECT_EQ(root["name"].asStringView().data(), json.data() + json.find("Alex"));
+    EXPECT_EQ(root["escaped"].asString(), AString(L"a\"bé"));
+    EXPECT_EQ(root["year"].asInt(), 2020);
+    EXPECT_FALSE(root["big"].isInt());
+    EXPECT_EQ(root["big"].asLongInt(), 1499040000000);
+    EXPECT_DOUBLE_EQ(root["ratio"].asNumber(), 0.5);
+    EXPECT_TRUE(root["flag"].asBool());
+    EXPECT_TRUE(root["nothing"].isNull());
+    EXPECT_EQ(root["list"][1].asString(), "two");
+    EXPECT_EQ(root["list"][2][0].asInt(), 3);
+    EXPECT_EQ(root.find("missing"), nullptr);
+    EXPECT_THROW((void)root["missing"], AJsonException);
+    EXPECT_THROW((void)root["list"][3], AJsonException);
+    EXPECT_THROW((void)root["name"].asInt(), AJsonTypeMismatchException);
+
+    AVector<std::string_view> keys;
+    for (const auto& member : root.asObject()) {
+        keys << member.key();
+    }
+    EXPECT_EQ(keys, (AVector<std::string_view>{ "name", "escaped", "year", "big", "ratio", "flag", "nothing", "list" }));
+}
+
+TEST(JsonDocument, HashIndex) {
+    AJson json = AJson::Object{};
+    for (int i = 0; i < 100; ++i) {
+        json["key" + AString::number(i)] = i;
+    }
+    auto utf8 = AJson::toUtf8String(json);
+    auto document = AJsonDocument::parse(utf8.bytes());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(document.root()["key" + std::to_string(i)].asInt(), i);
+    }
+    EXPECT_FALSE(document.root().contains("key100"));
+
+    // duplicate keys: the last one wins, like in AJson
+    std::string_view duplicates = R"({"a": 1, "a": 2})";
+    EXPECT_EQ(AJsonDocument::parse(AByteBufferView(duplicates)).root()["a"].asInt(), 2);
+}
+
+TEST(JsonDocument, ConversionToAndFromAJson) {
+    AJson json = {
+        {"array", AJson::Array{ "value1", 2, 3.5, true, nullptr }},
+        {"object", AJson{ {"nested", "Ж"} }},
+        {"long", int64_t(1) << 40},
+    };
+    auto document = AJsonDocument::fromJson(json);
+    EXPECT_EQ(document.root()["object"]["nested"].asString(), "Ж");
+    EXPECT_EQ(AJson::toString(document.toJson()), AJson::toString(json));
+
+    auto str = AJson::toUtf8String(json);
+    EXPECT_EQ(AJson::toString(AJsonDocument::parse(str.bytes()).toJson()), AJson::toString(json));
+}
@@ -89,3 +89,77 @@ TEST(Json, FieldsTestOptional)
     // here it should throw an exception since v1 is not optional
     EXPECT_THROW(aui::from_json<DataOptional>(AJson::fromString(R"({"v2":228})")), AJsonException);
 }
+
+namespace {
+    enum class Role {
+        USER, ADMIN
+    };
+
+    struct Account {
+        AString name;
+        int age = 0;
+        Role role = Role::USER;
+        AVector<AString> tags;
+        std::pair<int, double> position;
+        Data2 data;
+        bool active = false;
+    };
+}
+AUI_ENUM_VALUES(Role, Role::USER, Role::ADMIN)
+
+AJSON_FIELDS(Account,
+             (name, "name")
+             (age, "age")
+             (role, "role")
+             (tags, "tags")
+             (position, "position")
+             (data, "data")
+             (active, "active", AJsonFieldFlags::OPTIONAL))
+
+TEST(Json, FieldsTestDirect)
+{
+    Account account{ "Алекс \"2772\"", 23, Role::ADMIN, { "a", "b" }, { 1, 2.5 }, { { 1, 2 }, 3 }, true };
+    auto text = aui::to_json_string(account);
+    EXPECT_EQ(text.view(), std::string_view(R"({"name":"Алекс \"2772\"","age":23,"role":"ADMIN","tags":["a","b"],)"
+                                             R"("position":[1,2.5],"data":{"values":[1,2],"i":3},"active":true})"));
+
+    // unknown fields are skipped; fields may go in any order
+    auto parsed = aui::from_json_buffer<Account>(AByteBufferView(std::string_view(
+            R"({"unknown": {"a": [1, {"b": 2}]}, "active": false, "data": {"i": 3, "values": []}, "tags": ["x"],)"
+            R"( "age": 30, "role": "USER", "position": [4, 5], "name": "Vasil"})")));
+    EXPECT_EQ(parsed.name, "Vasil");
+    EXPECT_EQ(parsed.age, 30);
+    EXPECT_EQ(parsed.role, Role::USER);
+    EXPECT_EQ(parsed.tags, AVector<AString>{ "x" });
+    EXPECT_EQ(parsed.position, (std::pair<int, double>{ 4, 5.0 }));
+    EXPECT_EQ(parsed.data, (Data2{ {}, 3 }));
+    EXPECT_FALSE(parsed.active);
+
+    auto roundTrip = aui::from_json_buffer<Account>(text.bytes());
+    EXPECT_EQ(roundTrip.name, account.name);
+    EXPECT_EQ(aui::to_json_string(roundTrip).view(), text.view());
+
+    // same result as the AJson based conversion
+    EXPECT_EQ(AJson::toString(AJson::fromBuffer(text.bytes())), AJson::toString(aui::to_json(account)));
+
+    // optional field may be omitted, required may not
+    EXPECT_NO_THROW(aui::from_json_buffer<DataOptional>(AByteBufferView(std::string_view(R"({"v1": 1})"))));
+    EXPECT_THROW(aui::from_json_buffer<DataOptional>(AByteBufferView(std::string_view(R"({"v2": 1})"))), AJsonException);
+    EXPECT_THROW(aui::from_json_buffer<Data2>(AByteBufferView(std::string_view(R"([1])"))), AJsonTypeMismatchException);
+}
+
+TEST(Json, FieldIndex)
+{
+    AVector<std::string> names;
+    for (int i = 0; i < 100; ++i) {
+        names << "field" + std::to_string(i);
+    }
+    std::vector<std::string_view> views(names.begin(), names.end());
+    aui::impl::json::FieldIndex index(views);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(index.find(names[i]), i);
+    }
+    EXPECT_EQ(index.find("field100"), aui::impl::json::FieldIndex::NOT_FOUND);
+    EXPECT_EQ(index.find(""), aui::impl::json::FieldIndex::NOT_FOUND);
+    EXPECT_EQ(aui::impl::json::FieldIndex({}).find("a"), aui::impl::json::FieldIndex::NOT_FOUND);
+}
@@ -0,0 +1,142 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/IO/AByteBufferInputStream.h>
+#include <AUI/Json/AJson.h>
+#include <AUI/Json/AJsonReader.h>
+#include <AUI/Json/AJsonWriter.h>
+
+namespace {
+    using Event = AJsonReader::Event;
+
+    /**
+     * @brief Reads all events of the json with the given reader buffer size.
+     */
+    AVector<std::string> readEvents(std::string_view json, std::size_t bufferSize) {
+        AByteBufferInputStream stream{AByteBufferView(json)};
+        AJsonReader reader(stream, bufferSize);
+        AVector<std::string> result;
+        for (;;) {
+            switch (reader.next()) {
+                case Event::BEGIN_OBJECT: result << "{"; break;
+                case Event::END_OBJECT: result << "}"; break;
+                case Event::BEGIN_ARRAY: result << "["; break;
+                case Event::END_ARRAY: result << "]"; break;
+                case Event::KEY: result << "key " + std::string(reader.string()); break;
+                case Event::STRING: result << "string " + std::string(reader.string()); break;
+                case Event::NUMBER: result << "number " + std::to_string(reader.asNumber()); break;
+                case Event::BOOL: result << (reader.asBool() ? "true" : "false"); break;
+                case Event::NULL_VALUE: result << "null"; break;
+                case Event::END: return result;
+            }
+        }
+    }
+
+    std::string write(const std::function<void(AJsonWriter&)>& callback) {
+        AByteBuffer buffer;
+        {
+            AJsonWriter writer(buffer, 4);
+            callback(writer);
+        }
+        return { buffer.data(), buffer.size() };
+    }
+}
+
+TEST(JsonStreaming, ReaderEvents) {
+    std::string_view json = R"({"name": "Alex", "escaped": "a\"b\\cЖ", "list": [1, -2.5e1, true, false, null, []],
+                               "long string": "lorem ipsum dolor sit amet", "nested": {"empty": {}}})";
+    AVector<std::string> expected = {
+        "{",
+        "key name", "string Alex",
+        "key escaped", "string a\"b\\c\xd0\x96",
+        "key list", "[", "number 1.000000", "number -25.000000", "true", "false", "null", "[", "]", "]",
+        "key long string", "string lorem ipsum dolor sit amet",
+        "key nested", "{", "key empty", "{", "}", "}",
+        "}",
+    };
+    // small buffers make every token span the buffer boundary at every position
+    for (std::size_t bufferSize : { 1, 2, 3, 5, 7, 64 * 1024 }) {
+        EXPECT_EQ(readEvents(json, bufferSize), expected) << bufferSize;
+    }
+
+    // the token ends with the stream
+    EXPECT_EQ(readEvents("42 -1", 1), (AVector<std::string>{ "number 42.000000", "number -1.000000" }));
+}
+
+TEST(JsonStreaming, ReaderNewlineDelimited) {
+    std::string_view json = "{\"level\": \"info\", \"message\": \"started\", \"details\": {\"pid\": 1}}\n"
+                            "{\"details\": [1, [2]], \"message\": \"stopped\"}\n"
+                            "[1, {\"a\": \"b\"}]\n";
+    AByteBufferInputStream stream{AByteBufferView(json)};
+    AJsonReader reader(stream, 8);
+
+    AVector<AString> messages;
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(reader.next(), Event::BEGIN_OBJECT);
+        while (reader.next() == Event::KEY) {
+            if (reader.string() == "message") {
+                reader.next();
+                messages << reader.asString();
+            } else {
+                reader.skip();
+            }
+        }
+        EXPECT_EQ(reader.event(), Event::END_OBJECT);
+        EXPECT_EQ(reader.depth(), 0);
+    }
+    EXPECT_EQ(messages, (AVector<AString>{ "started", "stopped" }));
+
+    ASSERT_EQ(reader.next(), Event::BEGIN_ARRAY);
+    EXPECT_EQ(AJson::toString(reader.value()), R"([1,{"a":"b"}])");
+    EXPECT_EQ(reader.next(), Event::END);
+    EXPECT_EQ(reader.next(), Event::END);
+    EXPECT_EQ(reader.offset(), json.size());
+}
+
+TEST(JsonStreaming, ReaderErrors) {
+    for (const char* invalid : { "{", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "[1,]", "{1:2}", "\"abc", "[1]]",
+                                 "[tru]", "[nul]", "[\"a\\x\"]", "[01]", "[1.]", "[-]" }) {
+        EXPECT_THROW(readEvents(invalid, 3), AJsonParseException) << invalid;
+    }
+    EXPECT_TRUE(readEvents(" \n ", 3).empty());
+    EXPECT_THROW(AJson::fromStream(AByteBufferInputStream(AByteBufferView(std::string_view(" ")))), AJsonParseException);
+}
+
+TEST(JsonStreaming, Writer) {
+    auto json = write([](AJsonWriter& writer) {
+        writer.beginObject()
+              .key("name").value("Alex")
+              .key(AString("город")).value(AString("Москва"))
+              .key("escaped").value(std::string_view("q\"b\\n\n\x01", 7))
+              .key("numbers").beginArray().value(0).value(-1499040000000ll).value(0.1).value(1e300).value(-0.5)
+                                          .value(std::numeric_limits<double>::quiet_NaN()).value(2u).endArray()
+              .key("flags").beginArray().value(true).value(false).value(nullptr).endArray()
+              .key("empty").beginObject().endObject()
+              .endObject();
+        writer.value(AJson{ {"nested", AJson::Array{ 1, "two" }} });
+    });
+    EXPECT_EQ(json, "{\"name\":\"Alex\",\"город\":\"Москва\",\"escaped\":\"q\\\"b\\\\n\\n\\u0001\","
+                    "\"numbers\":[0,-1499040000000,0.1,1e+300,-0.5,null,2],\"flags\":[true,false,null],"
+                    "\"empty\":{}}\n{\"nested\":[1,\"two\"]}");
+    auto firstLine = std::string_view(json).substr(0, json.find('\n'));
+    EXPECT_EQ(AJson::fromBuffer(AByteBufferView(firstLine))["escaped"].asString(), AString("q\"b\\n\n\x01"));
+
+    EXPECT_THROW(write([](AJsonWriter& writer) { writer.beginObject().value(1); }), AJsonException);
+    EXPECT_THROW(write([](AJsonWriter& writer) { writer.beginArray().key("a"); }), AJsonException);
+    EXPECT_THROW(write([](AJsonWriter& writer) { writer.beginArray().endObject(); }), AJsonException);
+}
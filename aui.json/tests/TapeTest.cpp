@@ -0,0 +1,138 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Json/AJson.h>
+#include <AUI/Json/AJsonTape.h>
+#include <cmath>
+#include <limits>
+
+namespace {
+    struct TapeUser {
+        AString name;
+        int age;
+        AVector<AString> tags;
+        double rating = 0;
+    };
+}
+
+AJSON_FIELDS(TapeUser,
+    (name, "name")
+    (age, "age")
+    (tags, "tags")
+    (rating, "rating", AJsonFieldFlags::OPTIONAL)
+)
+
+TEST(JsonTape, Cursor) {
+    std::string_view json = R"({"users": [{"name": "Alex", "active": true}, {"name": "Vasil", "active": false}],
+                               "count": 2, "ratio": -1.5e2, "nothing": null})";
+    auto tape = AJsonTape::parse(AByteBufferView(json));
+    auto root = tape.root();
+    ASSERT_TRUE(root.isObject());
+    EXPECT_EQ(root.size(), 4);
+    EXPECT_EQ(root["count"].asInt(), 2);
+    EXPECT_DOUBLE_EQ(root["ratio"].asNumber(), -150.0);
+    EXPECT_TRUE(root["nothing"].isNull());
+    EXPECT_FALSE(root.contains("missing"));
+    EXPECT_THROW((void)root["missing"], AJsonException);
+    EXPECT_THROW((void)root["count"].asString(), AJsonTypeMismatchException);
+
+    AVector<AString> active;
+    for (auto user : root["users"]) {
+        if (user["active"].asBool()) {
+            active << user["name"].asString();
+        }
+    }
+    EXPECT_EQ(active, AVector<AString>{ "Alex" });
+    EXPECT_EQ(root["users"][1]["name"].rawString(), "Vasil");
+
+    AVector<AString> keys;
+    for (auto [key, value] : root.fields()) {
+        keys << key.asString();
+    }
+    EXPECT_EQ(keys, (AVector<AString>{ "users", "count", "ratio", "nothing" }));
+}
+
+TEST(JsonTape, Strings) {
+    auto json = AJson::fromString(R"(["a\"b", "c\\d", "\n\t\/", "Ж😀", "\ud83d", "é"])");
+    EXPECT_EQ(json[0].asString(), "a\"b");
+    EXPECT_EQ(json[1].asString(), "c\\d");
+    EXPECT_EQ(json[2].asString(), "\n\t/");
+    EXPECT_EQ(json[3].asString().toStdString(), "\xd0\x96\xf0\x9f\x98\x80");
+    EXPECT_EQ(json[4].asString().toStdString(), "\xef\xbf\xbd");
+    EXPECT_EQ(json[5].asString(), AString(L"é"));
+
+    // escaped quotes and backslashes across 64-byte block boundaries
+    for (std::size_t padding = 50; padding < 70; ++padding) {
+        std::string str = "[\"" + std::string(padding, 'x') + "\\\\\\\"\\\\\", 1]";
+        auto v = AJson::fromBuffer(AByteBufferView(str));
+        EXPECT_EQ(v[0].asString(), AString(std::string(padding, 'x') + "\\\"\\")) << padding;
+        EXPECT_EQ(v[1].asInt(), 1) << padding;
+    }
+}
+
+TEST(JsonTape, Numbers) {
+    auto json = AJson::fromString(R"([0, -0, 12, -2147483649, 9223372036854775807, 1.25, -0.5e-3, 1E3, 123456789012345678901234])");
+    EXPECT_EQ(json[0].asInt(), 0);
+    EXPECT_EQ(json[2].asInt(), 12);
+    EXPECT_EQ(json[3].asLongInt(), -2147483649ll);
+    EXPECT_EQ(json[4].asLongInt(), 9223372036854775807ll);
+    EXPECT_DOUBLE_EQ(json[5].asNumber(), 1.25);
+    EXPECT_DOUBLE_EQ(json[6].asNumber(), -0.0005);
+    EXPECT_DOUBLE_EQ(json[7].asNumber(), 1000.0);
+    EXPECT_DOUBLE_EQ(json[8].asNumber(), 1.2345678901234568e23);
+
+    // out of the double range
+    auto outOfRange = AJson::fromString(R"([1e400, -1.5e999, 1e-400, -0.001e-400, 123456789012345678901234e-360])");
+    EXPECT_EQ(outOfRange[0].asNumber(), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(outOfRange[1].asNumber(), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(outOfRange[2].asNumber(), 0.0);
+    EXPECT_EQ(outOfRange[3].asNumber(), 0.0);
+    EXPECT_TRUE(std::signbit(outOfRange[3].asNumber()));
+    EXPECT_EQ(outOfRange[4].asNumber(), 0.0);
+
+    for (const char* invalid : { "[01]", "[1.]", "[.5]", "[+1]", "[1e]", "[-]", "[1.5.5]" }) {
+        EXPECT_THROW(AJson::fromString(invalid), AJsonParseException) << invalid;
+    }
+}
+
+TEST(JsonTape, Errors) {
+    for (const char* invalid : { "", "   ", "{", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "[1,]", "{1:2}", "\"abc",
+                                 "[1]]", "{\"a\":1} x", "[tru]", "[nul]", "[\"a\\x\"]" }) {
+        EXPECT_THROW(AJson::fromString(invalid), AJsonParseException) << invalid;
+    }
+    EXPECT_NO_THROW(AJson::fromString(" \n[ ] "));
+}
+
+TEST(JsonTape, FromJsonCursor) {
+    std::string_view json = R"([{"tags": ["a", "b"], "age": 23, "name": "Alex", "ignored": {"deep": [1, 2, 3]}},
+                                {"name": "Vasil", "age": 30, "tags": [], "rating": 4.5}])";
+    auto tape = AJsonTape::parse(AByteBufferView(json));
+    auto users = aui::from_json<AVector<TapeUser>>(tape.root());
+    ASSERT_EQ(users.size(), 2);
+    EXPECT_EQ(users[0].name, "Alex");
+    EXPECT_EQ(users[0].age, 23);
+    EXPECT_EQ(users[0].tags, (AVector<AString>{ "a", "b" }));
+    EXPECT_EQ(users[1].name, "Vasil");
+    EXPECT_DOUBLE_EQ(users[1].rating, 4.5);
+
+    auto missing = AJsonTape::parse(AByteBufferView(std::string_view(R"({"name": "Alex"})")));
+    EXPECT_THROW(aui::from_json<TapeUser>(missing.root()), AJsonException);
+
+    // escaped keys are decoded before the lookup
+    auto escaped = AJsonTape::parse(AByteBufferView(std::string_view(R"({"n\u0061me": "Alex", "age": 1, "tags": []})")));
+    EXPECT_EQ(aui::from_json<TapeUser>(escaped.root()).name, "Alex");
+}
@@ -19,6 +19,121 @@
 #include "sqlite3.h"
 #include <AUI/Common/AException.h>
 #include <cassert>
+#include <list>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief LRU cache of prepared statements keyed by the SQL text.
+ * @details
+ * The same statements are executed over and over by the ORM; preparing (parsing and planning) is skipped for the
+ * cached ones. A statement is taken from the cache for the lifetime of its result; if the same query is executed while
+ * the previous result is still alive, a temporary statement is prepared.
+ */
+class SqliteStatementCache {
+public:
+    static constexpr std::size_t CAPACITY = 128;
+
+    explicit SqliteStatementCache(sqlite3* connection): mConnection(connection) {}
+
+    ~SqliteStatementCache() {
+        for (auto& entry : mEntries) {
+            sqlite3_finalize(entry.stmt);
+        }
+    }
+
+    /**
+     * @return prepared statement; should be returned with release().
+     */
+    sqlite3_stmt* acquire(const std::string& sql, bool& cached) {
+        if (auto it = mIndex.find(sql); it != mIndex.end()) {
+            auto entry = it->second;
+            if (!entry->inUse) {
+                // move to the most recently used position
+                mEntries.splice(mEntries.begin(), mEntries, entry);
+                entry->inUse = true;
+                cached = true;
+                return entry->stmt;
+            }
+            cached = false;
+            return prepare(sql, 0);
+        }
+
+        auto stmt = prepare(sql, SQLITE_PREPARE_PERSISTENT);
+        mEntries.push_front({ sql, stmt, true });
+        mIndex[mEntries.front().sql] = mEntries.begin();
+        cached = true;
+        evict();
+        return stmt;
+    }
+
+    void release(sqlite3_stmt* stmt, bool cached) noexcept {
+        if (!cached || !mConnection) {
+            sqlite3_finalize(stmt);
+            return;
+        }
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        for (auto& entry : mEntries) {
+            if (entry.stmt == stmt) {
+                entry.inUse = false;
+                break;
+            }
+        }
+        evict();
+    }
+
+    /**
+     * @brief Finalizes the idle statements. The statements in use are finalized on release.
+     */
+    void close() noexcept {
+        for (auto& entry : mEntries) {
+            if (!entry.inUse) {
+                sqlite3_finalize(entry.stmt);
+            }
+        }
+        mEntries.clear();
+        mIndex.clear();
+        mConnection = nullptr;
+    }
+
+private:
+    struct Entry {
+        std::string sql;
+        sqlite3_stmt* stmt;
+        bool inUse;
+    };
+
+    sqlite3* mConnection;
+
+    /**
+     * @brief Most recently used first. List nodes are not moved, so mIndex can refer to their sql strings.
+     */
+    std::list<Entry> mEntries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> mIndex;
+
+    sqlite3_stmt* prepare(const std::string& sql, unsigned flags) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v3(mConnection, sql.c_str(), int(sql.length()), flags, &stmt, nullptr) != SQLITE_OK ||
+            !stmt) {
+            sqlite3_finalize(stmt);
+            throw AException(AString("could not execute query: ") + sqlite3_errmsg(mConnection));
+        }
+        return stmt;
+    }
+
+    void evict() noexcept {
+        for (auto it = mEntries.end(); mEntries.size() > CAPACITY && it != mEntries.begin();) {
+            --it;
+            if (it->inUse) {
+                continue;
+            }
+            sqlite3_finalize(it->stmt);
+            mIndex.erase(it->sql);
+            it = mEntries.erase(it);
+        }
+    }
+};
 
 class SqliteRow: public ISqlDriverRow {
 private:
@@ -40,7 +155,7 @@ public:
                 return sqlite3_column_double(mStmt, index);
 
             case SQLITE_TEXT:
-                return AString((const char*)sqlite3_column_text(mStmt, index));
+                return getString(index);
 
             case SQLITE_NULL:
                 return nullptr;
@@ -48,24 +163,51 @@ public:
         assert(0);
         return AVariant();
     }
+
+    bool isNull(size_t index) override {
+        return sqlite3_column_type(mStmt, index) == SQLITE_NULL;
+    }
+
+    std::int64_t getInt64(size_t index) override {
+        return sqlite3_column_int64(mStmt, index);
+    }
+
+    double getDouble(size_t index) override {
+        return sqlite3_column_double(mStmt, index);
+    }
+
+    AString getString(size_t index) override {
+        auto text = reinterpret_cast<const char*>(sqlite3_column_text(mStmt, index));
+        // sqlite3_column_bytes should be called after sqlite3_column_text
+        return AString(std::string_view(text ? text : "", sqlite3_column_bytes(mStmt, index)));
+    }
+
+    AByteBuffer getBlob(size_t index) override {
+        auto blob = static_cast<const char*>(sqlite3_column_blob(mStmt, index));
+        return AByteBuffer(blob, blob ? sqlite3_column_bytes(mStmt, index) : 0);
+    }
 };
 
 class SqliteResult: public ISqlDriverResult {
     friend class SqliteDatabase;
 private:
-    sqlite3_stmt* mStmt;
+    _<SqliteStatementCache> mCache;
+    sqlite3_stmt* mStmt = nullptr;
+    bool mCached = false;
     AVector<SqlColumn> mColumns;
 
     /*
-     * Extends strings' life.
+     * Extends strings' life. Strings are bound with SQLITE_STATIC.
      */
     AVector<std::string> mTempStrings;
 
 public:
-    SqliteResult() {}
+    explicit SqliteResult(_<SqliteStatementCache> cache): mCache(std::move(cache)) {}
 
     ~SqliteResult() override {
-        sqlite3_finalize(mStmt);
+        if (mStmt) {
+            mCache->release(mStmt, mCached);
+        }
     }
 
     const AVector<SqlColumn>& getColumns() override {
@@ -110,16 +252,21 @@ public:
 class SqliteDatabase: public ISqlDatabase {
 private:
     sqlite3* mConnection;
+    _<SqliteStatementCache> mStatements;
+
 public:
     SqliteDatabase(const AString& path) {
         sqlite3_open(path.toStdString().c_str(), &mConnection);
         if (!mConnection) {
             throw AException("could not open database: " + path);
         }
+        mStatements = _new<SqliteStatementCache>(mConnection);
     }
 
     ~SqliteDatabase() override {
-        sqlite3_close(mConnection);
+        mStatements->close();
+        // the connection is closed when the results still alive release their statements
+        sqlite3_close_v2(mConnection);
     }
 
 	SqlDriverType getDriverType() override {
@@ -127,26 +274,21 @@ public:
     }
 
     _<ISqlDriverResult> query(const AString& query, const AVector<AVariant>& params) override {
-        sqlite3_stmt* stmt;
-
-        auto result = _new<SqliteResult>();
-
-        result->mTempStrings.reserve(params.size() + 1);
-        result->mTempStrings << query.toStdString();
-        sqlite3_prepare_v2(mConnection, result->mTempStrings.back().c_str(), result->mTempStrings.back().length(), &stmt,
-                           nullptr);
-        result->mStmt = stmt;
+        auto result = _new<SqliteResult>(mStatements);
+        auto stmt = result->mStmt = mStatements->acquire(query.toStdString(), result->mCached);
 
+        result->mTempStrings.reserve(params.size());
         for (unsigned i = 0; i < params.size(); ++i) {
             switch (params[i].getType()) {
                 case AVariantType::AV_NULL:
                     sqlite3_bind_null(stmt, i + 1);
                     break;
                 case AVariantType::AV_INT:
-                    sqlite3_bind_int(stmt, i + 1, params[i].toInt());
+                    sqlite3_bind_int64(stmt, i + 1, params[i].toInt());
                     break;
                 case AVariantType::AV_UINT:
-                    sqlite3_bind_int(stmt, i + 1, params[i].toInt());
+                    // unsigned values (i.e. ids) above INT_MAX do not fit into sqlite3_bind_int
+                    sqlite3_bind_int64(stmt, i + 1, params[i].toUInt());
                     break;
                 case AVariantType::AV_FLOAT:
                     sqlite3_bind_double(stmt, i + 1, params[i].toFloat());
@@ -157,16 +299,13 @@ public:
                 case AVariantType::AV_STRING:
                     result->mTempStrings << params[i].toString().toStdString();
                     sqlite3_bind_text(stmt, i + 1, result->mTempStrings.back().c_str(), result->mTempStrings.back().length(),
-                                      nullptr);
+                                      SQLITE_STATIC);
                     break;
                 case AVariantType::AV_BOOL:
                     sqlite3_bind_int(stmt, i + 1, params[i].toBool());
                     break;
             }
         }
-        if (!stmt) {
-            throw AException(AString("could not execute query: ") + sqlite3_errmsg(mConnection));
-        }
 
         return result;
     }
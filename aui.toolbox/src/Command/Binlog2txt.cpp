@@ -0,0 +1,66 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Binlog2txt.h"
+#include "AUI/IO/AFileInputStream.h"
+#include "AUI/IO/AFileOutputStream.h"
+#include "AUI/Logging/ABinaryLogger.h"
+#include "AUI/Common/AByteBuffer.h"
+
+AString Binlog2txt::getName() {
+    return "binlog2txt";
+}
+
+AString Binlog2txt::getSignature() {
+    return "<input file> [-o=<output file>]";
+}
+
+AString Binlog2txt::getDescription() {
+    return "converts a binary log written by ABinaryLogger to text.\n"
+           "\t-o output file (stdout if not set)\n"
+           ;
+}
+
+void Binlog2txt::run(Toolbox& t) {
+    if (t.args.empty()) {
+        throw IllegalArgumentsException("binlog2txt requires at least one argument");
+    }
+    APath file;
+    APath outputFile;
+    for (auto& f : t.args) {
+        if (f.length() >= 3 && f[0] == '-' && f[2] == '=') {
+            if (f[1] == 'o') {
+                outputFile = f.substr(3);
+            }
+            continue;
+        }
+        file = f;
+    }
+    if (file.empty()) {
+        throw IllegalArgumentsException("input file does not set");
+    }
+    AFileInputStream input(file);
+    if (outputFile.empty()) {
+        AByteBuffer text;
+        ABinaryLogger::decode(input, text);
+        std::cout.write(text.data(), text.size());
+        std::cout.flush();
+        return;
+    }
+    AFileOutputStream output(outputFile);
+    ABinaryLogger::decode(input, output);
+    std::cout << file << " -> " << outputFile << std::endl;
+}
@@ -1,4 +1,4 @@
-// AUI Framework - Declarative UI toolkit for modern C++20
+﻿// AUI Framework - Declarative UI toolkit for modern C++20
 // Copyright (C) 2020-2023 Alex2772
 //
 // This library is free software; you can redistribute it and/or
@@ -24,7 +24,7 @@
 #include <AUI/IO/AFileInputStream.h>
 #include <AUI/IO/AFileOutputStream.h>
 #include <AUI/Util/ATokenizer.h>
-#include <AUI/Util/LZ.h>
+#include <AUI/Util/ABuiltinFiles.h>
 
 void Pack::run(Toolbox& t) {
     if (t.args.size() != 3)
@@ -67,9 +67,6 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
     try
     {
 
-        AByteBuffer buffer;
-
-        buffer << aui::serialize_sized(assetPath.toStdString());
         auto fis = _new<AFileInputStream>(inputFile);
 
         AByteBuffer data;
@@ -77,6 +74,7 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
         data << fis;
 
         auto fileHash = AHash::sha512(data).toHexString();
+        const std::string format(ABuiltinFiles::MAGIC);
 
         // we will try cpp file on this path. if it exists there's chance we don't have to rewrite the same file
         // contents.
@@ -106,7 +104,14 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
             if (actualBeginning == desiredBeginning) {
                 // our client.
                 auto targetFileHash = AString(t.readStringUntilUnescaped('\n'));
-                if (targetFileHash == fileHash) {
+
+                // files packed in the older format have to be repacked
+                desiredBeginning = "// format: ";
+                actualBeginning = t.readString(desiredBeginning.length());
+                auto targetFormat = actualBeginning == desiredBeginning
+                        ? AString(t.readStringUntilUnescaped('\n'))
+                        : AString();
+                if (targetFileHash == fileHash && targetFormat == AString(format)) {
                     std::cout << "skipped " << assetPath << std::endl;
                     return;
                 }
@@ -115,10 +120,7 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
 
         }
 
-        buffer << aui::serialize_sized(data);
-
-        AByteBuffer packed;
-        LZ::compress(buffer, packed);
+        auto packed = ABuiltinFiles::pack({ { assetPath, data } });
 
         auto cppObjectName = outputCpp.filenameWithoutExtension();
 
@@ -126,29 +128,15 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
         out << "// This file is autogenerated by aui.toolbox. Please do not modify.\n"
                 "// file: " << assetPath << "\n"
                                                "// hash: " << fileHash << "\n"
+                "// format: " << format << "\n"
                                                                              "\n"
                                                                              "#include \"AUI/Common/AByteBuffer.h\"\n"
                                                                              "#include \"AUI/Util/ABuiltinFiles.h\"\n"
                                                                              "const static unsigned char AUI_PACKED_asset" << cppObjectName
              << "[] = ";
 
-#if AUI_PLATFORM_WIN
-        out << "{";
-        for (uint8_t c : packed) {
-            char buf[32];
-            sprintf(buf, "0x%02x,", c);
-            out << std::string(buf);
-        }
-        out << "};\n";
-#else
-        out << "\"";
-        for (uint8_t c : packed) {
-            char buf[32];
-            sprintf(buf, "\\x%02x", c);
-            out << std::string(buf);
-        }
-        out << "\";\n";
-#endif
+        writeByteArray(out, packed);
+        out << ";\n";
 
         out << "struct Assets" << cppObjectName << " {\n"
              << "    Assets" << cppObjectName << "(){\n"
@@ -168,3 +156,30 @@ void Pack::doPacking(const AString& inputFile, const AString& assetPath, const A
         std::cout << "Warning: could not pack file " << outputCpp << ": " << e.what() << std::endl;
     }
 }
+
+void Pack::writeByteArray(IOutputStream& out, AByteBufferView data) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string text;
+#if AUI_PLATFORM_WIN
+    // msvc limits the length of string literals
+    text.reserve(data.size() * 5 + 2);
+    text += '{';
+    for (uint8_t c : data) {
+        text += "0x";
+        text += HEX[c >> 4];
+        text += HEX[c & 0xf];
+        text += ',';
+    }
+    text += '}';
+#else
+    text.reserve(data.size() * 4 + 2);
+    text += '"';
+    for (uint8_t c : data) {
+        text += "\\x";
+        text += HEX[c >> 4];
+        text += HEX[c & 0xf];
+    }
+    text += '"';
+#endif
+    out.write(text.data(), text.size());
+}
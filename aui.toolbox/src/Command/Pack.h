@@ -17,6 +17,8 @@
 #pragma once
 
 #include <AUI/IO/APath.h>
+#include <AUI/IO/IOutputStream.h>
+#include <AUI/Common/AByteBufferView.h>
 #include "ICommand.h"
 
 class Pack: public ICommand {
@@ -29,4 +31,9 @@ public:
 
 
     static void doPacking(const AString& inputFile, const AString& assetPath, const APath& outputCpp);
+
+    /**
+     * @brief Writes the data as C array initializer.
+     */
+    static void writeByteArray(IOutputStream& out, AByteBufferView data);
 };
\ No newline at end of file
@@ -0,0 +1,301 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "PackDir.h"
+#include "Pack.h"
+#include <AUI/Crypt/AHash.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/Common/ASet.h>
+#include <AUI/IO/AFileInputStream.h>
+#include <AUI/IO/AFileOutputStream.h>
+#include <AUI/IO/AMappedFile.h>
+#include <AUI/Thread/AThreadPool.h>
+#include <AUI/Util/ABuiltinFiles.h>
+
+namespace {
+    constexpr auto MANIFEST_FILE = "manifest.txt";
+    constexpr auto OBJECTS_DIR = "objects";
+    constexpr auto PACKED_FILE = "assets.bin";
+    constexpr auto CPP_FILE = "assets.cpp";
+
+    struct Asset {
+        APath file;
+
+        /**
+         * @brief Asset path in the application, i.e. "img/logo.svg".
+         */
+        AString path;
+        std::size_t size;
+        std::time_t modifyTime;
+
+        /**
+         * @brief Hex SHA-512 of the contents; name of the object.
+         */
+        AString hash;
+    };
+
+    struct ManifestRecord {
+        std::size_t size;
+        std::time_t modifyTime;
+        AString hash;
+    };
+
+    void listAssets(const APath& dir, const AString& prefix, const PackDir::Options& options, AVector<Asset>& out) {
+        for (const auto& file : dir.listDir(AFileListFlags::DIRS | AFileListFlags::REGULAR_FILES)) {
+            auto path = prefix + file.filename();
+            if (options.exclude.contains(path)) {
+                continue;
+            }
+            if (file.isDirectoryExists()) {
+                listAssets(file, path + "/", options, out);
+            } else {
+                out << Asset{ file, path, file.fileSize(), file.fileModifyTime(), {} };
+            }
+        }
+    }
+
+    /**
+     * @brief Manifest is a text file; each line is "hash size modifyTime path".
+     */
+    AMap<AString, ManifestRecord> readManifest(const APath& file) {
+        AMap<AString, ManifestRecord> result;
+        if (!file.isRegularFileExists()) {
+            return result;
+        }
+        auto contents = AByteBuffer::fromStream(AFileInputStream(file));
+        std::string_view text(contents.data(), contents.size());
+        while (!text.empty()) {
+            auto line = text.substr(0, text.find('\n'));
+            text.remove_prefix(std::min(line.size() + 1, text.size()));
+
+            auto next = [&] {
+                auto field = line.substr(0, line.find(' '));
+                line.remove_prefix(std::min(field.size() + 1, line.size()));
+                return std::string(field);
+            };
+            auto hash = next();
+            auto size = next();
+            auto modifyTime = next();
+            if (line.empty()) {
+                // malformed line
+                continue;
+            }
+            result[AString(std::string(line))] = ManifestRecord{
+                std::size_t(std::stoull(size)),
+                std::time_t(std::stoll(modifyTime)),
+                AString(hash),
+            };
+        }
+        return result;
+    }
+
+    void writeManifest(const APath& file, const AVector<Asset>& assets) {
+        std::string text;
+        for (const auto& asset : assets) {
+            text += asset.hash.toStdString() + ' ' + std::to_string(asset.size) + ' ' +
+                    std::to_string(asset.modifyTime) + ' ' + asset.path.toStdString() + '\n';
+        }
+        AFileOutputStream(file).write(text.data(), text.size());
+    }
+
+    /**
+     * @brief Writes the file only if its contents differ, so the build system does not rebuild the dependents.
+     * @return true if the file was written.
+     */
+    bool writeIfChanged(const APath& file, AByteBufferView contents) {
+        if (file.isRegularFileExists() && file.fileSize() == contents.size()) {
+            if (contents.size() == 0) {
+                return false;
+            }
+            AMappedFile existing(file);
+            if (std::memcmp(existing.data(), contents.data(), contents.size()) == 0) {
+                return false;
+            }
+        }
+        AFileOutputStream(file).write(contents.data(), contents.size());
+        return true;
+    }
+
+    /**
+     * @brief Object file is the compressed flag byte followed by the data.
+     */
+    void writeObject(const APath& file, const ABuiltinFiles::CompressedEntry& entry) {
+        // write to a temporary file first, so an interrupted run does not leave a broken object
+        APath temporary = file + ".tmp";
+        {
+            AFileOutputStream os(temporary);
+            os << std::uint8_t(entry.compressed);
+            os.write(entry.data.data(), entry.data.size());
+        }
+        APath::move(temporary, file);
+    }
+
+    AString cppSource(const AString& packedHash, const APath& packedFile, bool incbin, AByteBufferView packed) {
+        AString result = "// This file is autogenerated by aui.toolbox. Please do not modify.\n"
+                         "// hash: " + packedHash + "\n"
+                         "\n"
+                         "#include \"AUI/Util/ABuiltinFiles.h\"\n"
+                         "\n";
+        if (incbin) {
+            auto label = "aui_packed_assets_" + packedHash.substr(0, 16);
+            auto path = packedFile.absolute().replacedAll("\\", "/");
+            result += "#if defined(__has_embed)\n"
+                      "static const unsigned char AUI_PACKED_assets[] = {\n"
+                      "#embed \"" + AString(PACKED_FILE) + "\"\n"
+                      "};\n"
+                      "#define AUI_PACKED_assets_begin AUI_PACKED_assets\n"
+                      "#define AUI_PACKED_assets_end (AUI_PACKED_assets + sizeof(AUI_PACKED_assets))\n"
+                      "#elif defined(__ELF__)\n"
+                      "__asm__(\".section .rodata\\n\"\n"
+                      "        \".balign 16\\n\"\n"
+                      "        \"" + label + ":\\n\"\n"
+                      "        \".incbin \\\"" + path + "\\\"\\n\"\n"
+                      "        \"" + label + "_end:\\n\"\n"
+                      "        \".previous\\n\");\n"
+                      "extern \"C\" __attribute__((visibility(\"hidden\"))) const unsigned char " + label + "[];\n"
+                      "extern \"C\" __attribute__((visibility(\"hidden\"))) const unsigned char " + label + "_end[];\n"
+                      "#define AUI_PACKED_assets_begin " + label + "\n"
+                      "#define AUI_PACKED_assets_end " + label + "_end\n"
+                      "#else\n"
+                      "#error \"the compiler supports neither #embed nor .incbin; pack the assets without --incbin\"\n"
+                      "#endif\n";
+        } else {
+            AByteBuffer array;
+            Pack::writeByteArray(array, packed);
+            result += "static const unsigned char AUI_PACKED_assets[] = ";
+            result += AString(std::string(array.data(), array.size()));
+            result += ";\n"
+                      "#define AUI_PACKED_assets_begin AUI_PACKED_assets\n"
+                      "#define AUI_PACKED_assets_end (AUI_PACKED_assets + sizeof(AUI_PACKED_assets))\n";
+        }
+        result += "\n"
+                  "namespace {\n"
+                  "    struct Assets {\n"
+                  "        Assets() {\n"
+                  "            ABuiltinFiles::load(AUI_PACKED_assets_begin, AUI_PACKED_assets_end - AUI_PACKED_assets_begin);\n"
+                  "        }\n"
+                  "    } assets;\n"
+                  "}\n";
+        return result;
+    }
+}
+
+void PackDir::run(Toolbox& t) {
+    if (t.args.size() < 2) {
+        throw IllegalArgumentsException("invalid argument count");
+    }
+    Options options;
+    for (std::size_t i = 2; i < t.args.size(); ++i) {
+        const auto& arg = t.args[i];
+        if (arg == "--incbin") {
+            options.incbin = true;
+        } else if (arg.startsWith("--exclude=")) {
+            options.exclude << arg.substr(10);
+        } else {
+            throw IllegalArgumentsException("unknown argument: " + arg);
+        }
+    }
+    doPacking(t.args[0], t.args[1], options);
+}
+
+AString PackDir::getName() {
+    return "pack_dir";
+}
+
+AString PackDir::getSignature() {
+    return "<base_dir> <output dir> [--incbin] [--exclude=<asset path>]...";
+}
+
+AString PackDir::getDescription() {
+    return "pack all files of the directory into <output dir>/assets.cpp";
+}
+
+void PackDir::doPacking(const APath& assetsDir, const APath& outputDir, const Options& options) {
+    auto objectsDir = outputDir.file(OBJECTS_DIR);
+    objectsDir.makeDirs();
+
+    AVector<Asset> assets;
+    listAssets(assetsDir, "", options, assets);
+    auto manifest = readManifest(outputDir.file(MANIFEST_FILE));
+
+    // hash the changed files and compress the new contents in parallel
+    AMutex sync;
+    ASet<AString> claimedObjects;
+    std::atomic_size_t packedCount = 0;
+    AFutureSet<> tasks;
+    for (auto& asset : assets) {
+        tasks << (AThreadPool::global() * [&] {
+            if (auto record = manifest.contains(asset.path)) {
+                if (record->second.size == asset.size && record->second.modifyTime == asset.modifyTime &&
+                    objectsDir.file(record->second.hash).isRegularFileExists()) {
+                    // unchanged file; do not read it
+                    asset.hash = record->second.hash;
+                    return;
+                }
+            }
+            AMappedFile contents(asset.file);
+            asset.hash = AHash::sha512(contents.view()).toHexString();
+            {
+                std::unique_lock lock(sync);
+                if (!claimedObjects.insert(asset.hash).second) {
+                    // identical file is handled by another task
+                    return;
+                }
+            }
+            auto object = objectsDir.file(asset.hash);
+            if (!object.isRegularFileExists()) {
+                contents.advise(AMappedFile::Access::SEQUENTIAL);
+                writeObject(object, ABuiltinFiles::compressEntry(contents.view()));
+                ++packedCount;
+            }
+        });
+    }
+    tasks.waitForAll();
+
+    // the objects are mapped, so building the packed data does not copy them
+    AMap<AString, AMappedFile> objects;
+    AVector<ABuiltinFiles::PackCompressedEntry> entries;
+    entries.reserve(assets.size());
+    for (const auto& asset : assets) {
+        auto object = objects.find(asset.hash);
+        if (object == objects.end()) {
+            object = objects.emplace(asset.hash, AMappedFile(objectsDir.file(asset.hash))).first;
+        }
+        auto view = object->second.view();
+        if (view.size() == 0) {
+            throw AException("broken object " + asset.hash + " of " + asset.path);
+        }
+        entries << ABuiltinFiles::PackCompressedEntry{ asset.path, view.slice(1, view.size() - 1), view.data()[0] != 0 };
+    }
+    auto packed = ABuiltinFiles::packCompressed(entries);
+
+    auto packedFile = outputDir.file(PACKED_FILE);
+    auto packedHash = AHash::sha512(packed).toHexString();
+    bool changed = writeIfChanged(packedFile, packed);
+    auto cpp = cppSource(packedHash, packedFile, options.incbin, packed).toStdString();
+    changed |= writeIfChanged(outputDir.file(CPP_FILE), AByteBufferView(cpp));
+
+    // remove the objects which are not referenced anymore
+    for (const auto& file : objectsDir.listDir(AFileListFlags::REGULAR_FILES)) {
+        if (!objects.contains(file.filename())) {
+            file.removeFile();
+        }
+    }
+    writeManifest(outputDir.file(MANIFEST_FILE), assets);
+
+    std::cout << assetsDir << ": " << assets.size() << " files, " << objects.size() << " unique, " << packedCount
+              << " compressed" << (changed ? "" : ", up to date") << std::endl;
+}
@@ -0,0 +1,47 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <AUI/IO/APath.h>
+#include "ICommand.h"
+
+/**
+ * @brief Packs a whole asset directory into a single cpp file.
+ * @details
+ * Files are hashed and compressed in parallel. Compressed contents are cached in the output directory by their
+ * SHA-512 (content-addressed), so identical files are compressed and stored once. The manifest remembers size,
+ * modification time and hash of every file, so unchanged files are not even read on the next run.
+ *
+ * The packed data is written to <code>assets.bin</code>. With <code>--incbin</code>, <code>assets.cpp</code> embeds
+ * it with <code>#embed</code> or the <code>.incbin</code> assembler directive, which compiles much faster than a C
+ * array of the same size. Outputs are rewritten only if their contents change.
+ */
+class PackDir: public ICommand {
+public:
+    AString getName() override;
+    AString getSignature() override;
+    AString getDescription() override;
+
+    void run(Toolbox& t) override;
+
+    struct Options {
+        bool incbin = false;
+        AStringVector exclude;
+    };
+
+    static void doPacking(const APath& assetsDir, const APath& outputDir, const Options& options);
+};
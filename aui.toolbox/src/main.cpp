@@ -19,10 +19,12 @@
 #include <Command/Lang.h>
 #include <Command/Css2ass.h>
 #include <Command/PackManual.h>
+#include <Command/PackDir.h>
 #include <Command/Svg2ico.h>
 
 #include "Toolbox.h"
 #include "Command/Svg2png.h"
+#include "Command/Binlog2txt.h"
 
 Toolbox toolbox;
 
@@ -36,8 +38,10 @@ Toolbox::Toolbox() {
     registerCommand<Lang>();
     registerCommand<Css2ass>();
     registerCommand<PackManual>();
+    registerCommand<PackDir>();
     registerCommand<Svg2png>();
     registerCommand<Svg2ico>();
+    registerCommand<Binlog2txt>();
 }
 Toolbox::~Toolbox() {
     for (auto& c : commands) {
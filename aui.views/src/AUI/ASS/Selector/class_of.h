@@ -35,14 +35,25 @@ namespace ass {
         struct ClassOf: IAssSubSelector {
         private:
             AStringVector mClasses;
-            
+
+            /**
+             * @brief Interned mClasses.
+             */
+            AVector<AStringAtom> mAtoms;
+
         public:
-            ClassOf(const AStringVector& classes) : mClasses(classes) {}
-            ClassOf(const AString& clazz) : mClasses({clazz}) {}
+            ClassOf(const AStringVector& classes) : mClasses(classes) {
+                mAtoms.reserve(classes.size());
+                for (const auto& c : classes) {
+                    mAtoms << AStringAtom(c);
+                }
+            }
+            ClassOf(const AString& clazz) : mClasses({clazz}), mAtoms({AStringAtom(clazz)}) {}
 
             bool isPossiblyApplicable(AView* view) override {
-                for (auto& v : mClasses) {
-                    if (view->getAssNames().contains(v)) {
+                const auto& names = view->getAssNames();
+                for (const auto& v : mAtoms) {
+                    if (names.contains(v)) {
                         return true;
                     }
                 }
@@ -40,10 +40,11 @@ void ACustomWindow::onPointerReleased(const APointerReleasedEvent& event) {
 
 
 bool ACustomWindow::isCaptionAt(const glm::ivec2& pos) {
+    static const AStringAtom overrideTitleDragging(".override-title-dragging");
     if (pos.y <= AUI_TITLE_HEIGHT) {
         if (auto v = getViewAtRecursive(pos)) {
             if (!(_cast<AButton>(v)) &&
-                !v->getAssNames().contains(".override-title-dragging")) {
+                !v->getAssNames().contains(overrideTitleDragging)) {
                 return true;
             }
         }
@@ -294,10 +294,11 @@ void ACustomWindow::handleXConfigureNotify() {
 
 
 bool ACustomWindow::isCaptionAt(const glm::ivec2& pos) {
+    static const AStringAtom overrideTitleDragging(".override-title-dragging");
     if (pos.y <= AUI_TITLE_HEIGHT) {
         if (auto v = getViewAtRecursive(pos)) {
             if (!(_cast<AButton>(v)) &&
-                !v->getAssNames().contains(".override-title-dragging")) {
+                !v->getAssNames().contains(overrideTitleDragging)) {
                 return true;
             }
         }
@@ -17,7 +17,6 @@
 
 #include "AMetric.h"
 
-#include "AUI/IO/AStringStream.h"
 #include "AUI/Util/ATokenizer.h"
 #include "AUI/Common/AMap.h"
 #include "AUI/Render/Render.h"
@@ -31,7 +30,7 @@ AMetric::AMetric(float value, Unit unit): mValue(value),
 
 AMetric::AMetric(const AString& text)
 {
-    ATokenizer p(_new<AStringStream>(text));
+    ATokenizer p(text);
     mValue = p.readFloat();
 
     auto unitName = p.readString();
@@ -193,7 +193,8 @@ void AView::invalidateAllStyles()
 
     for (auto target = this; target != nullptr; target = target->getParent()) {
         if (target->mExtraStylesheet) {
-            if (mAssNames.contains("CellStyle")) {
+            static const AStringAtom cellStyle("CellStyle");
+            if (mAssNames.contains(cellStyle)) {
                 printf("\n");
             }
 
@@ -286,18 +287,20 @@ void AView::pack()
     setSize({getMinimumWidth(parentLayoutDirection()), getMinimumHeight(parentLayoutDirection())});
 }
 
-void AView::addAssName(const AString& assName)
+void AView::addAssName(const AUtf8String& assName)
 {
-    mAssNames << assName;
+    mAssNames << AStringAtom(assName.view());
     assert(("empty ass name" && !assName.empty()));
     invalidateAssHelper();
 }
 
 void AView::invalidateAssHelper() { mAssHelper = nullptr; }
 
-void AView::removeAssName(const AString& assName)
+void AView::removeAssName(const AUtf8String& assName)
 {
-    mAssNames >> assName;
+    if (auto atom = AStringAtom::find(assName.view())) {
+        mAssNames >> *atom;
+    }
     assert(("empty ass name" && !assName.empty()));
     invalidateAssHelper();
 }
@@ -26,6 +26,8 @@
 #include <AUI/ASS/Property/ScrollbarAppearance.h>
 #include "AUI/Common/ABoxFields.h"
 #include "AUI/Common/ADeque.h"
+#include "AUI/Common/AStringAtom.h"
+#include "AUI/Common/AUtf8String.h"
 #include "AUI/Common/AObject.h"
 #include "AUI/Common/SharedPtr.h"
 #include "AUI/Platform/ACursor.h"
@@ -227,8 +229,10 @@ protected:
 
     /**
      * @brief ASS class names.
+     * @details
+     * Interned, so class_of selectors match by pointer comparison.
      */
-    ASet<AString> mAssNames;
+    ASet<AStringAtom> mAssNames;
 
     /**
      * @brief defines if the next view must be focused on tab button pressed
@@ -288,7 +292,7 @@ public:
     void popStencilIfNeeded();
 
     [[nodiscard]]
-    const ASet<AString>& getAssNames() const noexcept {
+    const ASet<AStringAtom>& getAssNames() const noexcept {
         return mAssNames;
     }
 
@@ -692,13 +696,13 @@ public:
      * @brief Adds an ASS class to this AView.
      * @param assName new ASS name
      */
-    void addAssName(const AString& assName);
+    void addAssName(const AUtf8String& assName);
 
     /**
      * @brief Removes an ASS class to this AView.
      * @param assName ASS name to remove
      */
-    void removeAssName(const AString& assName);
+    void removeAssName(const AUtf8String& assName);
 
     /**
      * @brief Wraps the addAssName function to make it easier to add ASS class names.
@@ -15,242 +15,85 @@
 // License along with this library. If not, see <http://www.gnu.org/licenses/>.
 
 #include "AXml.h"
+#include "AXmlReader.h"
+#include "AUI/Common/AByteBuffer.h"
+
+namespace {
+    bool isBlank(std::string_view text) {
+        return text.find_first_not_of(" \t\r\n") == std::string_view::npos;
+    }
+
+    AString toString(std::string_view utf8) {
+        return AString::fromUtf8(utf8.data(), utf8.size());
+    }
+
+    /**
+     * @brief Feeds the current element of the reader and its children to the visitor.
+     */
+    void visitElement(AXmlReader& reader, IXmlEntityVisitor& visitor) {
+        for (const auto& attribute : reader.attributes()) {
+            visitor.visitAttribute(toString(attribute.name), attribute.value());
+        }
+        while (reader.next() != AXmlReader::Event::END_ELEMENT) {
+            switch (reader.event()) {
+                case AXmlReader::Event::START_ELEMENT:
+                    if (auto child = visitor.visitEntity(toString(reader.name()))) {
+                        visitElement(reader, *child);
+                    } else {
+                        reader.skipElement();
+                    }
+                    break;
+
+                case AXmlReader::Event::TEXT:
+                    if (!isBlank(reader.rawText())) {
+                        visitor.visitTextEntity(reader.text());
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
 
-#include <functional>
-
-
-#include "AXmlParseError.h"
-#include "AUI/Util/ATokenizer.h"
+void AXml::read(AByteBufferView buffer, const _<IXmlDocumentVisitor>& visitor)
+{
+    AXmlReader reader(buffer);
+    while (reader.next() != AXmlReader::Event::END) {
+        switch (reader.event()) {
+            case AXmlReader::Event::PROCESSING_INSTRUCTION:
+                if (reader.name() == "xml") {
+                    if (auto headerVisitor = visitor->visitHeader()) {
+                        for (const auto& attribute : reader.attributes()) {
+                            headerVisitor->visitAttribute(toString(attribute.name), attribute.value());
+                        }
+                    }
+                }
+                break;
+
+            case AXmlReader::Event::START_ELEMENT:
+                if (auto child = visitor->visitEntity(toString(reader.name()))) {
+                    visitElement(reader, *child);
+                } else {
+                    reader.skipElement();
+                }
+                break;
+
+            case AXmlReader::Event::TEXT:
+                if (!isBlank(reader.rawText())) {
+                    visitor->visitTextEntity(reader.text());
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
 
 void AXml::read(const _<IInputStream>& is, const _<IXmlDocumentVisitor>& visitor)
 {
-	ATokenizer p(is);
-
-	char c;
-
-	auto throwUnexceptedCharacter = [&]()
-	{
-		throw AXmlParseError(
-			std::string("Unexpected character '") + p.getLastCharacter() + "' at " + std::to_string(p.getRow()) + ":" +
-			std::to_string(p.getRow()));
-	};
-	try
-	{
-		for (; (c = p.readChar());)
-		{
-			switch (c)
-			{
-			case '\r':
-			case '\n':
-			case '\t':
-			case ' ':
-				break;
-			case '<':
-				// ����� ��������
-				switch (p.readChar())
-				{
-				case '?':
-					{
-						// ���������
-						auto headerVisitor = visitor->visitHeader();
-
-						p.readString(); // ��������� "xml"
-
-						for (; (c = p.readChar()) != '>';)
-						{
-							switch (c)
-							{
-							case '?':
-								break;
-
-							case ' ':
-								break;
-
-							default:
-								{
-									p.reverseByte();
-									auto attrName = p.readString();
-									bool attrWithNoValue = false;
-									if (!attrName.empty())
-									{
-										for (; (c = p.readChar()) != '=';)
-										{
-											if (!isblank(c))
-											{
-												if (headerVisitor)
-													headerVisitor->visitAttribute(attrName, {});
-												attrWithNoValue = true;
-												break;
-											}
-										}
-									}
-									if (!attrWithNoValue)
-									{
-										AString value;
-										[&]()
-										{
-											for (; (c = p.readChar());)
-											{
-												switch (c)
-												{
-												case '\'':
-													value = p.readStringUntilUnescaped('\'');
-													return;
-
-												case '"':
-													value = p.readStringUntilUnescaped('"');
-													return;
-												case ' ':
-													break;
-
-												default:
-													throwUnexceptedCharacter();
-												}
-											}
-										}();
-
-										if (headerVisitor)
-											headerVisitor->visitAttribute(attrName, value);
-									}
-								}
-							}
-						}
-					}
-					break;
-				default:
-					// ���������� ��������
-					{
-						p.reverseByte();
-						auto entityName = p.readString();
-
-						std::function<void(_<IXmlEntityVisitor>)> handleEntity;
-						handleEntity = [&](_<IXmlEntityVisitor> entityVisitor)
-						{
-                            if (!entityVisitor) return;
-							bool endFlag = false;
-							for (; (c = p.readChar()) != '>';)
-							{
-								switch (c)
-								{
-								case '/':
-									endFlag = true;
-									break;
-
-								case '\r':
-								case '\n':
-								case ' ':
-									break;
-
-								default:
-									{
-										p.reverseByte();
-										auto attrName = p.readString({':'});
-										if (attrName.empty())
-										{
-											p.readChar();
-											continue;
-										}
-										bool attrWithNoValue = false;
-										for (; (c = p.readChar()) != '=';)
-										{
-											if (!isblank(c))
-											{
-												if (entityVisitor)
-													entityVisitor->visitAttribute(attrName, {});
-												attrWithNoValue = true;
-												break;
-											}
-										}
-										if (!attrWithNoValue)
-										{
-											AString value;
-											[&]()
-											{
-												for (;;)
-												{
-													switch (c = p.readChar())
-													{
-													case '\'':
-														value = p.readStringUntilUnescaped('\'');
-														return;
-
-													case '"':
-														value = p.readStringUntilUnescaped('"');
-														return;
-													case ' ':
-														break;
-
-													default:
-														throwUnexceptedCharacter();
-													}
-												}
-											}();
-
-											if (entityVisitor)
-												entityVisitor->visitAttribute(attrName, std::move(value));
-										}
-									}
-								}
-							}
-							if (!endFlag)
-							{
-								[&]()
-								{
-									for (;;)
-									{
-										c = p.readChar();
-										switch (c)
-										{
-										case ' ':
-											break;
-										case '\t':
-											break;
-										case '<':
-											c = p.readChar();
-											if (c == '/')
-											{
-												// ����� ���� ��������.
-												p.readString();
-
-												if (p.readChar() != '>')
-													throwUnexceptedCharacter();
-
-												return;
-											}
-											// ������ ����� ��������.
-											{
-												p.reverseByte();
-												auto entityName = p.readString();
-												handleEntity(entityVisitor->visitEntity(std::move(entityName)));
-											}
-
-										default:
-											{
-												auto str = p.readStringUntilUnescaped('<');
-												p.reverseByte();
-												if (entityVisitor)
-													entityVisitor->visitTextEntity(str);
-											}
-										}
-									}
-								}();
-							}
-						};
-						handleEntity(visitor->visitEntity(std::move(entityName)));
-					}
-				}
-
-				break;
-
-			default:
-				p.reverseByte();
-				visitor->visitTextEntity(p.readStringUntilUnescaped('<'));
-				if (p.isEof()) return;
-				p.reverseByte();
-			}
-		}
-	}
-	catch (const AEOFException&)
-	{
-	}
+    auto buffer = AByteBuffer::fromStream(is);
+    read(buffer, visitor);
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 #include "IXmlDocumentVisitor.h"
+#include "AUI/Common/AByteBufferView.h"
 #include "AUI/Common/SharedPtr.h"
 #include "AUI/IO/IInputStream.h"
 #include "AUI/Xml.h"
@@ -31,6 +32,16 @@ namespace AXml
     /**
      * @brief Parses xml from the input stream to the IXmlDocumentVisitor.
      * @ingroup xml
+     * @details
+     * The stream is read to the end and parsed with AXmlReader.
      */
 	void API_AUI_XML read(const _<IInputStream>& is, const _<IXmlDocumentVisitor>& visitor);
+
+    /**
+     * @brief Parses utf8 xml from the memory to the IXmlDocumentVisitor.
+     * @ingroup xml
+     * @details
+     * Use AXmlReader directly to avoid the AString allocations of the visitor interface.
+     */
+	void API_AUI_XML read(AByteBufferView buffer, const _<IXmlDocumentVisitor>& visitor);
 }
@@ -0,0 +1,351 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "AXmlReader.h"
+#include "AXmlParseError.h"
+#include <cstring>
+
+namespace {
+    constexpr std::size_t MAX_REFERENCE_LENGTH = 16;
+
+    bool isWhitespace(char c) noexcept {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool isNameTerminator(char c) noexcept {
+        switch (c) {
+            case ' ': case '\n': case '\r': case '\t':
+            case '/': case '>': case '=': case '?': case '<':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void appendUtf8(std::string& out, char32_t c) {
+        if (c < 0x80) {
+            out += char(c);
+        } else if (c < 0x800) {
+            out += char(0xc0 | (c >> 6));
+            out += char(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            out += char(0xe0 | (c >> 12));
+            out += char(0x80 | ((c >> 6) & 0x3f));
+            out += char(0x80 | (c & 0x3f));
+        } else {
+            out += char(0xf0 | (c >> 18));
+            out += char(0x80 | ((c >> 12) & 0x3f));
+            out += char(0x80 | ((c >> 6) & 0x3f));
+            out += char(0x80 | (c & 0x3f));
+        }
+    }
+
+    /**
+     * @brief Decodes the entity reference without & and ;.
+     * @return false if the reference is unknown.
+     */
+    bool decodeReference(std::string_view reference, std::string& out) {
+        if (reference == "lt") { out += '<'; return true; }
+        if (reference == "gt") { out += '>'; return true; }
+        if (reference == "amp") { out += '&'; return true; }
+        if (reference == "quot") { out += '"'; return true; }
+        if (reference == "apos") { out += '\''; return true; }
+        if (reference.size() < 2 || reference[0] != '#') {
+            return false;
+        }
+
+        bool hex = reference[1] == 'x';
+        auto digits = reference.substr(hex ? 2 : 1);
+        if (digits.empty()) {
+            return false;
+        }
+        char32_t c = 0;
+        for (char d : digits) {
+            unsigned value;
+            if (d >= '0' && d <= '9') value = d - '0';
+            else if (hex && (d | 0x20) >= 'a' && (d | 0x20) <= 'f') value = (d | 0x20) - 'a' + 10;
+            else return false;
+            c = c * (hex ? 16 : 10) + value;
+            if (c > 0x10ffff) return false;
+        }
+        if (c >= 0xd800 && c < 0xe000) {
+            return false;
+        }
+        appendUtf8(out, c);
+        return true;
+    }
+}
+
+void AXmlReader::fail(const std::string& message) const {
+    std::size_t row = 1;
+    std::size_t lineBegin = 0;
+    for (std::size_t i = 0; i < mPosition && i < mBuffer.size(); ++i) {
+        if (mBuffer.data()[i] == '\n') {
+            ++row;
+            lineBegin = i + 1;
+        }
+    }
+    throw AXmlParseError(message + " at " + std::to_string(row) + ":" + std::to_string(mPosition - lineBegin + 1));
+}
+
+void AXmlReader::unexpectedCharacter() const {
+    fail(std::string("unexpected character '") + mBuffer.data()[mPosition] + "'");
+}
+
+char AXmlReader::current() const {
+    if (mPosition >= mBuffer.size()) {
+        fail("unexpected end of xml document");
+    }
+    return mBuffer.data()[mPosition];
+}
+
+bool AXmlReader::startsWith(std::string_view prefix) const noexcept {
+    return std::string_view(mBuffer.data() + mPosition, mBuffer.size() - mPosition).starts_with(prefix);
+}
+
+void AXmlReader::skipWhitespace() noexcept {
+    while (mPosition < mBuffer.size() && isWhitespace(mBuffer.data()[mPosition])) {
+        ++mPosition;
+    }
+}
+
+std::string_view AXmlReader::readName() {
+    auto begin = mPosition;
+    while (mPosition < mBuffer.size() && !isNameTerminator(mBuffer.data()[mPosition])) {
+        ++mPosition;
+    }
+    if (mPosition == begin) {
+        current();
+        unexpectedCharacter();
+    }
+    return { mBuffer.data() + begin, mPosition - begin };
+}
+
+std::size_t AXmlReader::find(std::string_view what, const char* error) const {
+    auto position = std::string_view(mBuffer.data(), mBuffer.size()).find(what, mPosition);
+    if (position == std::string_view::npos) {
+        fail(error);
+    }
+    return position;
+}
+
+void AXmlReader::readAttributes(bool processingInstruction) {
+    mAttributes.clear();
+    for (;;) {
+        skipWhitespace();
+        switch (current()) {
+            case '>':
+                if (processingInstruction) {
+                    unexpectedCharacter();
+                }
+                ++mPosition;
+                return;
+
+            case '/':
+            case '?':
+                if ((current() == '?') != processingInstruction) {
+                    unexpectedCharacter();
+                }
+                ++mPosition;
+                if (current() != '>') {
+                    unexpectedCharacter();
+                }
+                ++mPosition;
+                mPendingEnd = !processingInstruction;
+                return;
+        }
+
+        Attribute attribute;
+        attribute.name = readName();
+        skipWhitespace();
+        if (current() == '=') {
+            ++mPosition;
+            skipWhitespace();
+            char quote = current();
+            if (quote != '"' && quote != '\'') {
+                unexpectedCharacter();
+            }
+            auto begin = mPosition + 1;
+            auto end = static_cast<const char*>(std::memchr(mBuffer.data() + begin, quote, mBuffer.size() - begin));
+            if (!end) {
+                fail("unterminated attribute value");
+            }
+            mPosition = end - mBuffer.data() + 1;
+            attribute.rawValue = { mBuffer.data() + begin, std::size_t(end - (mBuffer.data() + begin)) };
+        }
+        // else attribute without value, as in html
+        mAttributes.push_back(attribute);
+    }
+}
+
+AXmlReader::Event AXmlReader::next() {
+    if (mPendingEnd) {
+        mPendingEnd = false;
+        mAttributes.clear();
+        mStack.pop_back();
+        return mEvent = Event::END_ELEMENT;
+    }
+    const char* data = mBuffer.data();
+    for (;;) {
+        if (mPosition >= mBuffer.size()) {
+            if (!mStack.empty()) {
+                fail("unexpected end of xml document: <" + std::string(mStack.back()) + "> is not closed");
+            }
+            return mEvent = Event::END;
+        }
+
+        if (data[mPosition] != '<') {
+            auto begin = data + mPosition;
+            auto end = static_cast<const char*>(std::memchr(begin, '<', mBuffer.size() - mPosition));
+            if (!end) {
+                end = data + mBuffer.size();
+            }
+            mText = { begin, std::size_t(end - begin) };
+            mTextIsCData = false;
+            mPosition = end - data;
+            return mEvent = Event::TEXT;
+        }
+
+        if (startsWith("<!--")) {
+            mPosition = find("-->", "unterminated comment") + 3;
+            continue;
+        }
+        if (startsWith("<![CDATA[")) {
+            auto begin = mPosition + 9;
+            mPosition = begin;
+            auto end = find("]]>", "unterminated CDATA section");
+            mText = { data + begin, end - begin };
+            mTextIsCData = true;
+            mPosition = end + 3;
+            return mEvent = Event::TEXT;
+        }
+        if (startsWith("<!")) {
+            // DOCTYPE; the internal subset in brackets may contain '>'
+            for (int brackets = 0;; ++mPosition) {
+                char c = current();
+                if (c == '[') ++brackets;
+                else if (c == ']') --brackets;
+                else if (c == '>' && brackets <= 0) break;
+            }
+            ++mPosition;
+            continue;
+        }
+        if (startsWith("<?")) {
+            mPosition += 2;
+            mName = readName();
+            auto end = find("?>", "unterminated processing instruction");
+            mText = { data + mPosition, end - mPosition };
+            mTextIsCData = true;
+            if (mName == "xml") {
+                readAttributes(true);
+            } else {
+                // the content of other processing instructions is not necessarily made of attributes
+                mAttributes.clear();
+                mPosition = end + 2;
+            }
+            return mEvent = Event::PROCESSING_INSTRUCTION;
+        }
+        if (startsWith("</")) {
+            mPosition += 2;
+            mName = readName();
+            skipWhitespace();
+            if (current() != '>') {
+                unexpectedCharacter();
+            }
+            if (mStack.empty() || mStack.back() != mName) {
+                fail("unexpected closing tag </" + std::string(mName) + ">");
+            }
+            ++mPosition;
+            mStack.pop_back();
+            mAttributes.clear();
+            return mEvent = Event::END_ELEMENT;
+        }
+
+        ++mPosition;
+        mName = readName();
+        readAttributes(false);
+        mStack.push_back(mName);
+        return mEvent = Event::START_ELEMENT;
+    }
+}
+
+AOptional<std::string_view> AXmlReader::rawAttribute(std::string_view name) const noexcept {
+    for (const auto& attribute : mAttributes) {
+        if (attribute.name == name) {
+            return attribute.rawValue;
+        }
+    }
+    return std::nullopt;
+}
+
+AOptional<AString> AXmlReader::attribute(std::string_view name) const {
+    if (auto raw = rawAttribute(name)) {
+        return decode(*raw);
+    }
+    return std::nullopt;
+}
+
+AString AXmlReader::text() const {
+    std::string buffer;
+    auto utf8 = text(buffer);
+    return AString::fromUtf8(utf8.data(), utf8.size());
+}
+
+std::string_view AXmlReader::text(std::string& buffer) const {
+    if (mTextIsCData) {
+        return mText;
+    }
+    return decode(mText, buffer);
+}
+
+void AXmlReader::skipElement() {
+    if (mEvent != Event::START_ELEMENT) {
+        return;
+    }
+    for (auto target = depth() - 1; depth() > target;) {
+        next();
+    }
+}
+
+std::string_view AXmlReader::decode(std::string_view raw, std::string& buffer) {
+    auto ampersand = raw.find('&');
+    if (ampersand == std::string_view::npos) {
+        return raw;
+    }
+    buffer.clear();
+    buffer.reserve(raw.size());
+    for (std::size_t i = 0;;) {
+        buffer.append(raw.substr(i, ampersand - i));
+        if (ampersand == std::string_view::npos) {
+            return buffer;
+        }
+        i = ampersand + 1;
+        // references are short; don't look for the semicolon of the next reference after a stray &
+        if (auto semicolon = raw.substr(i, MAX_REFERENCE_LENGTH).find(';');
+            semicolon != std::string_view::npos && decodeReference(raw.substr(i, semicolon), buffer)) {
+            i += semicolon + 1;
+        } else {
+            buffer += '&';
+        }
+        ampersand = raw.find('&', i);
+    }
+}
+
+AString AXmlReader::decode(std::string_view raw) {
+    std::string buffer;
+    auto utf8 = decode(raw, buffer);
+    return AString::fromUtf8(utf8.data(), utf8.size());
+}
@@ -0,0 +1,215 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AUI/Common/AByteBufferView.h"
+#include "AUI/Common/AOptional.h"
+#include "AUI/Common/AString.h"
+#include "AUI/Xml.h"
+
+/**
+ * @brief Pull xml parser.
+ * @ingroup xml
+ * @details
+ * Reads xml from the memory event by event. Names, attribute values and texts are utf8 slices of the input buffer;
+ * entity references (&amp;amp;, &amp;#x20; etc) are decoded only when the value is requested with a decoding
+ * accessor. Nothing is allocated per element, except the element stack growth.
+ *
+ * Comments and DOCTYPE declarations are skipped; CDATA sections are reported as TEXT which is not decoded. The document
+ * may have several top level elements and top level text (i.e. an xml fragment).
+ *
+ * @code{cpp}
+ * AXmlReader reader(buffer);
+ * while (reader.next() != AXmlReader::Event::END) {
+ *     if (reader.event() == AXmlReader::Event::START_ELEMENT && reader.name() == "path") {
+ *         paths << reader.attribute("d").valueOr("");
+ *     }
+ * }
+ * @endcode
+ */
+class API_AUI_XML AXmlReader {
+public:
+    enum class Event {
+        /**
+         * @brief Start tag; name() and attributes() are available. Empty element tag is reported as START_ELEMENT
+         * followed by END_ELEMENT.
+         */
+        START_ELEMENT,
+
+        /**
+         * @brief End tag; name() is available.
+         */
+        END_ELEMENT,
+
+        /**
+         * @brief Character data or CDATA section; rawText() and text() are available.
+         */
+        TEXT,
+
+        /**
+         * @brief Processing instruction, i.e. <code>&lt;?xml version="1.0"?&gt;</code>; name() is the target,
+         * rawText() is the content. attributes() are the pseudo attributes of the xml declaration.
+         */
+        PROCESSING_INSTRUCTION,
+
+        /**
+         * @brief The document is over.
+         */
+        END,
+    };
+
+    struct Attribute {
+        std::string_view name;
+
+        /**
+         * @brief Value as it is written in the document, i.e. with entity references not decoded.
+         */
+        std::string_view rawValue;
+
+        [[nodiscard]]
+        AString value() const {
+            return AXmlReader::decode(rawValue);
+        }
+
+        /**
+         * @return utf8 value; points either to the document or to the buffer.
+         */
+        [[nodiscard]]
+        std::string_view value(std::string& buffer) const {
+            return AXmlReader::decode(rawValue, buffer);
+        }
+    };
+
+    /**
+     * @param buffer utf8 xml. The buffer must outlive the reader.
+     */
+    explicit AXmlReader(AByteBufferView buffer) noexcept: mBuffer(buffer) {}
+
+    /**
+     * @brief Reads the next event.
+     * @throws AXmlParseError if the document is malformed.
+     */
+    Event next();
+
+    [[nodiscard]]
+    Event event() const noexcept {
+        return mEvent;
+    }
+
+    /**
+     * @return name of the element or target of the processing instruction.
+     */
+    [[nodiscard]]
+    std::string_view name() const noexcept {
+        return mName;
+    }
+
+    /**
+     * @return attributes of the element or pseudo attributes of the processing instruction.
+     */
+    [[nodiscard]]
+    const std::vector<Attribute>& attributes() const noexcept {
+        return mAttributes;
+    }
+
+    [[nodiscard]]
+    AOptional<std::string_view> rawAttribute(std::string_view name) const noexcept;
+
+    [[nodiscard]]
+    AOptional<AString> attribute(std::string_view name) const;
+
+    /**
+     * @return true if the current element is written as an empty element tag, i.e. <code>&lt;br/&gt;</code>.
+     */
+    [[nodiscard]]
+    bool isEmptyElement() const noexcept {
+        return mPendingEnd;
+    }
+
+    /**
+     * @brief Text as it is written in the document, i.e. with entity references not decoded; contents of CDATA
+     * section; contents of processing instruction.
+     */
+    [[nodiscard]]
+    std::string_view rawText() const noexcept {
+        return mText;
+    }
+
+    [[nodiscard]]
+    AString text() const;
+
+    /**
+     * @return utf8 text; points either to the document or to the buffer.
+     */
+    [[nodiscard]]
+    std::string_view text(std::string& buffer) const;
+
+    /**
+     * @return number of open elements, including the current START_ELEMENT.
+     */
+    [[nodiscard]]
+    std::size_t depth() const noexcept {
+        return mStack.size();
+    }
+
+    /**
+     * @return byte offset of the parser in the document.
+     */
+    [[nodiscard]]
+    std::size_t offset() const noexcept {
+        return mPosition;
+    }
+
+    /**
+     * @brief Skips the children and the end of the current START_ELEMENT.
+     */
+    void skipElement();
+
+    /**
+     * @brief Decodes entity references. Unknown references are kept as is.
+     * @return utf8 text; points either to raw or to the buffer.
+     */
+    [[nodiscard]]
+    static std::string_view decode(std::string_view raw, std::string& buffer);
+
+    [[nodiscard]]
+    static AString decode(std::string_view raw);
+
+private:
+    AByteBufferView mBuffer;
+    std::size_t mPosition = 0;
+    Event mEvent = Event::END;
+    std::string_view mName;
+    std::string_view mText;
+    bool mTextIsCData = false;
+    bool mPendingEnd = false;
+    std::vector<Attribute> mAttributes;
+    std::vector<std::string_view> mStack;
+
+    [[noreturn]] void fail(const std::string& message) const;
+    [[noreturn]] void unexpectedCharacter() const;
+    char current() const;
+    bool startsWith(std::string_view prefix) const noexcept;
+    void skipWhitespace() noexcept;
+    std::string_view readName();
+    std::size_t find(std::string_view what, const char* error) const;
+    void readAttributes(bool processingInstruction);
+};
@@ -0,0 +1,184 @@
+// AUI Framework - Declarative UI toolkit for modern C++20
+// Copyright (C) 2020-2023 Alex2772
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <AUI/Common/AByteBuffer.h>
+#include <AUI/IO/AStringStream.h>
+#include <AUI/Util/Util.h>
+#include <AUI/Xml/AXml.h>
+#include <AUI/Xml/AXmlParseError.h>
+#include <AUI/Xml/AXmlReader.h>
+
+namespace {
+    using Event = AXmlReader::Event;
+
+    AVector<std::string> readEvents(std::string_view xml) {
+        AXmlReader reader{AByteBufferView(xml)};
+        AVector<std::string> result;
+        while (reader.next() != Event::END) {
+            switch (reader.event()) {
+                case Event::START_ELEMENT: {
+                    std::string element = "<" + std::string(reader.name());
+                    for (const auto& attribute : reader.attributes()) {
+                        element += " " + std::string(attribute.name) + "=" + attribute.value().toStdString();
+                    }
+                    result << element + (reader.isEmptyElement() ? "/>" : ">");
+                    break;
+                }
+                case Event::END_ELEMENT: result << "</" + std::string(reader.name()) + ">"; break;
+                case Event::TEXT: result << "text " + reader.text().toStdString(); break;
+                case Event::PROCESSING_INSTRUCTION: result << "<?" + std::string(reader.name()) + ">"; break;
+                case Event::END: break;
+            }
+        }
+        return result;
+    }
+}
+
+TEST(XmlReader, Events) {
+    std::string_view xml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!DOCTYPE svg [ <!ENTITY ns "http://www.w3.org/2000/svg"> ]>
+<!-- comment with <tags> -->
+<svg width='10' height="20" xmlns:xlink="x">
+    <path d="M 0 0 L 10 10" fill="a&amp;b &#x41;&#66;&unknown; &"/>text &lt;1&gt;<![CDATA[<raw &amp;>]]><g
+    ><empty></empty></g>
+</svg>)";
+    EXPECT_EQ(readEvents(xml), (AVector<std::string>{
+        "<?xml>",
+        "text \n", "text \n", "text \n",
+        "<svg width=10 height=20 xmlns:xlink=x>",
+        "text \n    ",
+        "<path d=M 0 0 L 10 10 fill=a&b AB&unknown; &/>", "</path>",
+        "text text <1>", "text <raw &amp;>",
+        "<g>", "<empty>", "</empty>", "</g>",
+        "text \n",
+        "</svg>",
+    }));
+}
+
+TEST(XmlReader, ZeroCopy) {
+    std::string_view xml = R"(<a key="value">text</a>)";
+    AXmlReader reader{AByteBufferView(xml)};
+    ASSERT_EQ(reader.next(), Event::START_ELEMENT);
+    EXPECT_EQ(reader.name().data(), xml.data() + 1);
+    EXPECT_EQ(reader.rawAttribute("key")->data(), xml.data() + xml.find("value"));
+    EXPECT_FALSE(reader.rawAttribute("missing"));
+    EXPECT_EQ(reader.depth(), 1);
+    ASSERT_EQ(reader.next(), Event::TEXT);
+    std::string buffer;
+    EXPECT_EQ(reader.text(buffer).data(), xml.data() + xml.find("text"));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(XmlReader, SkipElement) {
+    std::string_view xml = R"(<root><skipped a="1"><x/><y>text</y></skipped><kept/></root>)";
+    AXmlReader reader{AByteBufferView(xml)};
+    reader.next();
+    ASSERT_EQ(reader.next(), Event::START_ELEMENT);
+    reader.skipElement();
+    EXPECT_EQ(reader.event(), Event::END_ELEMENT);
+    EXPECT_EQ(reader.name(), "skipped");
+    ASSERT_EQ(reader.next(), Event::START_ELEMENT);
+    EXPECT_EQ(reader.name(), "kept");
+}
+
+TEST(XmlReader, Errors) {
+    for (const char* invalid : { "<a>", "<a></b>", "</a>", "<a b=c/>", "<a b=\"c/>", "<!-- a", "<a><![CDATA[</a>",
+                                 "<", "<a/" }) {
+        EXPECT_THROW(readEvents(invalid), AXmlParseError) << invalid;
+    }
+}
+
+TEST(XmlReader, VisitorAdapter) {
+    struct Element: IXmlEntityVisitor {
+        AString& log;
+        explicit Element(AString& log): log(log) {}
+
+        void visitAttribute(const AString& name, AString value) override {
+            log += " " + name + "=" + value;
+        }
+        _<IXmlEntityVisitor> visitEntity(AString entityName) override {
+            log += " <" + entityName + ">";
+            if (entityName == "ignored") {
+                return nullptr;
+            }
+            return _new<Element>(log);
+        }
+        void visitTextEntity(const AString& entity) override {
+            log += " text " + entity;
+        }
+    };
+    struct Header: IXmlHeaderVisitor {
+        AString& log;
+        explicit Header(AString& log): log(log) {}
+
+        void visitAttribute(const AString& name, const AString& value) override {
+            log += " header " + name + "=" + value;
+        }
+    };
+    struct Document: IXmlDocumentVisitor {
+        AString& log;
+        explicit Document(AString& log): log(log) {}
+
+        _<IXmlEntityVisitor> visitEntity(AString entityName) override {
+            log += " <" + entityName + ">";
+            return _new<Element>(log);
+        }
+        _<IXmlHeaderVisitor> visitHeader() override {
+            return _new<Header>(log);
+        }
+    };
+
+    AString log;
+    AStringStream stream(R"(<?xml version="1.0"?><html lang="ru"><b>жирный</b> &amp; <ignored><x/></ignored></html>)");
+    AXml::read(aui::ptr::fake(&stream), _new<Document>(log));
+    EXPECT_EQ(log, " header version=1.0 <html> lang=ru <b> text жирный text  &  <ignored>");
+}
+
+TEST(XmlPerformance, Reader) {
+    std::string xml = "<svg>";
+    for (int i = 0; xml.size() < 16 * 1024 * 1024; ++i) {
+        xml += R"(<path id="p)" + std::to_string(i) + R"(" d="M 0 0 L 10 10 C 20 20 30 30 40 40" fill="#ff0000" )"
+               R"(stroke="black"/><text x="1" y="2">label &amp; value )" + std::to_string(i) + "</text>";
+    }
+    xml += "</svg>";
+
+    std::size_t elements = 0;
+    auto readerTime = util::measureExecutionTime<std::chrono::microseconds>([&] {
+        AXmlReader reader{AByteBufferView(xml)};
+        while (reader.next() != Event::END) {
+            elements += reader.event() == Event::START_ELEMENT;
+        }
+    }).count();
+
+    struct Counter: IXmlDocumentVisitor {
+        std::size_t& elements;
+        explicit Counter(std::size_t& elements): elements(elements) {}
+        _<IXmlEntityVisitor> visitEntity(AString entityName) override {
+            ++elements;
+            return _new<Counter>(elements);
+        }
+    };
+    std::size_t visited = 0;
+    auto visitorTime = util::measureExecutionTime<std::chrono::microseconds>([&] {
+        AXml::read(AByteBufferView(xml), _new<Counter>(visited));
+    }).count();
+    EXPECT_EQ(elements, visited);
+
+    auto throughput = [&](long long us) { return double(xml.size()) / double(std::max(us, 1ll)); };
+    printf("XML: AXmlReader %.0f MB/s, IXmlDocumentVisitor %.0f MB/s\n", throughput(readerTime),
+           throughput(visitorTime));
+}
@@ -639,7 +639,9 @@ endmacro()
 
 function(aui_compile_assets AUI_MODULE_NAME)
     set(oneValueArgs DIR)
-    cmake_parse_arguments(ASSETS "" "${oneValueArgs}" "EXCLUDE" ${ARGN})
+    # BATCH packs all assets with a single aui.toolbox invocation into a single cpp. INCBIN (implies BATCH) embeds the
+    # packed data with #embed or .incbin instead of a C array, which compiles much faster.
+    cmake_parse_arguments(ASSETS "BATCH;INCBIN" "${oneValueArgs}" "EXCLUDE" ${ARGN})
     set_target_properties(${AUI_MODULE_NAME} PROPERTIES INTERFACE_AUI_WHOLEARCHIVE ON)
 
     if(CMAKE_CROSSCOMPILING)
@@ -681,6 +683,39 @@ function(aui_compile_assets AUI_MODULE_NAME)
     endif()
 
     message(STATUS "aui.toolbox: ${AUI_TOOLBOX_EXE}")
+    if (ASSETS_INCBIN)
+        set(ASSETS_BATCH ON)
+    endif()
+    if (ASSETS_BATCH)
+        set(_dir "${CMAKE_CURRENT_BINARY_DIR}/autogen/assets")
+        set(_args ${ASSETS_DIR} ${_dir})
+        if (ASSETS_INCBIN)
+            list(APPEND _args --incbin)
+        endif()
+        foreach(_path ${ASSETS_EXCLUDE})
+            list(APPEND _args --exclude=${_path})
+        endforeach()
+        set(_depends "")
+        foreach(ASSET_PATH ${ASSETS})
+            list(APPEND _depends ${SELF_DIR}/${ASSET_PATH})
+        endforeach()
+
+        # the list of the assets; rewritten only if changed, so removing an asset triggers the packing too
+        file(WRITE ${_dir}/files.txt.in "${ASSETS}")
+        configure_file(${_dir}/files.txt.in ${_dir}/files.txt COPYONLY)
+
+        add_custom_command(
+                OUTPUT ${_dir}/assets.cpp
+                BYPRODUCTS ${_dir}/assets.bin
+                COMMAND ${AUI_TOOLBOX_EXE} pack_dir ${_args}
+                DEPENDS ${_depends} ${_dir}/files.txt
+        )
+        target_sources(${AUI_MODULE_NAME} PRIVATE ${_dir}/assets.cpp)
+        if (ASSETS_INCBIN)
+            set_source_files_properties(${_dir}/assets.cpp PROPERTIES OBJECT_DEPENDS ${_dir}/assets.bin)
+        endif()
+        set(ASSETS "")
+    endif()
     foreach(ASSET_PATH ${ASSETS})
         string(MD5 OUTPUT_PATH ${ASSET_PATH})
         set(OUTPUT_PATH "${CMAKE_CURRENT_BINARY_DIR}/autogen/${OUTPUT_PATH}.cpp")